@@ -20,7 +20,7 @@ BaseCube::BaseCube(_In_ const XMFLOAT4& outputColor)
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 HRESULT BaseCube::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
 {
-    return initialize(pDevice, pImmediateContext);
+    return initializeShared(pDevice, pImmediateContext);
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
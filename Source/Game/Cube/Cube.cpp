@@ -25,7 +25,7 @@ HRESULT Cube::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* p
         SetMaterialOfMesh(0, 0);
     }
 
-    return initialize(pDevice, pImmediateContext);
+    return initializeShared(pDevice, pImmediateContext);
 }
 
 /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -0,0 +1,452 @@
+#include "Model/AnimationClip.h"
+
+#include "assimp/scene.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::AnimationClip
+
+      Summary:  Constructor. Copies the keys of every channel of the
+                animation into the tracks, times converted to float the
+                way they were compared when sampling the aiNodeAnim
+
+      Args:     const aiAnimation* pAnimation
+                  Pointer to an assimp animation object
+                BOOL bQuantizeRotations
+                  Store rotations as 16 bit snorm instead of float
+
+      Modifies: [m_aChannelNames, m_aChannels, m_aPositionTimes,
+                 m_aPositions, m_aRotationTimes, m_aRotations,
+                 m_aQuantizedRotations, m_aScalingTimes, m_aScalings,
+                 m_duration, m_ticksPerSecond].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationClip::AnimationClip(_In_ const aiAnimation* pAnimation, _In_ BOOL bQuantizeRotations)
+        : m_aChannelNames()
+        , m_aChannels()
+        , m_aPositionTimes()
+        , m_aPositions()
+        , m_aRotationTimes()
+        , m_aRotations()
+        , m_aQuantizedRotations()
+        , m_aScalingTimes()
+        , m_aScalings()
+        , m_duration(static_cast<FLOAT>(pAnimation->mDuration))
+        , m_ticksPerSecond(static_cast<FLOAT>(pAnimation->mTicksPerSecond != 0.0 ? pAnimation->mTicksPerSecond : 25.0f))
+    {
+        UINT uNumPositionKeys = 0u;
+        UINT uNumRotationKeys = 0u;
+        UINT uNumScalingKeys = 0u;
+        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        {
+            uNumPositionKeys += pAnimation->mChannels[i]->mNumPositionKeys;
+            uNumRotationKeys += pAnimation->mChannels[i]->mNumRotationKeys;
+            uNumScalingKeys += pAnimation->mChannels[i]->mNumScalingKeys;
+        }
+
+        m_aChannelNames.reserve(pAnimation->mNumChannels);
+        m_aChannels.reserve(pAnimation->mNumChannels);
+        m_aPositionTimes.reserve(uNumPositionKeys);
+        m_aPositions.reserve(uNumPositionKeys);
+        m_aRotationTimes.reserve(uNumRotationKeys);
+        if (bQuantizeRotations)
+        {
+            m_aQuantizedRotations.reserve(uNumRotationKeys);
+        }
+        else
+        {
+            m_aRotations.reserve(uNumRotationKeys);
+        }
+        m_aScalingTimes.reserve(uNumScalingKeys);
+        m_aScalings.reserve(uNumScalingKeys);
+
+        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        {
+            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
+
+            m_aChannelNames.emplace_back(pNodeAnim->mNodeName.data, pNodeAnim->mNodeName.length);
+            m_aChannels.push_back(
+                Channel
+                {
+                    .Position = KeyRange{ .uFirstKey = static_cast<UINT>(m_aPositionTimes.size()), .uNumKeys = pNodeAnim->mNumPositionKeys },
+                    .Rotation = KeyRange{ .uFirstKey = static_cast<UINT>(m_aRotationTimes.size()), .uNumKeys = pNodeAnim->mNumRotationKeys },
+                    .Scaling = KeyRange{ .uFirstKey = static_cast<UINT>(m_aScalingTimes.size()), .uNumKeys = pNodeAnim->mNumScalingKeys }
+                }
+            );
+
+            for (UINT j = 0u; j < pNodeAnim->mNumPositionKeys; ++j)
+            {
+                const aiVectorKey& key = pNodeAnim->mPositionKeys[j];
+                m_aPositionTimes.push_back(static_cast<FLOAT>(key.mTime));
+                m_aPositions.push_back(XMFLOAT3(key.mValue.x, key.mValue.y, key.mValue.z));
+            }
+
+            for (UINT j = 0u; j < pNodeAnim->mNumRotationKeys; ++j)
+            {
+                const aiQuatKey& key = pNodeAnim->mRotationKeys[j];
+                m_aRotationTimes.push_back(static_cast<FLOAT>(key.mTime));
+
+                XMFLOAT4 rotation(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w);
+                if (bQuantizeRotations)
+                {
+                    PackedVector::XMSHORTN4 quantizedRotation;
+                    PackedVector::XMStoreShortN4(&quantizedRotation, XMLoadFloat4(&rotation));
+                    m_aQuantizedRotations.push_back(quantizedRotation);
+                }
+                else
+                {
+                    m_aRotations.push_back(rotation);
+                }
+            }
+
+            for (UINT j = 0u; j < pNodeAnim->mNumScalingKeys; ++j)
+            {
+                const aiVectorKey& key = pNodeAnim->mScalingKeys[j];
+                m_aScalingTimes.push_back(static_cast<FLOAT>(key.mTime));
+                m_aScalings.push_back(XMFLOAT3(key.mValue.x, key.mValue.y, key.mValue.z));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::FindChannel
+
+      Summary:  Returns the channel animating a node. Matches the node
+                name the way Model::findNodeAnimOrNull did
+
+      Args:     PCSTR pszNodeName
+                  Name of the node
+
+      Returns:  UINT
+                  Index of the channel, INVALID_CHANNEL if the node is
+                  not animated
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AnimationClip::FindChannel(_In_ PCSTR pszNodeName) const
+    {
+        for (UINT i = 0u; i < m_aChannelNames.size(); ++i)
+        {
+            if (strncmp(m_aChannelNames[i].c_str(), pszNodeName, m_aChannelNames[i].length()) == 0)
+            {
+                return i;
+            }
+        }
+
+        return INVALID_CHANNEL;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::SampleChannel
+
+      Summary:  Interpolates the scaling, rotation and translation of a
+                channel at the given animation time
+
+      Args:     UINT uChannel
+                  Index of the channel
+                FLOAT animationTimeTicks
+                  Animation time
+                KeyCursor& cursor
+                  Keys found by the previous sample of the channel
+                XMFLOAT3& outScale
+                  Scaling vector
+                XMVECTOR& outQuaternion
+                  Quaternion vector
+                XMFLOAT3& outTranslate
+                  Translate vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::SampleChannel(_In_ UINT uChannel, _In_ FLOAT animationTimeTicks, _Inout_ KeyCursor& cursor, _Out_ XMFLOAT3& outScale, _Out_ XMVECTOR& outQuaternion, _Out_ XMFLOAT3& outTranslate) const
+    {
+        const Channel& channel = m_aChannels[uChannel];
+
+        interpolateScaling(outScale, animationTimeTicks, channel.Scaling, cursor.uScalingKey);
+        interpolateRotation(outQuaternion, animationTimeTicks, channel.Rotation, cursor.uRotationKey);
+        interpolatePosition(outTranslate, animationTimeTicks, channel.Position, cursor.uPositionKey);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetDuration
+
+      Summary:  Returns the duration in ticks
+
+      Returns:  FLOAT
+                  Duration in ticks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetDuration() const
+    {
+        return m_duration;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetTicksPerSecond
+
+      Summary:  Returns the number of ticks per second, 25 when the file
+                does not specify it
+
+      Returns:  FLOAT
+                  Ticks per second
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT AnimationClip::GetTicksPerSecond() const
+    {
+        return m_ticksPerSecond;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetSizeInBytes
+
+      Summary:  Returns the memory used by the channels and the tracks
+
+      Returns:  size_t
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t AnimationClip::GetSizeInBytes() const
+    {
+        size_t uSize = sizeof(*this);
+        for (const std::string& channelName : m_aChannelNames)
+        {
+            uSize += sizeof(channelName) + channelName.capacity();
+        }
+        uSize += m_aChannels.capacity() * sizeof(Channel);
+        uSize += m_aPositionTimes.capacity() * sizeof(FLOAT) + m_aPositions.capacity() * sizeof(XMFLOAT3);
+        uSize += m_aRotationTimes.capacity() * sizeof(FLOAT) + m_aRotations.capacity() * sizeof(XMFLOAT4) + m_aQuantizedRotations.capacity() * sizeof(PackedVector::XMSHORTN4);
+        uSize += m_aScalingTimes.capacity() * sizeof(FLOAT) + m_aScalings.capacity() * sizeof(XMFLOAT3);
+
+        return uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetImportedSizeInBytes
+
+      Summary:  Returns the memory used by the channels and keys of an
+                aiAnimation, to compare against GetSizeInBytes
+
+      Args:     const aiAnimation* pAnimation
+                  Pointer to an assimp animation object
+
+      Returns:  size_t
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t AnimationClip::GetImportedSizeInBytes(_In_ const aiAnimation* pAnimation)
+    {
+        size_t uSize = sizeof(aiAnimation);
+        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        {
+            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
+
+            uSize += sizeof(aiNodeAnim*) + sizeof(aiNodeAnim);
+            uSize += (pNodeAnim->mNumPositionKeys + pNodeAnim->mNumScalingKeys) * sizeof(aiVectorKey);
+            uSize += pNodeAnim->mNumRotationKeys * sizeof(aiQuatKey);
+        }
+
+        return uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::FindKey
+
+      Summary:  Find the first key whose next key is later than the
+                given animation time, or key 0 past the last key. During
+                monotonic playback the key is found a few steps from the
+                cursor of the previous lookup, seeks and loops fall back
+                to a binary search. Keys must be sorted by time
+
+      Args:     FLOAT animationTimeTicks
+                  Animation time
+                const FLOAT* pTimes
+                  Times of the keys of the track
+                UINT uNumKeys
+                  Number of keys of the track
+                UINT& uKeyCursor
+                  Key found by the previous lookup of the track
+
+      Returns:  UINT
+                  Index of the key in the track
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AnimationClip::FindKey(_In_ FLOAT animationTimeTicks, _In_reads_(uNumKeys) const FLOAT* pTimes, _In_ UINT uNumKeys, _Inout_ UINT& uKeyCursor)
+    {
+        constexpr const UINT MAX_CURSOR_STEPS = 4u;
+
+        if (uNumKeys < 2u)
+        {
+            return 0u;
+        }
+
+        UINT uLastKey = uNumKeys - 2u;
+        UINT uKey = uKeyCursor;
+        if (uKey <= uLastKey && (uKey == 0u || !(animationTimeTicks < pTimes[uKey])))
+        {
+            for (UINT uStep = 0u; uStep < MAX_CURSOR_STEPS && uKey <= uLastKey; ++uStep, ++uKey)
+            {
+                if (animationTimeTicks < pTimes[uKey + 1u])
+                {
+                    uKeyCursor = uKey;
+                    return uKey;
+                }
+            }
+        }
+
+        UINT uLow = 0u;
+        UINT uHigh = uLastKey + 1u;
+        while (uLow < uHigh)
+        {
+            UINT uMid = uLow + (uHigh - uLow) / 2u;
+            if (animationTimeTicks < pTimes[uMid + 1u])
+            {
+                uHigh = uMid;
+            }
+            else
+            {
+                uLow = uMid + 1u;
+            }
+        }
+
+        uKeyCursor = uLow <= uLastKey ? uLow : 0u;
+        return uKeyCursor;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::getRotation
+
+      Summary:  Returns a rotation key, dequantized if needed
+
+      Args:     UINT uKey
+                  Index of the key in the rotation track
+
+      Returns:  XMFLOAT4
+                  Quaternion of the key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMFLOAT4 AnimationClip::getRotation(_In_ UINT uKey) const
+    {
+        if (m_aQuantizedRotations.empty())
+        {
+            return m_aRotations[uKey];
+        }
+
+        XMFLOAT4 rotation;
+        XMStoreFloat4(&rotation, XMQuaternionNormalize(PackedVector::XMLoadShortN4(&m_aQuantizedRotations[uKey])));
+
+        return rotation;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::interpolatePosition
+
+      Summary:  Interpolate two keyframes to find translate vector
+
+      Args:     XMFLOAT3& outTranslate
+                  Translate vector
+                FLOAT animationTimeTicks
+                  Animation time
+                const KeyRange& keys
+                  Keys of the channel in the position track
+                UINT& uKeyCursor
+                  Key found by the previous lookup of the channel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::interpolatePosition(_Out_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const KeyRange& keys, _Inout_ UINT& uKeyCursor) const
+    {
+        assert(keys.uNumKeys > 0);
+
+        if (keys.uNumKeys == 1)
+        {
+            outTranslate = m_aPositions[keys.uFirstKey];
+            return;
+        }
+
+        const FLOAT* pTimes = &m_aPositionTimes[keys.uFirstKey];
+        UINT uPositionIndex = FindKey(animationTimeTicks, pTimes, keys.uNumKeys, uKeyCursor);
+        UINT uNextPositionIndex = uPositionIndex + 1u;
+        assert(uNextPositionIndex < keys.uNumKeys);
+
+        FLOAT t1 = pTimes[uPositionIndex];
+        FLOAT t2 = pTimes[uNextPositionIndex];
+        FLOAT deltaTime = t2 - t1;
+        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
+        assert(factor >= 0.0f && factor <= 1.0f);
+        const XMFLOAT3& start = m_aPositions[keys.uFirstKey + uPositionIndex];
+        const XMFLOAT3& end = m_aPositions[keys.uFirstKey + uNextPositionIndex];
+        outTranslate = XMFLOAT3(start.x + factor * (end.x - start.x), start.y + factor * (end.y - start.y), start.z + factor * (end.z - start.z));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::interpolateRotation
+
+      Summary:  Interpolate two keyframes to find rotation vector, with
+                the slerp of aiQuaternion
+
+      Args:     XMVECTOR& outQuaternion
+                  Quaternion vector
+                FLOAT animationTimeTicks
+                  Animation time
+                const KeyRange& keys
+                  Keys of the channel in the rotation track
+                UINT& uKeyCursor
+                  Key found by the previous lookup of the channel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::interpolateRotation(_Out_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const KeyRange& keys, _Inout_ UINT& uKeyCursor) const
+    {
+        assert(keys.uNumKeys > 0);
+
+        if (keys.uNumKeys == 1)
+        {
+            XMFLOAT4 rotation = getRotation(keys.uFirstKey);
+            outQuaternion = XMLoadFloat4(&rotation);
+            return;
+        }
+
+        const FLOAT* pTimes = &m_aRotationTimes[keys.uFirstKey];
+        UINT uRotationIndex = FindKey(animationTimeTicks, pTimes, keys.uNumKeys, uKeyCursor);
+        UINT uNextRotationIndex = uRotationIndex + 1u;
+        assert(uNextRotationIndex < keys.uNumKeys);
+
+        FLOAT t1 = pTimes[uRotationIndex];
+        FLOAT t2 = pTimes[uNextRotationIndex];
+        FLOAT deltaTime = t2 - t1;
+        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
+        assert(factor >= 0.0f && factor <= 1.0f);
+        XMFLOAT4 startRotation = getRotation(keys.uFirstKey + uRotationIndex);
+        XMFLOAT4 endRotation = getRotation(keys.uFirstKey + uNextRotationIndex);
+        const aiQuaternion start(startRotation.w, startRotation.x, startRotation.y, startRotation.z);
+        const aiQuaternion end(endRotation.w, endRotation.x, endRotation.y, endRotation.z);
+        aiQuaternion quaternion;
+        aiQuaternion::Interpolate(quaternion, start, end, factor);
+        XMFLOAT4 rotation(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
+        outQuaternion = XMLoadFloat4(&rotation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::interpolateScaling
+
+      Summary:  Interpolate two keyframes to find scaling vector
+
+      Args:     XMFLOAT3& outScale
+                  Scaling vector
+                FLOAT animationTimeTicks
+                  Animation time
+                const KeyRange& keys
+                  Keys of the channel in the scaling track
+                UINT& uKeyCursor
+                  Key found by the previous lookup of the channel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationClip::interpolateScaling(_Out_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const KeyRange& keys, _Inout_ UINT& uKeyCursor) const
+    {
+        assert(keys.uNumKeys > 0);
+
+        if (keys.uNumKeys == 1)
+        {
+            outScale = m_aScalings[keys.uFirstKey];
+            return;
+        }
+
+        const FLOAT* pTimes = &m_aScalingTimes[keys.uFirstKey];
+        UINT uScalingIndex = FindKey(animationTimeTicks, pTimes, keys.uNumKeys, uKeyCursor);
+        UINT uNextScalingIndex = uScalingIndex + 1u;
+        assert(uNextScalingIndex < keys.uNumKeys);
+
+        FLOAT t1 = pTimes[uScalingIndex];
+        FLOAT t2 = pTimes[uNextScalingIndex];
+        FLOAT deltaTime = t2 - t1;
+        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
+        assert(factor >= 0.0f && factor <= 1.0f);
+        const XMFLOAT3& start = m_aScalings[keys.uFirstKey + uScalingIndex];
+        const XMFLOAT3& end = m_aScalings[keys.uFirstKey + uNextScalingIndex];
+        outScale = XMFLOAT3(start.x + factor * (end.x - start.x), start.y + factor * (end.y - start.y), start.z + factor * (end.z - start.z));
+    }
+}
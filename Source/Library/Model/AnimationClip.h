@@ -0,0 +1,114 @@
+/*+===================================================================
+  File:      ANIMATIONCLIP.H
+
+  Summary:   AnimationClip header file contains declarations of the
+             engine side keyframe animation converted from Assimp used
+             for the lab samples of Game Graphics Programming course.
+
+  Classes: AnimationClip
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <DirectXPackedVector.h>
+
+struct aiAnimation;
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AnimationClip
+
+      Summary:  Keyframes of an aiAnimation converted at load, so the
+                aiScene can be freed. Every track is stored as a float
+                time array beside a value array, the keys of all
+                channels packed contiguously per track. Rotations can be
+                quantized to 4 x 16 bit snorm
+
+      Methods:  FindChannel
+                  Returns the channel animating a node
+                SampleChannel
+                  Interpolates the transform of a channel
+                GetDuration
+                  Returns the duration in ticks
+                GetTicksPerSecond
+                  Returns the number of ticks per second
+                GetSizeInBytes
+                  Returns the memory used by the keys
+                GetImportedSizeInBytes
+                  Returns the memory used by the Assimp keys
+                FindKey
+                  Returns the key of a track at an animation time
+                AnimationClip
+                  Constructor.
+                ~AnimationClip
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AnimationClip final
+    {
+    public:
+        static constexpr const UINT INVALID_CHANNEL = (0xFFFFFFFF);
+
+        struct KeyCursor
+        {
+            UINT uPositionKey;
+            UINT uRotationKey;
+            UINT uScalingKey;
+        };
+
+    public:
+        AnimationClip(_In_ const aiAnimation* pAnimation, _In_ BOOL bQuantizeRotations);
+        AnimationClip(const AnimationClip& other) = delete;
+        AnimationClip(AnimationClip&& other) = delete;
+        AnimationClip& operator=(const AnimationClip& other) = delete;
+        AnimationClip& operator=(AnimationClip&& other) = delete;
+        ~AnimationClip() = default;
+
+        UINT FindChannel(_In_ PCSTR pszNodeName) const;
+        void SampleChannel(_In_ UINT uChannel, _In_ FLOAT animationTimeTicks, _Inout_ KeyCursor& cursor, _Out_ XMFLOAT3& outScale, _Out_ XMVECTOR& outQuaternion, _Out_ XMFLOAT3& outTranslate) const;
+
+        FLOAT GetDuration() const;
+        FLOAT GetTicksPerSecond() const;
+
+        size_t GetSizeInBytes() const;
+        static size_t GetImportedSizeInBytes(_In_ const aiAnimation* pAnimation);
+        static UINT FindKey(_In_ FLOAT animationTimeTicks, _In_reads_(uNumKeys) const FLOAT* pTimes, _In_ UINT uNumKeys, _Inout_ UINT& uKeyCursor);
+
+    private:
+        struct KeyRange
+        {
+            UINT uFirstKey;
+            UINT uNumKeys;
+        };
+
+        struct Channel
+        {
+            KeyRange Position;
+            KeyRange Rotation;
+            KeyRange Scaling;
+        };
+
+        XMFLOAT4 getRotation(_In_ UINT uKey) const;
+        void interpolatePosition(_Out_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const KeyRange& keys, _Inout_ UINT& uKeyCursor) const;
+        void interpolateRotation(_Out_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const KeyRange& keys, _Inout_ UINT& uKeyCursor) const;
+        void interpolateScaling(_Out_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const KeyRange& keys, _Inout_ UINT& uKeyCursor) const;
+
+    private:
+        std::vector<std::string> m_aChannelNames;
+        std::vector<Channel> m_aChannels;
+
+        std::vector<FLOAT> m_aPositionTimes;
+        std::vector<XMFLOAT3> m_aPositions;
+        std::vector<FLOAT> m_aRotationTimes;
+        std::vector<XMFLOAT4> m_aRotations;
+        std::vector<PackedVector::XMSHORTN4> m_aQuantizedRotations;
+        std::vector<FLOAT> m_aScalingTimes;
+        std::vector<XMFLOAT3> m_aScalings;
+
+        FLOAT m_duration;
+        FLOAT m_ticksPerSecond;
+    };
+}
@@ -0,0 +1,166 @@
+#include "Model/AnimationLod.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLod::AnimationLod
+
+      Summary:  Constructor
+
+      Args:     const AnimationLodDesc& desc
+                  Animation level of detail settings
+
+      Modifies: [m_desc, m_stats, m_aCandidates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationLod::AnimationLod(_In_ const AnimationLodDesc& desc)
+        : m_desc(desc)
+        , m_stats()
+        , m_aCandidates()
+    {
+        assert(desc.uMaxUpdateInterval > 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLod::Schedule
+
+      Summary:  Collects the models whose skeleton is posed this frame.
+                The first due model is always taken so a single model
+                larger than the budget still animates
+
+      Args:     const XMVECTOR& eye
+                  World position of the camera
+                const std::vector<Model*>& aModels
+                  Every animated model of the scene
+                std::vector<AnimationLodPose>& aOutPoses
+                  Models to pose this frame with their update
+                  intervals
+
+      Modifies: [m_stats, m_aCandidates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationLod::Schedule(_In_ const XMVECTOR& eye, _In_ const std::vector<Model*>& aModels, _Out_ std::vector<AnimationLodPose>& aOutPoses)
+    {
+        aOutPoses.clear();
+        m_aCandidates.clear();
+
+        for (Model* pModel : aModels)
+        {
+            FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(pModel->GetWorldMatrix().r[3], eye)));
+            UINT uInterval = GetUpdateInterval(distance);
+            UINT uFramesSincePose = pModel->GetFramesSincePose();
+            if (uFramesSincePose >= uInterval)
+            {
+                m_aCandidates.push_back(
+                    Candidate
+                    {
+                        .overdue = static_cast<FLOAT>(uFramesSincePose) / static_cast<FLOAT>(uInterval),
+                        .distance = distance,
+                        .uUpdateInterval = uInterval,
+                        .pModel = pModel
+                    }
+                );
+            }
+        }
+
+        std::sort(m_aCandidates.begin(), m_aCandidates.end(),
+            [](const Candidate& a, const Candidate& b)
+            {
+                return a.overdue != b.overdue ? a.overdue > b.overdue : a.distance < b.distance;
+            }
+        );
+
+        UINT uNumBones = 0u;
+        for (const Candidate& candidate : m_aCandidates)
+        {
+            UINT uModelBones = candidate.pModel->GetNumSkeletonNodes();
+            if (!aOutPoses.empty() && uNumBones + uModelBones > m_desc.uBoneBudget)
+            {
+                break;
+            }
+
+            uNumBones += uModelBones;
+            aOutPoses.push_back(AnimationLodPose{ .pModel = candidate.pModel, .uUpdateInterval = candidate.uUpdateInterval });
+        }
+
+        m_stats =
+        {
+            .uNumModels = static_cast<UINT>(aModels.size()),
+            .uNumPosed = static_cast<UINT>(aOutPoses.size()),
+            .uNumDeferred = static_cast<UINT>(m_aCandidates.size() - aOutPoses.size()),
+            .uNumBonesPosed = uNumBones
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLod::GetUpdateInterval
+
+      Summary:  Returns the number of frames a model at the given
+                distance holds its pose
+
+      Args:     FLOAT distance
+                  Distance between the model and the eye
+
+      Returns:  UINT
+                  Update interval in frames, at least 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT AnimationLod::GetUpdateInterval(_In_ FLOAT distance) const
+    {
+        if (distance <= m_desc.nearDistance)
+        {
+            return 1u;
+        }
+
+        if (distance >= m_desc.farDistance)
+        {
+            return m_desc.uMaxUpdateInterval;
+        }
+
+        FLOAT t = (distance - m_desc.nearDistance) / (m_desc.farDistance - m_desc.nearDistance);
+        return 1u + static_cast<UINT>(t * static_cast<FLOAT>(m_desc.uMaxUpdateInterval - 1u));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLod::GetDesc
+
+      Summary:  Returns the settings
+
+      Returns:  const AnimationLodDesc&
+                  Animation level of detail settings
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const AnimationLodDesc& AnimationLod::GetDesc() const
+    {
+        return m_desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLod::SetDesc
+
+      Summary:  Changes the settings. A maximum interval of 1 with a
+                budget of UINT_MAX poses every model every frame
+
+      Args:     const AnimationLodDesc& desc
+                  Animation level of detail settings
+
+      Modifies: [m_desc].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void AnimationLod::SetDesc(_In_ const AnimationLodDesc& desc)
+    {
+        assert(desc.uMaxUpdateInterval > 0u);
+
+        m_desc = desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLod::GetStats
+
+      Summary:  Returns the counters of the last scheduled frame
+
+      Returns:  const AnimationLodStats&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const AnimationLodStats& AnimationLod::GetStats() const
+    {
+        return m_stats;
+    }
+}
@@ -0,0 +1,129 @@
+/*+===================================================================
+  File:      ANIMATIONLOD.H
+
+  Summary:   AnimationLod header file contains declarations of the
+             scheduler that lowers the skeleton update rate of distant
+             models, used for the lab samples of Game Graphics
+             Programming course.
+
+  Classes: AnimationLod
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/Model.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   AnimationLodDesc
+
+      Summary:  Animation level of detail settings. Models nearer than
+                nearDistance are posed every frame, the interval grows
+                linearly to uMaxUpdateInterval frames at farDistance.
+                The budget is in skeleton nodes posed per frame
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLodDesc
+    {
+        FLOAT nearDistance;
+        FLOAT farDistance;
+        UINT uMaxUpdateInterval;
+        UINT uBoneBudget;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   AnimationLodStats
+
+      Summary:  Counters of the last scheduled frame. Deferred models
+                were due but did not fit in the bone budget
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLodStats
+    {
+        UINT uNumModels;
+        UINT uNumPosed;
+        UINT uNumDeferred;
+        UINT uNumBonesPosed;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   AnimationLodPose
+
+      Summary:  A model to pose this frame and the number of frames
+                until it is due again, which Model::PoseSkeleton
+                interpolates
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLodPose
+    {
+        Model* pModel;
+        UINT uUpdateInterval;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AnimationLod
+
+      Summary:  Picks the models whose skeleton is posed this frame.
+                A model is due once it was posed for its distance's
+                update interval ago. Due models are taken most overdue
+                first until the bone budget is spent, the rest keep
+                their pose and stay due for the next frame
+
+      Methods:  Schedule
+                  Collects the models to pose this frame
+                GetUpdateInterval
+                  Returns the update interval of a distance
+                GetDesc
+                  Returns the settings
+                SetDesc
+                  Changes the settings
+                GetStats
+                  Returns the counters of the last frame
+                AnimationLod
+                  Constructor.
+                ~AnimationLod
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AnimationLod final
+    {
+    public:
+        static constexpr const AnimationLodDesc DEFAULT_DESC =
+        {
+            .nearDistance = 20.0f,
+            .farDistance = 200.0f,
+            .uMaxUpdateInterval = 8u,
+            .uBoneBudget = 4096u
+        };
+
+    public:
+        AnimationLod(_In_ const AnimationLodDesc& desc);
+        AnimationLod(const AnimationLod& other) = delete;
+        AnimationLod(AnimationLod&& other) = delete;
+        AnimationLod& operator=(const AnimationLod& other) = delete;
+        AnimationLod& operator=(AnimationLod&& other) = delete;
+        ~AnimationLod() = default;
+
+        void Schedule(_In_ const XMVECTOR& eye, _In_ const std::vector<Model*>& aModels, _Out_ std::vector<AnimationLodPose>& aOutPoses);
+        UINT GetUpdateInterval(_In_ FLOAT distance) const;
+
+        const AnimationLodDesc& GetDesc() const;
+        void SetDesc(_In_ const AnimationLodDesc& desc);
+
+        const AnimationLodStats& GetStats() const;
+
+    private:
+        struct Candidate
+        {
+            FLOAT overdue;
+            FLOAT distance;
+            UINT uUpdateInterval;
+            Model* pModel;
+        };
+
+    private:
+        AnimationLodDesc m_desc;
+        AnimationLodStats m_stats;
+        std::vector<Candidate> m_aCandidates;
+    };
+}
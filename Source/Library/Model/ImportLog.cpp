@@ -0,0 +1,112 @@
+#include "Model/ImportLog.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace library
+{
+#ifdef _DEBUG
+    std::atomic<eImportLogLevel> ImportLog::sm_level = eImportLogLevel::INFO;
+#else
+    std::atomic<eImportLogLevel> ImportLog::sm_level = eImportLogLevel::WARNING;
+#endif
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ImportLog::GetLevel
+
+      Summary:  Returns the current level
+
+      Returns:  eImportLogLevel
+                  Most verbose level written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eImportLogLevel ImportLog::GetLevel()
+    {
+        return sm_level.load(std::memory_order_relaxed);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ImportLog::SetLevel
+
+      Summary:  Changes the current level
+
+      Args:     eImportLogLevel level
+                  Most verbose level to write
+
+      Modifies: [sm_level].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ImportLog::SetLevel(_In_ eImportLogLevel level)
+    {
+        sm_level.store(level, std::memory_order_relaxed);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ImportLog::IsEnabled
+
+      Summary:  Returns whether messages of a level are written. Callers
+                gather the arguments of costly messages only when TRUE
+
+      Args:     eImportLogLevel level
+                  Level of the message
+
+      Returns:  BOOL
+                  TRUE if the level is written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ImportLog::IsEnabled(_In_ eImportLogLevel level)
+    {
+        return level != eImportLogLevel::NONE && level <= GetLevel();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ImportLog::Write
+
+      Summary:  Formats and writes a message of a level, longer
+                messages are truncated
+
+      Args:     eImportLogLevel level
+                  Level of the message
+                PCSTR pszFormat
+                  printf format of the message
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ImportLog::Write(_In_ eImportLogLevel level, _In_z_ _Printf_format_string_ PCSTR pszFormat, ...)
+    {
+        if (!IsEnabled(level))
+        {
+            return;
+        }
+
+        CHAR szMessage[512];
+        va_list args;
+        va_start(args, pszFormat);
+        _vsnprintf_s(szMessage, _TRUNCATE, pszFormat, args);
+        va_end(args);
+
+        OutputDebugStringA(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ImportLog::Write
+
+      Summary:  Formats and writes a wide message of a level, longer
+                messages are truncated
+
+      Args:     eImportLogLevel level
+                  Level of the message
+                PCWSTR pszFormat
+                  printf format of the message
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ImportLog::Write(_In_ eImportLogLevel level, _In_z_ _Printf_format_string_ PCWSTR pszFormat, ...)
+    {
+        if (!IsEnabled(level))
+        {
+            return;
+        }
+
+        WCHAR szMessage[512];
+        va_list args;
+        va_start(args, pszFormat);
+        _vsnwprintf_s(szMessage, _TRUNCATE, pszFormat, args);
+        va_end(args);
+
+        OutputDebugString(szMessage);
+    }
+}
@@ -0,0 +1,72 @@
+/*+===================================================================
+  File:      IMPORTLOG.H
+
+  Summary:   ImportLog header file contains declarations of the leveled
+             diagnostics channel of model import used for the lab
+             samples of Game Graphics Programming course.
+
+  Classes: ImportLog
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eImportLogLevel
+
+        Summary:  Verbosity of import diagnostics. A message is written
+                  when its level is at most the current level
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eImportLogLevel
+    {
+        NONE,
+        WARNING,
+        INFO,
+        VERBOSE,
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ImportLog
+
+      Summary:  Writes import diagnostics to the debugger output. The
+                level check comes before any formatting, so disabled
+                messages cost one atomic load. Messages are formatted
+                on the stack, so importers may log from any thread.
+                Debug builds default to INFO, release builds to WARNING
+
+      Methods:  GetLevel
+                  Returns the current level
+                SetLevel
+                  Changes the current level
+                IsEnabled
+                  Returns whether a level is written
+                Write
+                  Formats and writes a message of a level
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ImportLog final
+    {
+    public:
+        ImportLog() = delete;
+        ImportLog(const ImportLog& other) = delete;
+        ImportLog(ImportLog&& other) = delete;
+        ImportLog& operator=(const ImportLog& other) = delete;
+        ImportLog& operator=(ImportLog&& other) = delete;
+        ~ImportLog() = delete;
+
+        static eImportLogLevel GetLevel();
+        static void SetLevel(_In_ eImportLogLevel level);
+        static BOOL IsEnabled(_In_ eImportLogLevel level);
+
+        static void Write(_In_ eImportLogLevel level, _In_z_ _Printf_format_string_ PCSTR pszFormat, ...);
+        static void Write(_In_ eImportLogLevel level, _In_z_ _Printf_format_string_ PCWSTR pszFormat, ...);
+
+    private:
+        static std::atomic<eImportLogLevel> sm_level;
+    };
+}
@@ -1,5 +1,11 @@
 #include "Model/Model.h"
 
+#include <algorithm>
+#include <execution>
+#include <numeric>
+
+#include "Model/ImportLog.h"
+
 #include "assimp/Importer.hpp"	// C++ importer interface
 #include "assimp/scene.h"		    // output data structure
 #include "assimp/postprocess.h"	// post processing flags
@@ -36,31 +42,37 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   ConvertVector3dToFloat3
-
-      Summary:  Conver aiVector3D to XMFLOAT3
-
-      Returns:  XMFLOAT3
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    XMFLOAT3 ConvertVector3dToFloat3(_In_ const aiVector3D& vector)
-    {
-        return XMFLOAT3(vector.x, vector.y, vector.z);
-    }
+      Method:   Model::ComposeTransformation
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   ConvertQuaternionToVector
+      Summary:  Builds scalingMatrix * rotationMatrix * translationMatrix
+                without the two matrix products. Scaling first only
+                scales the rows of the rotation, translating last only
+                replaces the last row
 
-      Summary:  Convert aiQuaternion to XMVECTOR
+      Args:     FXMVECTOR scaling
+                  Scale along each axis
+                FXMVECTOR rotation
+                  Rotation quaternion
+                FXMVECTOR translation
+                  Translation
 
-      Returns:  XMVECTOR
+      Returns:  XMMATRIX
+                  Transformation matrix
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    XMVECTOR ConvertQuaternionToVector(_In_ const aiQuaternion& quaternion)
+    XMMATRIX Model::ComposeTransformation(_In_ FXMVECTOR scaling, _In_ FXMVECTOR rotation, _In_ FXMVECTOR translation)
     {
-        XMFLOAT4 float4 = XMFLOAT4(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
-        return XMLoadFloat4(&float4);
+        XMMATRIX transformation = XMMatrixRotationQuaternion(rotation);
+        transformation.r[0] = XMVectorMultiply(transformation.r[0], XMVectorSplatX(scaling));
+        transformation.r[1] = XMVectorMultiply(transformation.r[1], XMVectorSplatY(scaling));
+        transformation.r[2] = XMVectorMultiply(transformation.r[2], XMVectorSplatZ(scaling));
+        transformation.r[3] = XMVectorSetW(translation, 1.0f);
+
+        return transformation;
     }
 
     std::unique_ptr<Assimp::Importer> Model::sm_pImporter = std::make_unique<Assimp::Importer>();
+    std::unordered_multimap<std::wstring, std::weak_ptr<SkinnedMeshAsset>> Model::sm_assets;
+    std::atomic<BOOL> Model::sm_bQuantizeRotations(FALSE);
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Model
@@ -70,42 +82,48 @@ namespace library
       Args:     const std::filesystem::path& filePath
                   Path to the model to load
 
-      Modifies: [m_filePath, m_animationBuffer, m_skinningConstantBuffer,
-                 m_skinningConstantBuffer, m_aVertices, m_aAnimationData,
-                 m_aIndices, m_aBoneData, m_aBoneInfo, m_aTransforms,
-                 m_aBoneInfo, m_aTransforms, m_boneNameToIndexMap,
-                 m_pScene, m_timeSinceLoaded, m_globalInverseTransform].
+      Modifies: [m_filePath, m_asset, m_animationBuffer,
+                 m_skinningConstantBuffer, m_aAnimationData, m_aBoneData,
+                 m_aTransforms, m_aPreviousTransforms, m_aPoseTransforms,
+                 m_aKeyCursors, m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_uFramesSincePose, m_uUpdateInterval, m_lastDeltaTime].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Model::Model(_In_ const std::filesystem::path& filePath)
         : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
         , m_filePath(filePath)
+        , m_asset()
         , m_animationBuffer(nullptr)
         , m_skinningConstantBuffer(nullptr)
-        , m_aVertices(std::vector<SimpleVertex>())
         , m_aAnimationData(std::vector<AnimationData>())
-        , m_aIndices(std::vector<WORD>())   //TIP :  ʱȭ.
         , m_aBoneData(std::vector<VertexBoneData>())
-        , m_aBoneInfo(std::vector<BoneInfo>())
         , m_aTransforms(std::vector<XMMATRIX>())
-        , m_boneNameToIndexMap(std::unordered_map<std::string, UINT>())
-        , m_pScene()
-        , m_timeSinceLoaded(0.0f)
-        , m_globalInverseTransform(XMMatrixIdentity())
+        , m_aPreviousTransforms()
+        , m_aPoseTransforms()
+        , m_aKeyCursors()
+        , m_aAnimationLayers{ { .uClipIndex = 0u, .time = 0.0f, .weight = 1.0f, .targetWeight = 1.0f, .weightSpeed = 0.0f } }
+        , m_uNumAnimationLayers(1u)
+        , m_uFramesSincePose(UINT_MAX)
+        , m_uUpdateInterval(0u)
+        , m_lastDeltaTime(0.0f)
     {
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Initialize
 
-      Summary:  Load and initialize the 3d model and create buffers
+      Summary:  Load and initialize the 3d model and create buffers.
+                A file already loaded by another model on the same
+                device is not parsed again, its asset is shared and
+                only the per instance buffers and bone palette are
+                created. Assets no model holds anymore are dropped
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_pScene, m_globalInverseTransform, m_animationBuffer,
-                 m_skinningConstantBuffer].
+      Modifies: [sm_assets, m_asset, m_skinningConstantBuffer,
+                 m_aTransforms, m_aKeyCursors].
 
       Returns:  HRESULT
                   Status code
@@ -114,51 +132,41 @@ namespace library
     {
         HRESULT hr = S_OK;
 
-        // Create the buffers for the vertices attributes
-        //   ɸ ̴.   ٸ.
-        m_pScene = sm_pImporter.get()->ReadFile(
-            m_filePath.string().c_str(),
-            ASSIMP_LOAD_FLAGS
-            );
-        
-        if (m_pScene)
+        std::wstring szAssetKey = m_filePath.lexically_normal().wstring();
+        if (isAssetShared())
         {
-            m_globalInverseTransform =  XMMatrixInverse(nullptr, ConvertMatrix(m_pScene->mRootNode->mTransformation));
-            hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
+            std::erase_if(sm_assets, [](const auto& entry) { return entry.second.expired(); });
+
+            // The buffers of an asset belong to the device that created them
+            auto range = sm_assets.equal_range(szAssetKey);
+            for (auto it = range.first; it != range.second && !m_asset; ++it)
+            {
+                std::shared_ptr<SkinnedMeshAsset> asset = it->second.lock();
+                if (asset && asset->pDevice == pDevice)
+                {
+                    m_asset = std::move(asset);
+                }
+            }
+        }
+
+        if (m_asset)
+        {
+            hr = initFromAsset(pDevice);
         }
         else
         {
-            hr = E_FAIL;
-            OutputDebugString(L"Error parsing ");
-            OutputDebugString(m_filePath.c_str());
-            OutputDebugString(L": ");
-            OutputDebugStringA(sm_pImporter.get()->GetErrorString());
-            OutputDebugString(L"\n");
+            hr = loadAsset(pDevice, pImmediateContext);
+            if (SUCCEEDED(hr) && isAssetShared())
+            {
+                m_asset->pDevice = pDevice;
+                sm_assets.emplace(szAssetKey, m_asset);
+            }
         }
 
-        // Create m_animationBuffer, m_skinningConstantBuffer
-        {
-            D3D11_BUFFER_DESC bd =
-            {
-                .ByteWidth = sizeof(SimpleVertex) * GetNumVertices(),
-                .Usage = D3D11_USAGE_DEFAULT,
-                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
-                .CPUAccessFlags = 0u,
-                .MiscFlags = 0u
-            };
-
-            D3D11_SUBRESOURCE_DATA initData =
-            {
-                .pSysMem = m_aAnimationData.data(),
-                .SysMemPitch = 0u,
-                .SysMemSlicePitch = 0u
-            };
-            hr = pDevice->CreateBuffer(&bd, &initData, m_animationBuffer.GetAddressOf());
-
-            if (FAILED(hr))
-                return hr;
-        }
+        if (FAILED(hr))
+            return hr;
 
+        // Create m_skinningConstantBuffer
         {
             D3D11_BUFFER_DESC bd =
             {
@@ -174,38 +182,154 @@ namespace library
                 return hr;
         }
 
+        initPlayback();
+
         return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Update
 
-      Summary:  Update bone transformations
+      Summary:  Advances the animation and poses the skeleton. Only
+                this model's state is written, so distinct models can be
+                updated concurrently
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
 
-      Modifies: [m_aTransforms].
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_uFramesSincePose, m_aKeyCursors, m_aTransforms].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::Update(_In_ FLOAT deltaTime)
     {
-        m_timeSinceLoaded += deltaTime;
-        if (m_pScene->HasAnimations())
+        Advance(deltaTime);
+        PoseSkeleton();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::Advance
+
+      Summary:  Advances the time of every playing clip and moves the
+                weights toward their targets without posing the
+                skeleton. A clip that faded out to 0 stops playing,
+                unless it is the last one. Until PoseSkeleton is called
+                again the bone palette keeps the last pose, or moves
+                toward the pose sampled ahead when the skeleton is
+                posed less often than every frame
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
+
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_aKeyCursors, m_uFramesSincePose, m_lastDeltaTime,
+                 m_aTransforms].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::Advance(_In_ FLOAT deltaTime)
+    {
+        for (UINT uLayer = 0u; uLayer < m_uNumAnimationLayers;)
+        {
+            AnimationLayer& layer = m_aAnimationLayers[uLayer];
+            layer.time += deltaTime;
+
+            FLOAT step = layer.weightSpeed * deltaTime;
+            if (layer.weight < layer.targetWeight)
+            {
+                layer.weight = layer.weight + step < layer.targetWeight ? layer.weight + step : layer.targetWeight;
+            }
+            else if (layer.weight > layer.targetWeight)
+            {
+                layer.weight = layer.weight - step > layer.targetWeight ? layer.weight - step : layer.targetWeight;
+            }
+
+            if (layer.weight <= 0.0f && layer.targetWeight <= 0.0f && m_uNumAnimationLayers > 1u)
+            {
+                removeAnimationLayer(uLayer);
+                continue;
+            }
+            ++uLayer;
+        }
+
+        m_lastDeltaTime = deltaTime;
+        if (m_uFramesSincePose < UINT_MAX)
+        {
+            ++m_uFramesSincePose;
+            if (m_uFramesSincePose < m_uUpdateInterval)
+            {
+                interpolatePose();
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::PoseSkeleton
+
+      Summary:  Poses the skeleton at the current time of every
+                playing clip, blended by their weights. A skeleton
+                posed only every few frames is sampled where it will be
+                at the end of the interval instead, and the palette
+                moves there from the pose shown until now over the
+                frames in between, so skipped frames keep animating.
+                The first pose is always taken at the current time, and
+                the model stays due to start interpolating next frame
+
+      Args:     UINT uUpdateInterval
+                  Frames until the skeleton is posed again
+
+      Modifies: [m_uFramesSincePose, m_uUpdateInterval, m_aKeyCursors,
+                 m_aTransforms, m_aPreviousTransforms,
+                 m_aPoseTransforms].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::PoseSkeleton(_In_opt_ UINT uUpdateInterval)
+    {
+        m_uFramesSincePose = 0u;
+        if (!m_asset || m_asset->aAnimationClips.empty())
         {
-            XMMATRIX identity = XMMatrixIdentity();
-            FLOAT ticksPerSecond =
-                static_cast<FLOAT>(m_pScene->mAnimations[0]->mTicksPerSecond !=
-                    0.0 ? m_pScene->mAnimations[0]->mTicksPerSecond : 25.0f);
-            FLOAT timeInTicks = m_timeSinceLoaded * ticksPerSecond;
-            FLOAT animationTimeTicks = fmod(timeInTicks, static_cast<FLOAT>(m_pScene->mAnimations[0]->mDuration));
-            if (m_pScene->mRootNode)
+            return;
+        }
+
+        if (uUpdateInterval <= 1u || m_uUpdateInterval == 0u)
+        {
+            updateSkeleton(0.0f, m_aTransforms);
+            if (uUpdateInterval > 1u)
             {
-                readNodeHierarchy(animationTimeTicks, m_pScene->mRootNode, identity);   //Question : 3° μ ?  θ transform.
-                m_aTransforms.resize(m_aBoneInfo.size());
-                for (UINT i = 0u; i < m_aBoneInfo.size(); ++i)
-                    m_aTransforms[i] = m_aBoneInfo[i].FinalTransformation;
+                m_uFramesSincePose = UINT_MAX;
             }
+            m_uUpdateInterval = 1u;
+            return;
         }
+
+        m_uUpdateInterval = uUpdateInterval;
+        m_aPreviousTransforms.swap(m_aTransforms);
+        updateSkeleton(static_cast<FLOAT>(uUpdateInterval - 1u) * m_lastDeltaTime, m_aPoseTransforms);
+        interpolatePose();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetFramesSincePose
+
+      Summary:  Returns the number of Advance calls since the skeleton
+                was last posed
+
+      Returns:  UINT
+                  Frames since the last pose, UINT_MAX before the first
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::GetFramesSincePose() const
+    {
+        return m_uFramesSincePose;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetNumSkeletonNodes
+
+      Summary:  Returns the number of skeleton nodes, the cost of
+                posing the skeleton
+
+      Returns:  UINT
+                  Number of skeleton nodes, 0 without animations
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::GetNumSkeletonNodes() const
+    {
+        return m_asset && !m_asset->aAnimationClips.empty() ? static_cast<UINT>(m_asset->aSkeletonNodes.size()) : 0u;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -244,7 +368,7 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     UINT Model::GetNumVertices() const
     {
-        return static_cast<UINT>(m_aVertices.size());
+        return m_asset ? static_cast<UINT>(m_asset->aVertices.size()) : 0u;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -257,7 +381,7 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     UINT Model::GetNumIndices() const
     {
-        return static_cast<UINT>(m_aIndices.size());
+        return m_asset ? static_cast<UINT>(m_asset->aIndices.size()) : 0u;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -283,151 +407,354 @@ namespace library
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     const std::unordered_map<std::string, UINT>& Model::GetBoneNameToIndexMap() const
     {
-        return m_boneNameToIndexMap;
+        return m_asset->boneNameToIndexMap;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::countVerticesAndIndices
+      Method:   Model::SetAnimationClip
 
-      Summary:  Fill the BasicMeshEntry information
+      Summary:  Plays another animation clip of the model from its
+                start with the full weight, stopping every other clip.
+                The new clip is posed at the next chance
 
-      Args:     UINT& uOutNumVertices
-                  Total number of vertices
-                UINT& uOutNumIndices
-                  Total number of indices
-                const aiScene* pScene
-                  Pointer to an assimp scene object that contains the 
-                  mesh information
+      Args:     UINT uClipIndex
+                  Index of the clip
+
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_uFramesSincePose, m_aKeyCursors].
+
+      Returns:  HRESULT
+                  Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene)
-    {
-        for (UINT i = 0u; i < m_aMeshes.size(); ++i)
-        {
-            m_aMeshes[i].uMaterialIndex = pScene->mMeshes[i]->mMaterialIndex;
-            m_aMeshes[i].uNumIndices = pScene->mMeshes[i]->mNumFaces * 3u;
-            m_aMeshes[i].uBaseVertex = uOutNumVertices;
-            m_aMeshes[i].uBaseIndex = uOutNumIndices;
-
-            uOutNumVertices += pScene->mMeshes[i]->mNumVertices;
-            uOutNumIndices += m_aMeshes[i].uNumIndices;
-        }
-    }
-
+    HRESULT Model::SetAnimationClip(_In_ UINT uClipIndex)
+    {
+        if (!m_asset || uClipIndex >= m_asset->aAnimationClips.size())
+        {
+            return E_INVALIDARG;
+        }
+
+        m_uNumAnimationLayers = 0u;
+        setLayerWeight(m_aAnimationLayers[addAnimationLayer(uClipIndex)], 1.0f, 0.0f);
+        m_uFramesSincePose = UINT_MAX;
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findNodeAnimOrNull
+      Method:   Model::CrossfadeToAnimationClip
 
-        Summary:  Find the aiNodeAnim with the givne node name in the given animation
+      Summary:  Fades the weight of a clip to 1 and of every other
+                playing clip to 0 over the same duration. A clip that
+                is not playing yet starts from its start, one that is
+                still fading out carries on from its time. The weights
+                of a crossfade started during another one start from
+                where the first one left them
 
-        Args:     const aiAnimation* pAnimation
-                    Pointer to an assimp animation object
-                  PCSTR pszNodeName
-                    Node name to find
+      Args:     UINT uClipIndex
+                  Index of the clip
+                FLOAT fadeDuration
+                  Seconds until the clip fully replaces the others,
+                  SetAnimationClip is used when not positive
 
-        Returns:  aiNodeAnim* or nullptr
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    const aiNodeAnim* Model::findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName)
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_uFramesSincePose, m_aKeyCursors].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Model::CrossfadeToAnimationClip(_In_ UINT uClipIndex, _In_ FLOAT fadeDuration)
     {
-        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        if (!m_asset || uClipIndex >= m_asset->aAnimationClips.size())
         {
-            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
+            return E_INVALIDARG;
+        }
 
-            if (strncmp(pNodeAnim->mNodeName.data, pszNodeName, pNodeAnim->mNodeName.length) == 0)
-            {
-                return pNodeAnim;
-            }
+        if (fadeDuration <= 0.0f)
+        {
+            return SetAnimationClip(uClipIndex);
         }
 
-        return nullptr;
-    }
+        UINT uFadeInLayer = findAnimationLayer(uClipIndex);
+        if (uFadeInLayer == INVALID_INDEX)
+        {
+            uFadeInLayer = addAnimationLayer(uClipIndex);
+        }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findPosition
+        for (UINT uLayer = 0u; uLayer < m_uNumAnimationLayers; ++uLayer)
+        {
+            setLayerWeight(m_aAnimationLayers[uLayer], uLayer == uFadeInLayer ? 1.0f : 0.0f, fadeDuration);
+        }
+        m_uFramesSincePose = UINT_MAX;
 
-        Summary:  Find the index of the position key right before the given animation time
+        return S_OK;
+    }
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::BlendAnimationClip
+
+      Summary:  Fades the weight of one clip to a target and leaves the
+                other clips as they are. Weights are relative, the pose
+                is blended from the weights divided by their sum, so
+                0.7 walk and 0.3 run mix the two clips. A clip that is
+                not playing yet starts from its start with weight 0.
+                When MAX_ANIMATION_LAYERS clips already play, the one
+                with the lowest weight is replaced
+
+      Args:     UINT uClipIndex
+                  Index of the clip
+                FLOAT weight
+                  Target weight, not negative. A clip faded to 0 stops
+                  playing
+                FLOAT fadeDuration
+                  Seconds until the weight reaches the target, set at
+                  once when not positive
+
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_uFramesSincePose, m_aKeyCursors].
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Model::BlendAnimationClip(_In_ UINT uClipIndex, _In_ FLOAT weight, _In_ FLOAT fadeDuration)
     {
-        assert(pNodeAnim->mNumPositionKeys > 0);
+        if (!m_asset || uClipIndex >= m_asset->aAnimationClips.size() || !(weight >= 0.0f))
+        {
+            return E_INVALIDARG;
+        }
 
-        for (UINT i = 0u; i < pNodeAnim->mNumPositionKeys - 1; ++i)
+        UINT uLayer = findAnimationLayer(uClipIndex);
+        if (uLayer == INVALID_INDEX)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mPositionKeys[i + 1].mTime);
+            uLayer = addAnimationLayer(uClipIndex);
+        }
 
-            if (animationTimeTicks < t)
-            {
-                return i;
-            }
+        setLayerWeight(m_aAnimationLayers[uLayer], weight, fadeDuration);
+        if (fadeDuration <= 0.0f)
+        {
+            m_uFramesSincePose = UINT_MAX;
         }
 
-        return 0u;
+        return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findRotation
+      Method:   Model::GetAnimationClipWeight
 
-        Summary:  Find the index of the rotation key right before the given animation time
+      Summary:  Returns the current blend weight of a clip
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+      Args:     UINT uClipIndex
+                  Index of the clip
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+      Returns:  FLOAT
+                  Weight of the clip, 0 when it is not playing
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT Model::GetAnimationClipWeight(_In_ UINT uClipIndex) const
     {
-        assert(pNodeAnim->mNumRotationKeys > 0);
+        UINT uLayer = findAnimationLayer(uClipIndex);
 
-        for (UINT i = 0u; i < pNodeAnim->mNumRotationKeys - 1; ++i)
-        {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mRotationKeys[i + 1].mTime);
+        return uLayer != INVALID_INDEX ? m_aAnimationLayers[uLayer].weight : 0.0f;
+    }
 
-            if (animationTimeTicks < t)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetNumAnimationClips
+
+      Summary:  Returns the number of animation clips
+
+      Returns:  UINT
+                  Number of animation clips
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::GetNumAnimationClips() const
+    {
+        return m_asset ? static_cast<UINT>(m_asset->aAnimationClips.size()) : 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetQuantizeRotations
+
+      Summary:  Returns whether the rotation keys of imported clips are
+                quantized to 4 x 16 bit snorm
+
+      Returns:  BOOL
+                  TRUE if rotations are quantized
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Model::GetQuantizeRotations()
+    {
+        return sm_bQuantizeRotations.load(std::memory_order_relaxed);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetQuantizeRotations
+
+      Summary:  Changes whether the rotation keys of clips are quantized
+                to 4 x 16 bit snorm, which halves their memory. Only
+                files imported afterwards are affected, models sharing
+                an already imported file keep its clips
+
+      Args:     BOOL bQuantizeRotations
+                  TRUE to quantize rotations
+
+      Modifies: [sm_bQuantizeRotations].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::SetQuantizeRotations(_In_ BOOL bQuantizeRotations)
+    {
+        sm_bQuantizeRotations.store(bQuantizeRotations, std::memory_order_relaxed);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetNumSharedAssets
+
+      Summary:  Returns the number of assets shared between models,
+                including the ones dropped at the next Initialize
+
+      Returns:  size_t
+                  Number of shared assets
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t Model::GetNumSharedAssets()
+    {
+        return sm_assets.size();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::addAnimationLayer
+
+      Summary:  Starts playing a clip from its start with weight 0.
+                When every layer is used, the one with the lowest
+                weight is replaced
+
+      Args:     UINT uClipIndex
+                  Index of the clip
+
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_aKeyCursors].
+
+      Returns:  UINT
+                  Layer of the clip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::addAnimationLayer(_In_ UINT uClipIndex)
+    {
+        UINT uLayer = m_uNumAnimationLayers;
+        if (uLayer == MAX_ANIMATION_LAYERS)
+        {
+            uLayer = 0u;
+            for (UINT i = 1u; i < m_uNumAnimationLayers; ++i)
             {
-                return i;
+                if (m_aAnimationLayers[i].weight < m_aAnimationLayers[uLayer].weight)
+                {
+                    uLayer = i;
+                }
             }
         }
+        else
+        {
+            ++m_uNumAnimationLayers;
+        }
 
-        return 0u;
+        m_aAnimationLayers[uLayer] =
+        {
+            .uClipIndex = uClipIndex,
+            .time = 0.0f,
+            .weight = 0.0f,
+            .targetWeight = 0.0f,
+            .weightSpeed = 0.0f
+        };
+
+        // Each layer has its own run of key cursors, one per skeleton node
+        size_t uNumNodes = m_aKeyCursors.size() / MAX_ANIMATION_LAYERS;
+        std::fill_n(m_aKeyCursors.begin() + static_cast<ptrdiff_t>(uLayer * uNumNodes), uNumNodes, AnimationClip::KeyCursor{ .uPositionKey = 0u, .uRotationKey = 0u, .uScalingKey = 0u });
+
+        return uLayer;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findScaling
+      Method:   Model::bindSkeleton
 
-        Summary:  Find the index of the scaling key right before the given animation time
+      Summary:  Flattens the node hierarchy in depth first order, so
+                every parent precedes its children, and resolves the
+                bone index of each node and its channel in every clip
+                once instead of by name every frame
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+      Args:     const aiNode* pNode
+                  Pointer to an assimp node object
+                UINT uParentIndex
+                  Index of the parent node, INVALID_INDEX for the root
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    UINT Model::findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+      Modifies: [m_asset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::bindSkeleton(_In_ const aiNode* pNode, _In_ UINT uParentIndex)
     {
-        assert(pNodeAnim->mNumScalingKeys > 0);
+        auto boneIt = m_asset->boneNameToIndexMap.find(pNode->mName.C_Str());
+
+        UINT uNodeIndex = static_cast<UINT>(m_asset->aSkeletonNodes.size());
+        m_asset->aSkeletonNodes.push_back(
+            SkeletonNode
+            {
+                .Transformation = ConvertMatrix(pNode->mTransformation),
+                .uParentIndex = uParentIndex,
+                .uBoneIndex = boneIt != m_asset->boneNameToIndexMap.end() ? boneIt->second : INVALID_INDEX
+            }
+        );
 
-        for (UINT i = 0u; i < pNodeAnim->mNumScalingKeys - 1; ++i)
+        for (const std::unique_ptr<AnimationClip>& animationClip : m_asset->aAnimationClips)
         {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mScalingKeys[i + 1].mTime);
+            m_asset->aChannels.push_back(animationClip->FindChannel(pNode->mName.C_Str()));
+        }
+
+        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
+        {
+            bindSkeleton(pNode->mChildren[i], uNodeIndex);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::countVerticesAndIndices
 
-            if (animationTimeTicks < t)
+      Summary:  Fill the BasicMeshEntry information
+
+      Args:     UINT& uOutNumVertices
+                  Total number of vertices
+                UINT& uOutNumIndices
+                  Total number of indices
+                const aiScene* pScene
+                  Pointer to an assimp scene object that contains the 
+                  mesh information
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene)
+    {
+        for (UINT i = 0u; i < m_aMeshes.size(); ++i)
+        {
+            m_aMeshes[i].uMaterialIndex = pScene->mMeshes[i]->mMaterialIndex;
+            m_aMeshes[i].uNumIndices = pScene->mMeshes[i]->mNumFaces * 3u;
+            m_aMeshes[i].uBaseVertex = uOutNumVertices;
+            m_aMeshes[i].uBaseIndex = uOutNumIndices;
+
+            uOutNumVertices += pScene->mMeshes[i]->mNumVertices;
+            uOutNumIndices += m_aMeshes[i].uNumIndices;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::findAnimationLayer
+
+      Summary:  Returns the layer playing a clip
+
+      Args:     UINT uClipIndex
+                  Index of the clip
+
+      Returns:  UINT
+                  Layer of the clip, INVALID_INDEX when it is not
+                  playing
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Model::findAnimationLayer(_In_ UINT uClipIndex) const
+    {
+        for (UINT uLayer = 0u; uLayer < m_uNumAnimationLayers; ++uLayer)
+        {
+            if (m_aAnimationLayers[uLayer].uClipIndex == uClipIndex)
             {
-                return i;
+                return uLayer;
             }
         }
 
-        return 0u;
+        return INVALID_INDEX;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -438,7 +765,7 @@ namespace library
         Args:      const aiBone* pBone
                      Pointer to an assimp bone object
 
-        Modifies: [m_boneNameToIndexMap].
+        Modifies: [m_asset].
 
         Returns:  UINT
                     Index of the bone
@@ -447,14 +774,14 @@ namespace library
     {
         UINT uBoneIndex = 0u;
         PCSTR pszBoneName = pBone->mName.C_Str();
-        if (!m_boneNameToIndexMap.contains(pszBoneName))
+        if (!m_asset->boneNameToIndexMap.contains(pszBoneName))
         {
-            uBoneIndex = static_cast<UINT>(m_boneNameToIndexMap.size());
-            m_boneNameToIndexMap[pszBoneName] = uBoneIndex;
+            uBoneIndex = static_cast<UINT>(m_asset->boneNameToIndexMap.size());
+            m_asset->boneNameToIndexMap[pszBoneName] = uBoneIndex;
         }
         else
         {
-            uBoneIndex = m_boneNameToIndexMap[pszBoneName];
+            uBoneIndex = m_asset->boneNameToIndexMap[pszBoneName];
         }
 
         return uBoneIndex;
@@ -470,7 +797,7 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     const SimpleVertex* Model::getVertices() const
     {
-        return m_aVertices.data();
+        return m_asset ? m_asset->aVertices.data() : nullptr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -483,23 +810,61 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     const WORD* Model::getIndices() const
     {
-        return m_aIndices.data();
+        return m_asset ? m_asset->aIndices.data() : nullptr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initAllMeshes
 
-      Summary:  Initialize all meshes in a given assimp scene
+      Summary:  Initialize all meshes in a given assimp scene in
+                parallel. countVerticesAndIndices assigned every mesh
+                its base vertex and index, so the meshes write disjoint
+                slices and the result matches a serial import
 
       Args:     const aiScene* pScene
                   Assimp scene
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::initAllMeshes(_In_ const aiScene* pScene)
     {
-        for (UINT i = 0u; i < m_aMeshes.size(); ++i)
-        {
-            initSingleMesh(i, pScene->mMeshes[i]);
-        }
+        std::vector<UINT> aMeshIndices(m_aMeshes.size());
+        std::iota(aMeshIndices.begin(), aMeshIndices.end(), 0u);
+
+        std::for_each(std::execution::par, aMeshIndices.begin(), aMeshIndices.end(),
+            [this, pScene](UINT uMeshIndex)
+            {
+                initSingleMesh(uMeshIndex, pScene->mMeshes[uMeshIndex]);
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initFromAsset
+
+      Summary:  Takes the shared buffers, meshes and materials of an
+                already loaded asset and creates the constant buffer of
+                this instance
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+
+      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer,
+                 m_animationBuffer, m_aMeshes, m_aMaterials,
+                 m_bHasNormalMap, m_constantBuffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Model::initFromAsset(_In_ ID3D11Device* pDevice)
+    {
+        m_vertexBuffer = m_asset->VertexBuffer;
+        m_normalBuffer = m_asset->NormalBuffer;
+        m_indexBuffer = m_asset->IndexBuffer;
+        m_animationBuffer = m_asset->AnimationBuffer;
+        m_aMeshes = m_asset->aMeshes;
+        m_aMaterials = m_asset->aMaterials;
+        m_bHasNormalMap = m_asset->bHasNormalMap;
+
+        return initializeConstantBuffer(pDevice);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -535,13 +900,25 @@ namespace library
         reserveSpace(numVertices, numIndices);
 
         initAllMeshes(pScene);
+        initAllBones(pScene);
+
+        for (UINT i = 0u; i < pScene->mNumAnimations; ++i)
+        {
+            m_asset->aAnimationClips.push_back(std::make_unique<AnimationClip>(pScene->mAnimations[i], GetQuantizeRotations()));
+        }
+
+        // Bones are known once every mesh is initialized
+        if (pScene->mRootNode)
+        {
+            bindSkeleton(pScene->mRootNode, INVALID_INDEX);
+        }
         HRESULT hr = initMaterials(pDevice, pImmediateContext, pScene, filePath);
         if (FAILED(hr))
             return hr;
 
         // Create AnimationData
         //Question :  ƴ . ̰ ˷ m_aBoneData ִ  ˸ .
-        for (size_t i = 0; i < m_aVertices.size(); ++i)
+        for (size_t i = 0; i < m_asset->aVertices.size(); ++i)
         {
             m_aAnimationData.push_back(
                 AnimationData
@@ -605,12 +982,53 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initMeshBones
+      Method:   Model::initAllBones
 
-      Summary:  Initialize all bones in a given aiMesh
+      Summary:  Initialize the bones of all meshes. Bone ids and offsets
+                are assigned serially in mesh order, then the weights of
+                every mesh are gathered in parallel. Meshes own disjoint
+                vertex ranges, so no lock is needed
 
       Args:     const aiScene* pScene
                   Assimp scene
+
+      Modifies: [m_asset, m_aBoneData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initAllBones(_In_ const aiScene* pScene)
+    {
+        for (UINT i = 0u; i < pScene->mNumMeshes; ++i)
+        {
+            const aiMesh* pMesh = pScene->mMeshes[i];
+            for (UINT j = 0u; j < pMesh->mNumBones; ++j)
+            {
+                UINT uBoneId = getBoneId(pMesh->mBones[j]);
+                if (uBoneId == m_asset->aBoneOffsets.size())
+                {
+                    m_asset->aBoneOffsets.push_back(ConvertMatrix(pMesh->mBones[j]->mOffsetMatrix));
+                }
+            }
+        }
+
+        std::vector<UINT> aMeshIndices(pScene->mNumMeshes);
+        std::iota(aMeshIndices.begin(), aMeshIndices.end(), 0u);
+
+        std::for_each(std::execution::par, aMeshIndices.begin(), aMeshIndices.end(),
+            [this, pScene](UINT uMeshIndex)
+            {
+                initMeshBones(uMeshIndex, pScene->mMeshes[uMeshIndex]);
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initMeshBones
+
+      Summary:  Initialize all bones in a given aiMesh
+
+      Args:     UINT uMeshIndex
+                  Index of mesh
+                const aiMesh* pMesh
+                  Point to an assimp mesh object
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::initMeshBones(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh)
     {
@@ -623,20 +1041,22 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initMeshSingleBone
 
-      Summary:  Initialize a single bone of the mesh
+      Summary:  Adds the weights of a single bone to the vertices of the
+                mesh. Only reads the bone map, initAllBones assigned
+                the id already
 
-      Args:     const aiScene* pScene
-                  Assimp scene
+      Args:     UINT uMeshIndex
+                  Index of mesh
+                const aiBone* pBone
+                  Pointer to an assimp bone object
+
+      Modifies: [m_aBoneData].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::initMeshSingleBone(_In_ UINT uMeshIndex, _In_ const aiBone* pBone)
     {
-        UINT uBoneId = getBoneId(pBone);
+        UINT uBoneId = m_asset->boneNameToIndexMap.find(pBone->mName.C_Str())->second;
 
-        if (uBoneId == m_aBoneInfo.size())
-        {
-            BoneInfo boneInfo(ConvertMatrix(pBone->mOffsetMatrix));
-            m_aBoneInfo.push_back(boneInfo);
-        }
+        ImportLog::Write(eImportLogLevel::VERBOSE, "\t\tBone %u %s, %u weights\n", uBoneId, pBone->mName.C_Str(), pBone->mNumWeights);
 
         for (UINT i = 0u; i < pBone->mNumWeights; ++i)
         {
@@ -646,6 +1066,24 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initPlayback
+
+      Summary:  Allocates the bone palettes and the key cursors of
+                every animation layer once, so playing, blending and
+                posing clips do not allocate
+
+      Modifies: [m_aTransforms, m_aPreviousTransforms,
+                 m_aPoseTransforms, m_aKeyCursors].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::initPlayback()
+    {
+        m_aTransforms.assign(m_asset->aBoneOffsets.size(), XMMatrixIdentity());
+        m_aPreviousTransforms.assign(m_asset->aBoneOffsets.size(), XMMatrixIdentity());
+        m_aPoseTransforms.assign(m_asset->aBoneOffsets.size(), XMMatrixIdentity());
+        m_aKeyCursors.assign(MAX_ANIMATION_LAYERS * m_asset->aSkeletonNodes.size(), AnimationClip::KeyCursor{ .uPositionKey = 0u, .uRotationKey = 0u, .uScalingKey = 0u });
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::initSingleMesh
 
@@ -660,6 +1098,11 @@ namespace library
     {
         //Question : (̰ ˸  )   ǵߴٰ ⿣ ſ ... DrawIndexed............................... Ű  Ȱؾ Ѵ.
         const aiVector3D zero3d(0.0f, 0.0f, 0.0f);
+
+        // Each mesh writes its own slice of the presized arrays
+        SimpleVertex* pVertices = m_asset->aVertices.data() + m_aMeshes[uMeshIndex].uBaseVertex;
+        NormalData* pNormalData = m_aNormalData.data() + m_aMeshes[uMeshIndex].uBaseVertex;
+        WORD* pIndices = m_asset->aIndices.data() + m_aMeshes[uMeshIndex].uBaseIndex;
         
         for (UINT i = 0u; i < pMesh->mNumVertices; ++i)
         {
@@ -681,12 +1124,10 @@ namespace library
                 .Tangent = XMFLOAT3(tangent.x, tangent.y, tangent.z),
                 .Bitangent = XMFLOAT3(bitangent.x, bitangent.y, bitangent.z)
             };
-            m_aVertices.push_back(vertex);
-            m_aNormalData.push_back(normalData);
+            pVertices[i] = vertex;
+            pNormalData[i] = normalData;
         }
 
-        initMeshBones(uMeshIndex, pMesh);
-        
         for (UINT i = 0u; i < pMesh->mNumFaces; ++i)
         {
             const aiFace& face = pMesh->mFaces[i];
@@ -697,116 +1138,162 @@ namespace library
                 static_cast<WORD>(face.mIndices[1]),
                 static_cast<WORD>(face.mIndices[2]),
             };
-            m_aIndices.push_back(aIndices[0]);
-            m_aIndices.push_back(aIndices[1]);
-            m_aIndices.push_back(aIndices[2]);
+            pIndices[i * 3u] = aIndices[0];
+            pIndices[i * 3u + 1u] = aIndices[1];
+            pIndices[i * 3u + 2u] = aIndices[2];
         }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolatePosition
+      Method:   Model::interpolatePose
 
-      Summary:  Interpolate two keyframes to find translate vector
+      Summary:  Moves the bone palette from the pose shown when the
+                skeleton was last posed toward the pose sampled at the
+                end of the update interval. Bone matrices are lerped,
+                which stays close to the sampled motion over the few
+                frames of an interval
 
-      Args:     XMFLOAT3& outTranslate
-                  Translate vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+      Modifies: [m_aTransforms].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
+    void Model::interpolatePose()
     {
-        if (pNodeAnim->mNumPositionKeys == 1)
+        FLOAT t = static_cast<FLOAT>(m_uFramesSincePose + 1u) / static_cast<FLOAT>(m_uUpdateInterval);
+        for (size_t i = 0u; i < m_aTransforms.size(); ++i)
         {
-            outTranslate = ConvertVector3dToFloat3(pNodeAnim->mPositionKeys[0].mValue);
-            return;
+            for (UINT uRow = 0u; uRow < 4u; ++uRow)
+            {
+                m_aTransforms[i].r[uRow] = XMVectorLerp(m_aPreviousTransforms[i].r[uRow], m_aPoseTransforms[i].r[uRow], t);
+            }
         }
-        
-        UINT uPositionIndex = findPosition(animationTimeTicks, pNodeAnim);
-        UINT uNextPositionIndex = uPositionIndex + 1u;
-        assert(uNextPositionIndex < pNodeAnim->mNumPositionKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uPositionIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uNextPositionIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-        const aiVector3D& start = pNodeAnim->mPositionKeys[uPositionIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mPositionKeys[uNextPositionIndex].mValue;
-        aiVector3D delta = end - start;
-        outTranslate = ConvertVector3dToFloat3(start + factor * delta);
-    }
+    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolateRotation
+      Method:   Model::isAssetShared
 
-      Summary:  Interpolate two keyframes to find rotation vector
+      Summary:  Returns whether the asset of this model may be shared
+                with other models of the same file. Models that edit
+                their meshes or materials after loading return FALSE
 
-      Args:     XMVECTOR& outQuaternion
-                  Quaternion vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+      Returns:  BOOL
+                  TRUE if the asset is shared
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
-    {
-        if (pNodeAnim->mNumRotationKeys == 1)
-        {
-            outQuaternion = ConvertQuaternionToVector(pNodeAnim->mRotationKeys[0].mValue);
-            return;
-        }
-
-        UINT uRotationIndex = findRotation(animationTimeTicks, pNodeAnim);
-        UINT uNextRotationIndex = uRotationIndex + 1u;
-        assert(uNextRotationIndex < pNodeAnim->mNumRotationKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uRotationIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uNextRotationIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-        const aiQuaternion& start = pNodeAnim->mRotationKeys[uRotationIndex].mValue;
-        const aiQuaternion& end = pNodeAnim->mRotationKeys[uNextRotationIndex].mValue;
-        aiQuaternion quaternion;
-        aiQuaternion::Interpolate(quaternion, start, end, factor);
-        outQuaternion = ConvertQuaternionToVector(quaternion);
+    BOOL Model::isAssetShared() const
+    {
+        return TRUE;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolateScaling
+      Method:   Model::loadAsset
 
-      Summary:  Interpolate two keyframes to find scaling vector
+      Summary:  Parses the model file into a new asset and creates its
+                buffers. The imported scene is freed once everything the
+                model uses has been copied out of it
 
-      Args:     XMFLOAT3& outScale
-                  Scaling vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_asset, m_animationBuffer, m_aAnimationData,
+                 m_aBoneData, m_aNormalData].
+
+      Returns:  HRESULT
+                  Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim)
-    {
-        if (pNodeAnim->mNumScalingKeys == 1)
+    HRESULT Model::loadAsset(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        m_asset = std::make_shared<SkinnedMeshAsset>();
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        // Create the buffers for the vertices attributes
+        const aiScene* pScene = sm_pImporter.get()->ReadFile(
+            m_filePath.string().c_str(),
+            ASSIMP_LOAD_FLAGS
+            );
+
+        if (!pScene)
         {
-            outScale = ConvertVector3dToFloat3(pNodeAnim->mScalingKeys[0].mValue);
-            return;
+            ImportLog::Write(eImportLogLevel::WARNING, "Error parsing %s: %s\n", m_filePath.string().c_str(), sm_pImporter.get()->GetErrorString());
+            m_asset.reset();
+            return E_FAIL;
+        }
+
+        m_asset->GlobalInverseTransform = XMMatrixInverse(nullptr, ConvertMatrix(pScene->mRootNode->mTransformation));
+        HRESULT hr = initFromScene(pDevice, pImmediateContext, pScene, m_filePath);
+
+        if (!m_asset->aAnimationClips.empty() && ImportLog::IsEnabled(eImportLogLevel::INFO))
+        {
+            size_t uClipBytes = 0u;
+            size_t uImportedBytes = 0u;
+            for (UINT i = 0u; i < m_asset->aAnimationClips.size(); ++i)
+            {
+                uClipBytes += m_asset->aAnimationClips[i]->GetSizeInBytes();
+                uImportedBytes += AnimationClip::GetImportedSizeInBytes(pScene->mAnimations[i]);
+            }
+
+            ImportLog::Write(eImportLogLevel::INFO, "Model %s: animation keys take %zu bytes, %zu bytes in the imported scene\n",
+                m_filePath.filename().string().c_str(), uClipBytes, uImportedBytes);
+        }
+
+        sm_pImporter.get()->FreeScene();
+
+        if (FAILED(hr))
+        {
+            m_asset.reset();
+            return hr;
+        }
+
+        // Create m_animationBuffer
+        {
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = sizeof(SimpleVertex) * GetNumVertices(),
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = 0u,
+                .MiscFlags = 0u
+            };
+
+            D3D11_SUBRESOURCE_DATA initData =
+            {
+                .pSysMem = m_aAnimationData.data(),
+                .SysMemPitch = 0u,
+                .SysMemSlicePitch = 0u
+            };
+            hr = pDevice->CreateBuffer(&bd, &initData, m_animationBuffer.GetAddressOf());
+
+            if (FAILED(hr))
+            {
+                m_asset.reset();
+                return hr;
+            }
         }
 
-        UINT uScalingIndex = findScaling(animationTimeTicks, pNodeAnim);
-        UINT uNextScalingIndex = uScalingIndex + 1u;
-        assert(uNextScalingIndex < pNodeAnim->mNumScalingKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uScalingIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uNextScalingIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-        const aiVector3D& start = pNodeAnim->mScalingKeys[uScalingIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mScalingKeys[uNextScalingIndex].mValue;
-        aiVector3D delta = end - start;
-        outScale = ConvertVector3dToFloat3(start + factor * delta);
+        m_asset->aMeshes = m_aMeshes;
+        m_asset->aMaterials = m_aMaterials;
+        m_asset->VertexBuffer = m_vertexBuffer;
+        m_asset->NormalBuffer = m_normalBuffer;
+        m_asset->IndexBuffer = m_indexBuffer;
+        m_asset->AnimationBuffer = m_animationBuffer;
+        m_asset->bHasNormalMap = m_bHasNormalMap;
+
+        // Only the buffers need these
+        m_aAnimationData = std::vector<AnimationData>();
+        m_aBoneData = std::vector<VertexBoneData>();
+        m_aNormalData = std::vector<NormalData>();
+
+        LARGE_INTEGER endTime;
+        QueryPerformanceCounter(&endTime);
+
+        ImportLog::Write(eImportLogLevel::INFO, "Model %s: imported %u vertices, %zu bones in %.3f ms\n",
+            m_filePath.filename().string().c_str(), GetNumVertices(), m_asset->aBoneOffsets.size(),
+            static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart));
+
+        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -856,16 +1343,12 @@ namespace library
                 hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice, pImmediateContext);
                 if (FAILED(hr))
                 {
-                    OutputDebugString(L"Error loading diffuse texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
+                    ImportLog::Write(eImportLogLevel::WARNING, L"Error loading diffuse texture \"%s\"\n", fullPath.c_str());
 
                     return hr;
                 }
 
-                OutputDebugString(L"Loaded diffuse texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                ImportLog::Write(eImportLogLevel::INFO, L"Loaded diffuse texture \"%s\"\n", fullPath.c_str());
             }
         }
 
@@ -919,16 +1402,12 @@ namespace library
                 hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice, pImmediateContext);
                 if (FAILED(hr))
                 {
-                    OutputDebugString(L"Error loading specular texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
+                    ImportLog::Write(eImportLogLevel::WARNING, L"Error loading specular texture \"%s\"\n", fullPath.c_str());
 
                     return hr;
                 }
 
-                OutputDebugString(L"Loaded specular texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                ImportLog::Write(eImportLogLevel::INFO, L"Loaded specular texture \"%s\"\n", fullPath.c_str());
             }
         }
 
@@ -976,16 +1455,12 @@ namespace library
 
                 if (FAILED(hr))
                 {
-                    OutputDebugString(L"Error loading normal texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
+                    ImportLog::Write(eImportLogLevel::WARNING, L"Error loading normal texture \"%s\"\n", fullPath.c_str());
 
                     return hr;
                 }
 
-                OutputDebugString(L"Loaded normal texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                ImportLog::Write(eImportLogLevel::INFO, L"Loaded normal texture \"%s\"\n", fullPath.c_str());
             }
         }
 
@@ -1038,63 +1513,265 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::readNodeHierarchy
+      Method:   Model::removeAnimationLayer
 
-      Summary:  Calculate bone transformation of the given assimp node
+      Summary:  Stops playing the clip of a layer. The last layer
+                and its key cursors move into its place
 
-      Args:     FLOAT animationTimeTicks
-                  Animation time
-               const aiNode* pNode
-                  Pointer to an assimp node object
-                const XMMATRIX& parentTransform
-                  Parent transform in hierarchy
+      Args:     UINT uLayer
+                  Layer to remove
+
+      Modifies: [m_aAnimationLayers, m_uNumAnimationLayers,
+                 m_aKeyCursors].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    void Model::readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform)
-    {
-        XMMATRIX nodeTransformation = ConvertMatrix(pNode->mTransformation);
-        const aiNodeAnim* currentAnimation = findNodeAnimOrNull(m_pScene->mAnimations[0], pNode->mName.C_Str());
-        if (currentAnimation)
-        {
-            XMFLOAT3 scalingFloat3 = XMFLOAT3();
-            XMVECTOR rotationVector = XMVECTOR();
-            XMFLOAT3 positionFloat3 = XMFLOAT3();
-                
-            interpolateScaling(scalingFloat3, animationTimeTicks, currentAnimation);
-            interpolateRotation(rotationVector, animationTimeTicks, currentAnimation);
-            interpolatePosition(positionFloat3, animationTimeTicks, currentAnimation);
-            
-            XMMATRIX scalingMatrix = XMMatrixScaling(scalingFloat3.x, scalingFloat3.y, scalingFloat3.z);
-            XMMATRIX rotationMatrix = XMMatrixRotationQuaternion(rotationVector);
-            XMMATRIX translationMatrix = XMMatrixTranslation(positionFloat3.x, positionFloat3.y, positionFloat3.z);
-            nodeTransformation = scalingMatrix * rotationMatrix * translationMatrix;    // currentAnimation  ִµ.
-        }
-        XMMATRIX globalTransformation = nodeTransformation * parentTransform;
-
-        if (m_boneNameToIndexMap.find(pNode->mName.C_Str()) != m_boneNameToIndexMap.end())
-        {
-            UINT boneIndex = m_boneNameToIndexMap.find(pNode->mName.C_Str())->second;
-            XMMATRIX finalTransformation = m_aBoneInfo[boneIndex].OffsetMatrix * globalTransformation * m_globalInverseTransform;            m_aBoneInfo[boneIndex].FinalTransformation = finalTransformation;
-            int breakpointErrorDummy = -1;
-        }
-        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
-        {
-            readNodeHierarchy(animationTimeTicks, pNode->mChildren[i], globalTransformation);
-        }    }
+    void Model::removeAnimationLayer(_In_ UINT uLayer)
+    {
+        UINT uLastLayer = m_uNumAnimationLayers - 1u;
+        if (uLayer != uLastLayer)
+        {
+            size_t uNumNodes = m_aKeyCursors.size() / MAX_ANIMATION_LAYERS;
+            m_aAnimationLayers[uLayer] = m_aAnimationLayers[uLastLayer];
+            std::copy_n(m_aKeyCursors.begin() + static_cast<ptrdiff_t>(uLastLayer * uNumNodes), uNumNodes, m_aKeyCursors.begin() + static_cast<ptrdiff_t>(uLayer * uNumNodes));
+        }
+        m_uNumAnimationLayers = uLastLayer;
+    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::reserveSpace
 
-      Summary:  Reserve space for vertices and indices vectors
+      Summary:  Size the vertex, normal, index and bone vectors so
+                every mesh can write its slice in place
 
       Args:     UINT uNumVertices
                   Number of vertices
                 UINT uNumIndices
                   Number of indices
+
+      Modifies: [m_asset, m_aNormalData, m_aBoneData].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Model::reserveSpace(_In_ UINT uNumVertices, _In_ UINT uNumIndices)
     {
-        m_aVertices.reserve(uNumVertices);
-        m_aIndices.reserve(uNumIndices);
+        m_asset->aVertices.resize(uNumVertices);
+        m_asset->aIndices.resize(uNumIndices);
+        m_aNormalData.resize(uNumVertices);
         m_aBoneData.resize(uNumVertices);
-    }   
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::setLayerWeight
+
+      Summary:  Sets the target weight of a layer and the speed that
+                reaches it over the fade
+
+      Args:     AnimationLayer& layer
+                  Layer to fade
+                FLOAT weight
+                  Target weight
+                FLOAT fadeDuration
+                  Seconds until the weight reaches the target, set at
+                  once when not positive
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::setLayerWeight(_Inout_ AnimationLayer& layer, _In_ FLOAT weight, _In_ FLOAT fadeDuration)
+    {
+        layer.targetWeight = weight;
+        if (fadeDuration <= 0.0f)
+        {
+            layer.weight = weight;
+            layer.weightSpeed = 0.0f;
+        }
+        else
+        {
+            layer.weightSpeed = fabs(weight - layer.weight) / fadeDuration;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::updateSkeleton
+
+      Summary:  Calculate bone transformations with one pass over the
+                flattened hierarchy, parents are always updated before
+                their children. The global transforms are scratch kept
+                per thread, the final bone transforms go straight to
+                the given palette. When several clips have
+                a weight their local poses are blended by the
+                normalized weights, scale and translation by lerp and
+                rotation by nlerp. Every layer samples with its own run
+                of key cursors, so nothing is allocated per frame. The
+                global inverse transform is applied once at the root,
+                so every global transform already includes it and a
+                bone only needs its offset matrix
+
+      Args:     FLOAT timeOffset
+                  Seconds after the current time of the clips to pose
+                std::vector<XMMATRIX>& aOutTransforms
+                  Bone palette receiving the pose
+
+      Modifies: [m_aKeyCursors].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::updateSkeleton(_In_ FLOAT timeOffset, _Out_ std::vector<XMMATRIX>& aOutTransforms)
+    {
+        struct BlendLayer
+        {
+            const AnimationClip* pClip;
+            UINT uClipIndex;
+            FLOAT animationTimeTicks;
+            FLOAT weight;
+            size_t uFirstCursor;
+        };
+
+        static thread_local std::vector<XMMATRIX> aGlobalTransforms;
+
+        const SkinnedMeshAsset& asset = *m_asset;
+        const size_t uNumClips = asset.aAnimationClips.size();
+        const size_t uNumNodes = asset.aSkeletonNodes.size();
+
+        BlendLayer aBlendLayers[MAX_ANIMATION_LAYERS];
+        UINT uNumBlendLayers = 0u;
+        FLOAT totalWeight = 0.0f;
+        for (UINT uLayer = 0u; uLayer < m_uNumAnimationLayers; ++uLayer)
+        {
+            const AnimationLayer& layer = m_aAnimationLayers[uLayer];
+            if (layer.weight <= 0.0f)
+            {
+                continue;
+            }
+
+            const AnimationClip* pClip = asset.aAnimationClips[layer.uClipIndex].get();
+            aBlendLayers[uNumBlendLayers++] =
+            {
+                .pClip = pClip,
+                .uClipIndex = layer.uClipIndex,
+                .animationTimeTicks = fmod((layer.time + timeOffset) * pClip->GetTicksPerSecond(), pClip->GetDuration()),
+                .weight = layer.weight,
+                .uFirstCursor = uLayer * uNumNodes
+            };
+            totalWeight += layer.weight;
+        }
+
+        for (UINT uBlendLayer = 0u; uBlendLayer < uNumBlendLayers; ++uBlendLayer)
+        {
+            aBlendLayers[uBlendLayer].weight /= totalWeight;
+        }
+
+        aGlobalTransforms.resize(uNumNodes);
+        for (size_t i = 0u; i < uNumNodes; ++i)
+        {
+            const SkeletonNode& node = asset.aSkeletonNodes[i];
+
+            XMMATRIX nodeTransformation = node.Transformation;
+            if (uNumBlendLayers == 1u)
+            {
+                const BlendLayer& blendLayer = aBlendLayers[0];
+                UINT uChannel = asset.aChannels[i * uNumClips + blendLayer.uClipIndex];
+                if (uChannel != AnimationClip::INVALID_CHANNEL)
+                {
+                    XMFLOAT3 scalingFloat3 = XMFLOAT3();
+                    XMVECTOR rotationVector = XMVECTOR();
+                    XMFLOAT3 positionFloat3 = XMFLOAT3();
+
+                    blendLayer.pClip->SampleChannel(uChannel, blendLayer.animationTimeTicks, m_aKeyCursors[blendLayer.uFirstCursor + i], scalingFloat3, rotationVector, positionFloat3);
+
+                    nodeTransformation = ComposeTransformation(XMLoadFloat3(&scalingFloat3), rotationVector, XMLoadFloat3(&positionFloat3));
+                }
+            }
+            else if (uNumBlendLayers > 1u)
+            {
+                BOOL bAnimated = FALSE;
+                for (UINT uBlendLayer = 0u; uBlendLayer < uNumBlendLayers && !bAnimated; ++uBlendLayer)
+                {
+                    bAnimated = asset.aChannels[i * uNumClips + aBlendLayers[uBlendLayer].uClipIndex] != AnimationClip::INVALID_CHANNEL;
+                }
+
+                if (bAnimated)
+                {
+                    XMVECTOR scaling = XMVectorZero();
+                    XMVECTOR rotation = XMVectorZero();
+                    XMVECTOR translation = XMVectorZero();
+                    XMVECTOR firstRotation = XMVectorZero();
+                    for (UINT uBlendLayer = 0u; uBlendLayer < uNumBlendLayers; ++uBlendLayer)
+                    {
+                        const BlendLayer& blendLayer = aBlendLayers[uBlendLayer];
+                        UINT uChannel = asset.aChannels[i * uNumClips + blendLayer.uClipIndex];
+
+                        XMVECTOR layerScaling, layerRotation, layerTranslation;
+                        sampleLocalPose(*blendLayer.pClip, uChannel, node, blendLayer.animationTimeTicks, m_aKeyCursors[blendLayer.uFirstCursor + i], layerScaling, layerRotation, layerTranslation);
+
+                        // Blend every rotation along the shorter arc from the first one
+                        if (uBlendLayer == 0u)
+                        {
+                            firstRotation = layerRotation;
+                        }
+                        else if (XMVectorGetX(XMQuaternionDot(firstRotation, layerRotation)) < 0.0f)
+                        {
+                            layerRotation = XMVectorNegate(layerRotation);
+                        }
+
+                        XMVECTOR weight = XMVectorReplicate(blendLayer.weight);
+                        scaling = XMVectorMultiplyAdd(layerScaling, weight, scaling);
+                        rotation = XMVectorMultiplyAdd(layerRotation, weight, rotation);
+                        translation = XMVectorMultiplyAdd(layerTranslation, weight, translation);
+                    }
+
+                    nodeTransformation = ComposeTransformation(scaling, XMQuaternionNormalize(rotation), translation);
+                }
+            }
+
+            aGlobalTransforms[i] = nodeTransformation * (node.uParentIndex == INVALID_INDEX ? asset.GlobalInverseTransform : aGlobalTransforms[node.uParentIndex]);
+
+            if (node.uBoneIndex != INVALID_INDEX)
+            {
+                aOutTransforms[node.uBoneIndex] = asset.aBoneOffsets[node.uBoneIndex] * aGlobalTransforms[i];
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::sampleLocalPose
+
+      Summary:  Samples the local scaling, rotation and translation of
+                a node in a clip. Nodes the clip does not animate keep
+                their bind transformation
+
+      Args:     const AnimationClip& animationClip
+                  Clip to sample
+                UINT uChannel
+                  Channel of the node in the clip, may be
+                  AnimationClip::INVALID_CHANNEL
+                const SkeletonNode& node
+                  Node to sample
+                FLOAT animationTimeTicks
+                  Animation time
+                AnimationClip::KeyCursor& cursor
+                  Keys found by the previous sample of the channel
+                XMVECTOR& outScaling
+                  Scaling vector
+                XMVECTOR& outRotation
+                  Rotation quaternion
+                XMVECTOR& outTranslation
+                  Translation vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Model::sampleLocalPose(
+        _In_ const AnimationClip& animationClip,
+        _In_ UINT uChannel,
+        _In_ const SkeletonNode& node,
+        _In_ FLOAT animationTimeTicks,
+        _Inout_ AnimationClip::KeyCursor& cursor,
+        _Out_ XMVECTOR& outScaling,
+        _Out_ XMVECTOR& outRotation,
+        _Out_ XMVECTOR& outTranslation
+    )
+    {
+        if (uChannel == AnimationClip::INVALID_CHANNEL)
+        {
+            XMMatrixDecompose(&outScaling, &outRotation, &outTranslation, node.Transformation);
+            return;
+        }
+
+        XMFLOAT3 scalingFloat3 = XMFLOAT3();
+        XMFLOAT3 positionFloat3 = XMFLOAT3();
+        animationClip.SampleChannel(uChannel, animationTimeTicks, cursor, scalingFloat3, outRotation, positionFloat3);
+
+        outScaling = XMLoadFloat3(&scalingFloat3);
+        outTranslation = XMLoadFloat3(&positionFloat3);
+    }
 }
\ No newline at end of file
@@ -12,6 +12,10 @@
 #pragma once
 
 #include "Common.h"
+
+#include <atomic>
+
+#include "Model/SkinnedMeshAsset.h"
 #include "Renderer/DataTypes.h"
 #include "Renderer/Renderable.h"
 #include "Shader/PixelShader.h"
@@ -21,10 +25,8 @@
 struct aiScene;
 struct aiMesh;
 struct aiMaterial;
-struct aiAnimation;
 struct aiBone;
 struct aiNode;
-struct aiNodeAnim;
 
 namespace Assimp
 {
@@ -36,13 +38,46 @@ namespace library
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Model
 
-      Summary:  Model class is a renderable from model files
+      Summary:  Model class is a renderable from model files. Models
+                loaded from the same file share one SkinnedMeshAsset
+                and only own their playback state and bone palette.
+                Up to MAX_ANIMATION_LAYERS clips play at once, each
+                with its own time and weight, and the skeleton is posed
+                from their normalized weighted blend
 
       Methods:  Initialize
                   Pure virtual function that initializes the object
                 Update
                   Pure virtual function that updates the object each
                   frame
+                Advance
+                  Advances the animation time without posing
+                PoseSkeleton
+                  Poses the skeleton at the current animation time,
+                  or one update interval ahead to interpolate the
+                  frames until the next pose
+                GetFramesSincePose
+                  Returns the frames since the last pose
+                GetNumSkeletonNodes
+                  Returns the number of skeleton nodes
+                SetAnimationClip
+                  Plays another clip of the model from its start
+                CrossfadeToAnimationClip
+                  Fades from the current clips into another one
+                BlendAnimationClip
+                  Fades the weight of a clip to a target
+                GetAnimationClipWeight
+                  Returns the blend weight of a clip
+                GetNumAnimationClips
+                  Returns the number of animation clips
+                ComposeTransformation
+                  Builds a scaling, rotation and translation matrix
+                GetQuantizeRotations
+                  Returns whether imported rotations are quantized
+                SetQuantizeRotations
+                  Changes whether imported rotations are quantized
+                GetNumSharedAssets
+                  Returns the number of shared assets
                 GetVertexBuffer
                   Returns the vertex buffer
                 GetIndexBuffer
@@ -64,6 +99,9 @@ namespace library
     C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
     class Model : public Renderable
     {
+    public:
+        static constexpr const UINT MAX_ANIMATION_LAYERS = 4u;
+
     public:
         Model() = delete;
         Model(_In_ const std::filesystem::path& filePath);
@@ -75,6 +113,10 @@ namespace library
 
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
         virtual void Update(_In_ FLOAT deltaTime) override;
+        void Advance(_In_ FLOAT deltaTime);
+        void PoseSkeleton(_In_opt_ UINT uUpdateInterval = 1u);
+        UINT GetFramesSincePose() const;
+        UINT GetNumSkeletonNodes() const;
 
         ComPtr<ID3D11Buffer>& GetAnimationBuffer();
         ComPtr<ID3D11Buffer>& GetSkinningConstantBuffer();
@@ -85,7 +127,20 @@ namespace library
         std::vector<XMMATRIX>& GetBoneTransforms();
         const std::unordered_map<std::string, UINT>& GetBoneNameToIndexMap() const;
 
+        HRESULT SetAnimationClip(_In_ UINT uClipIndex);
+        HRESULT CrossfadeToAnimationClip(_In_ UINT uClipIndex, _In_ FLOAT fadeDuration);
+        HRESULT BlendAnimationClip(_In_ UINT uClipIndex, _In_ FLOAT weight, _In_ FLOAT fadeDuration);
+        FLOAT GetAnimationClipWeight(_In_ UINT uClipIndex) const;
+        UINT GetNumAnimationClips() const;
+
+        static XMMATRIX ComposeTransformation(_In_ FXMVECTOR scaling, _In_ FXMVECTOR rotation, _In_ FXMVECTOR translation);
+        static BOOL GetQuantizeRotations();
+        static void SetQuantizeRotations(_In_ BOOL bQuantizeRotations);
+        static size_t GetNumSharedAssets();
+
     protected:
+        static constexpr const UINT INVALID_INDEX = (0xFFFFFFFF);
+
         struct VertexBoneData
         {
             VertexBoneData()
@@ -104,10 +159,6 @@ namespace library
                 aBoneIds[uNumBones] = uBoneId;
                 aWeights[uNumBones] = weight;
 
-                static CHAR szDebugMessage[256];
-                sprintf_s(szDebugMessage, "\t\t\tBone %d, weight: %f, index %u\n", uBoneId, weight, uNumBones);
-                OutputDebugStringA(szDebugMessage);
-
                 ++uNumBones;
             }
 
@@ -116,28 +167,26 @@ namespace library
             UINT uNumBones;
         };
 
-        struct BoneInfo
+        // A playing clip. The weight moves toward the target by weightSpeed per second
+        struct AnimationLayer
         {
-            BoneInfo() = default;
-            BoneInfo(const XMMATRIX& Offset)
-                : OffsetMatrix(Offset)
-                , FinalTransformation()
-            {
-            }
-
-            XMMATRIX OffsetMatrix;
-            XMMATRIX FinalTransformation;
+            UINT uClipIndex;
+            FLOAT time;
+            FLOAT weight;
+            FLOAT targetWeight;
+            FLOAT weightSpeed;
         };
 
+        UINT addAnimationLayer(_In_ UINT uClipIndex);
+        void bindSkeleton(_In_ const aiNode* pNode, _In_ UINT uParentIndex);
         void countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene);
-        const aiNodeAnim* findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName);
-        UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
+        UINT findAnimationLayer(_In_ UINT uClipIndex) const;
         UINT getBoneId(_In_ const aiBone* pBone);
         const virtual SimpleVertex* getVertices() const override;
         virtual const WORD* getIndices() const override;
+        void initAllBones(_In_ const aiScene* pScene);
         void initAllMeshes(_In_ const aiScene* pScene);
+        HRESULT initFromAsset(_In_ ID3D11Device* pDevice);
         HRESULT initFromScene(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -152,10 +201,11 @@ namespace library
         );
         void initMeshBones(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
         void initMeshSingleBone(_In_ UINT uBoneIndex, _In_ const aiBone* pBone);
+        void initPlayback();
         virtual void initSingleMesh(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
-        void interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
+        void interpolatePose();
+        virtual BOOL isAssetShared() const;
+        virtual HRESULT loadAsset(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
         HRESULT loadDiffuseTexture(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -184,31 +234,45 @@ namespace library
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
-        void readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform);
+        void removeAnimationLayer(_In_ UINT uLayer);
         void reserveSpace(_In_ UINT uNumVertices, _In_ UINT uNumIndices);
+        static void sampleLocalPose(
+            _In_ const AnimationClip& animationClip,
+            _In_ UINT uChannel,
+            _In_ const SkeletonNode& node,
+            _In_ FLOAT animationTimeTicks,
+            _Inout_ AnimationClip::KeyCursor& cursor,
+            _Out_ XMVECTOR& outScaling,
+            _Out_ XMVECTOR& outRotation,
+            _Out_ XMVECTOR& outTranslation
+        );
+        void setLayerWeight(_Inout_ AnimationLayer& layer, _In_ FLOAT weight, _In_ FLOAT fadeDuration);
+        void updateSkeleton(_In_ FLOAT timeOffset, _Out_ std::vector<XMMATRIX>& aOutTransforms);
 
     protected:
         static std::unique_ptr<Assimp::Importer> sm_pImporter;
+        static std::unordered_multimap<std::wstring, std::weak_ptr<SkinnedMeshAsset>> sm_assets;
+        static std::atomic<BOOL> sm_bQuantizeRotations;
 
     protected:
         std::filesystem::path m_filePath;
+        std::shared_ptr<SkinnedMeshAsset> m_asset;
 
         ComPtr<ID3D11Buffer> m_animationBuffer;
         ComPtr<ID3D11Buffer> m_skinningConstantBuffer;
 
-        std::vector<SimpleVertex> m_aVertices;
         std::vector<AnimationData> m_aAnimationData;
-        std::vector<WORD> m_aIndices;
         std::vector<VertexBoneData> m_aBoneData;
-        std::vector<BoneInfo> m_aBoneInfo;
         std::vector<XMMATRIX> m_aTransforms;
-        std::unordered_map<std::string, UINT> m_boneNameToIndexMap;
-
-        const aiScene* m_pScene;
-
-        float m_timeSinceLoaded;
+        std::vector<XMMATRIX> m_aPreviousTransforms;
+        std::vector<XMMATRIX> m_aPoseTransforms;
+        std::vector<AnimationClip::KeyCursor> m_aKeyCursors;
 
-        XMMATRIX m_globalInverseTransform;
+        AnimationLayer m_aAnimationLayers[MAX_ANIMATION_LAYERS];
+        UINT m_uNumAnimationLayers;
+        UINT m_uFramesSincePose;
+        UINT m_uUpdateInterval;
+        FLOAT m_lastDeltaTime;
 
         //BYTE m_padding[8];
     };
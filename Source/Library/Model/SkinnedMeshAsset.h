@@ -0,0 +1,69 @@
+/*+===================================================================
+  File:      SKINNEDMESHASSET.H
+
+  Summary:   SkinnedMeshAsset header file contains declarations of the
+             immutable data a model file shares between every model
+             instance loaded from it, used for the lab samples of Game
+             Graphics Programming course.
+
+  Structs: SkeletonNode, SkinnedMeshAsset
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/AnimationClip.h"
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+#include "Texture/Material.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SkeletonNode
+
+      Summary:  Node of a skeleton flattened in depth first order, so
+                every parent precedes its children. Indices are
+                Model::INVALID_INDEX for the root and for nodes without
+                a bone
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SkeletonNode
+    {
+        XMMATRIX Transformation;
+        UINT uParentIndex;
+        UINT uBoneIndex;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SkinnedMeshAsset
+
+      Summary:  Everything a model file contributes that is the same for
+                every instance: mesh data and buffers, materials, bone
+                offsets, the flattened skeleton and the animation clips.
+                aChannels holds the channel of every skeleton node for
+                each clip, one run of aAnimationClips.size() entries per
+                node. Assets are shared per device, pDevice created
+                the buffers. The asset is not modified once it is shared
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SkinnedMeshAsset
+    {
+        std::vector<SimpleVertex> aVertices;
+        std::vector<WORD> aIndices;
+        std::vector<Renderable::BasicMeshEntry> aMeshes;
+        std::vector<std::shared_ptr<Material>> aMaterials;
+        std::vector<XMMATRIX> aBoneOffsets;
+        std::unordered_map<std::string, UINT> boneNameToIndexMap;
+        std::vector<SkeletonNode> aSkeletonNodes;
+        std::vector<std::unique_ptr<AnimationClip>> aAnimationClips;
+        std::vector<UINT> aChannels;
+        XMMATRIX GlobalInverseTransform;
+        ComPtr<ID3D11Buffer> VertexBuffer;
+        ComPtr<ID3D11Buffer> NormalBuffer;
+        ComPtr<ID3D11Buffer> IndexBuffer;
+        ComPtr<ID3D11Buffer> AnimationBuffer;
+        ID3D11Device* pDevice;
+        BOOL bHasNormalMap;
+    };
+}
@@ -0,0 +1,400 @@
+#include "Renderer/D3D11RenderCommandList.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::D3D11RenderCommandList
+
+      Summary:  Constructor
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device deferred contexts are created on
+                ID3D11DeviceContext* pContext
+                  The Direct3D context commands are submitted to
+                IDXGISwapChain* pSwapChain
+                  The swap chain frames are presented through, null
+                  for a deferred context
+
+      Modifies: [m_device, m_context, m_swapChain, m_commandList].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11RenderCommandList::D3D11RenderCommandList(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pContext, _In_opt_ IDXGISwapChain* pSwapChain)
+        : m_device(pDevice)
+        , m_context(pContext)
+        , m_swapChain(pSwapChain)
+        , m_commandList()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::ClearRenderTargetView
+
+      Summary:  Clears a render target
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target to clear
+                const FLOAT aColorRGBA[4]
+                  Clear color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_context->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::ClearDepthStencilView
+
+      Summary:  Clears a depth stencil
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil to clear
+                UINT uClearFlags
+                  D3D11_CLEAR_FLAG of the planes to clear
+                FLOAT depth
+                  Clear depth
+                UINT8 uStencil
+                  Clear stencil
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil)
+    {
+        m_context->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, uStencil);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::OMSetRenderTargets
+
+      Summary:  Binds render targets
+
+      Args:     UINT uNumViews
+                  Number of render targets
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                  Render targets
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::OMSetRenderTargets(_In_ UINT uNumViews, _In_opt_ ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_context->OMSetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::RSSetViewports
+
+      Summary:  Sets the viewports
+
+      Args:     UINT uNumViewports
+                  Number of viewports
+                const D3D11_VIEWPORT* pViewports
+                  Viewports
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::RSSetViewports(_In_ UINT uNumViewports, _In_ const D3D11_VIEWPORT* pViewports)
+    {
+        m_context->RSSetViewports(uNumViewports, pViewports);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::IASetPrimitiveTopology
+
+      Summary:  Sets the topology
+
+      Args:     UINT uTopology
+                  D3D11_PRIMITIVE_TOPOLOGY of the primitives
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::IASetPrimitiveTopology(_In_ UINT uTopology)
+    {
+        m_context->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(uTopology));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::IASetVertexBuffers
+
+      Summary:  Binds vertex buffers
+
+      Args:     UINT uStartSlot
+                  First input slot
+                UINT uNumBuffers
+                  Number of vertex buffers
+                ID3D11Buffer* const* ppVertexBuffers
+                  Vertex buffers
+                const UINT* puStrides
+                  Stride of each vertex buffer
+                const UINT* puOffsets
+                  Offset of each vertex buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppVertexBuffers, _In_ const UINT* puStrides, _In_ const UINT* puOffsets)
+    {
+        m_context->IASetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, puStrides, puOffsets);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::IASetInputLayout
+
+      Summary:  Binds an input layout
+
+      Args:     ID3D11InputLayout* pInputLayout
+                  Input layout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        m_context->IASetInputLayout(pInputLayout);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::IASetIndexBuffer
+
+      Summary:  Binds an index buffer
+
+      Args:     ID3D11Buffer* pIndexBuffer
+                  Index buffer
+                UINT uFormat
+                  DXGI_FORMAT of the indices
+                UINT uOffset
+                  Offset of the first index in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ UINT uFormat, _In_ UINT uOffset)
+    {
+        m_context->IASetIndexBuffer(pIndexBuffer, static_cast<DXGI_FORMAT>(uFormat), uOffset);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::UpdateSubresource
+
+      Summary:  Uploads to a resource
+
+      Args:     ID3D11Resource* pDstResource
+                  Destination resource
+                UINT uDstSubresource
+                  Destination subresource
+                const D3D11_BOX* pDstBox
+                  Destination region, or the whole subresource
+                const void* pSrcData
+                  Source data
+                UINT uSrcRowPitch
+                  Size of a source row
+                UINT uSrcDepthPitch
+                  Size of a source depth slice
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch)
+    {
+        m_context->UpdateSubresource(pDstResource, uDstSubresource, pDstBox, pSrcData, uSrcRowPitch, uSrcDepthPitch);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::VSSetConstantBuffers
+
+      Summary:  Binds vertex shader constant buffers
+
+      Args:     UINT uStartSlot
+                  First constant buffer slot
+                UINT uNumBuffers
+                  Number of constant buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_context->VSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::PSSetConstantBuffers
+
+      Summary:  Binds pixel shader constant buffers
+
+      Args:     UINT uStartSlot
+                  First constant buffer slot
+                UINT uNumBuffers
+                  Number of constant buffers
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_context->PSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::VSSetShader
+
+      Summary:  Binds a vertex shader
+
+      Args:     ID3D11VertexShader* pVertexShader
+                  Vertex shader
+                ID3D11ClassInstance* const* ppClassInstances
+                  Class instances of the shader interfaces
+                UINT uNumClassInstances
+                  Number of class instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances)
+    {
+        m_context->VSSetShader(pVertexShader, ppClassInstances, uNumClassInstances);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::PSSetShader
+
+      Summary:  Binds a pixel shader
+
+      Args:     ID3D11PixelShader* pPixelShader
+                  Pixel shader
+                ID3D11ClassInstance* const* ppClassInstances
+                  Class instances of the shader interfaces
+                UINT uNumClassInstances
+                  Number of class instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances)
+    {
+        m_context->PSSetShader(pPixelShader, ppClassInstances, uNumClassInstances);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::PSSetShaderResources
+
+      Summary:  Binds pixel shader resources
+
+      Args:     UINT uStartSlot
+                  First resource slot
+                UINT uNumViews
+                  Number of resources
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+                  Shader resources
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_ ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_context->PSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::PSSetSamplers
+
+      Summary:  Binds pixel shader samplers
+
+      Args:     UINT uStartSlot
+                  First sampler slot
+                UINT uNumSamplers
+                  Number of samplers
+                ID3D11SamplerState* const* ppSamplers
+                  Samplers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_ ID3D11SamplerState* const* ppSamplers)
+    {
+        m_context->PSSetSamplers(uStartSlot, uNumSamplers, ppSamplers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::DrawIndexed
+
+      Summary:  Draws indexed primitives
+
+      Args:     UINT uIndexCount
+                  Number of indices
+                UINT uStartIndexLocation
+                  First index
+                INT baseVertexLocation
+                  Value added to each index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation)
+    {
+        m_context->DrawIndexed(uIndexCount, uStartIndexLocation, baseVertexLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::DrawIndexedInstanced
+
+      Summary:  Draws instanced indexed primitives
+
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices of an instance
+                UINT uInstanceCount
+                  Number of instances
+                UINT uStartIndexLocation
+                  First index
+                INT baseVertexLocation
+                  Value added to each index
+                UINT uStartInstanceLocation
+                  Value added to each instance index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        m_context->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, baseVertexLocation, uStartInstanceLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::Present
+
+      Summary:  Presents the frame
+
+      Args:     UINT uSyncInterval
+                  Vertical blanks to wait for
+                UINT uFlags
+                  DXGI_PRESENT flags
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderCommandList::Present(_In_ UINT uSyncInterval, _In_ UINT uFlags)
+    {
+        return m_swapChain->Present(uSyncInterval, uFlags);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::CreateDeferredCommandList
+
+      Summary:  Creates a list on a new deferred context of the device
+
+      Args:     std::shared_ptr<RenderCommandList>& outCommandList
+                  The created list
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderCommandList::CreateDeferredCommandList(_Out_ std::shared_ptr<RenderCommandList>& outCommandList)
+    {
+        ComPtr<ID3D11DeviceContext> deferredContext;
+        HRESULT hr = m_device->CreateDeferredContext(0u, deferredContext.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        outCommandList = std::make_shared<D3D11RenderCommandList>(m_device.Get(), deferredContext.Get(), nullptr);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::Finish
+
+      Summary:  Closes the commands recorded on the deferred context
+                into a command list. The context state is reset, so
+                the next recording binds everything again
+
+      Modifies: [m_commandList].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderCommandList::Finish()
+    {
+        return m_context->FinishCommandList(FALSE, m_commandList.ReleaseAndGetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderCommandList::Execute
+
+      Summary:  Plays a finished deferred list on this context. The
+                context is left in the default state
+
+      Args:     RenderCommandList& deferredCommandList
+                  A list created by CreateDeferredCommandList of this
+                  backend and closed by Finish
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderCommandList::Execute(_In_ RenderCommandList& deferredCommandList)
+    {
+        D3D11RenderCommandList& d3d11CommandList = static_cast<D3D11RenderCommandList&>(deferredCommandList);
+        if (d3d11CommandList.m_commandList)
+        {
+            m_context->ExecuteCommandList(d3d11CommandList.m_commandList.Get(), FALSE);
+            d3d11CommandList.m_commandList.Reset();
+        }
+    }
+}
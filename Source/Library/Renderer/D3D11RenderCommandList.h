@@ -0,0 +1,120 @@
+/*+===================================================================
+  File:      D3D11RENDERCOMMANDLIST.H
+
+  Summary:   D3D11RenderCommandList header file contains declarations
+             of the backend that submits to a Direct3D 11 device
+             context, used for the lab samples of Game Graphics
+             Programming course.
+
+  Classes: D3D11RenderCommandList
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderCommandList.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    D3D11RenderCommandList
+
+      Summary:  Forwards every command to a device context. The list
+                Renderer creates wraps the immediate context and
+                presents through the swap chain, the lists it creates
+                wrap deferred contexts
+
+      Methods:  ClearRenderTargetView
+                  Clears a render target
+                ClearDepthStencilView
+                  Clears a depth stencil
+                OMSetRenderTargets
+                  Binds render targets
+                RSSetViewports
+                  Sets the viewports
+                IASetPrimitiveTopology
+                  Sets the topology
+                IASetVertexBuffers
+                  Binds vertex buffers
+                IASetInputLayout
+                  Binds an input layout
+                IASetIndexBuffer
+                  Binds an index buffer
+                UpdateSubresource
+                  Uploads to a resource
+                VSSetConstantBuffers
+                  Binds vertex shader constant buffers
+                PSSetConstantBuffers
+                  Binds pixel shader constant buffers
+                VSSetShader
+                  Binds a vertex shader
+                PSSetShader
+                  Binds a pixel shader
+                PSSetShaderResources
+                  Binds pixel shader resources
+                PSSetSamplers
+                  Binds pixel shader samplers
+                DrawIndexed
+                  Draws indexed primitives
+                DrawIndexedInstanced
+                  Draws instanced indexed primitives
+                Present
+                  Presents the frame
+                CreateDeferredCommandList
+                  Creates a list on a deferred context
+                Finish
+                  Closes the commands of a deferred context
+                Execute
+                  Plays a finished deferred list
+                D3D11RenderCommandList
+                  Constructor.
+                ~D3D11RenderCommandList
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class D3D11RenderCommandList final : public RenderCommandList
+    {
+    public:
+        D3D11RenderCommandList(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pContext, _In_opt_ IDXGISwapChain* pSwapChain);
+        D3D11RenderCommandList(const D3D11RenderCommandList& other) = delete;
+        D3D11RenderCommandList(D3D11RenderCommandList&& other) = delete;
+        D3D11RenderCommandList& operator=(const D3D11RenderCommandList& other) = delete;
+        D3D11RenderCommandList& operator=(D3D11RenderCommandList&& other) = delete;
+        ~D3D11RenderCommandList() = default;
+
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil) override;
+        void OMSetRenderTargets(_In_ UINT uNumViews, _In_opt_ ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void RSSetViewports(_In_ UINT uNumViewports, _In_ const D3D11_VIEWPORT* pViewports) override;
+        void IASetPrimitiveTopology(_In_ UINT uTopology) override;
+
+        void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppVertexBuffers, _In_ const UINT* puStrides, _In_ const UINT* puOffsets) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ UINT uFormat, _In_ UINT uOffset) override;
+
+        void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch) override;
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers) override;
+
+        void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances) override;
+        void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances) override;
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_ ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_ ID3D11SamplerState* const* ppSamplers) override;
+
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+        HRESULT Present(_In_ UINT uSyncInterval, _In_ UINT uFlags) override;
+
+        HRESULT CreateDeferredCommandList(_Out_ std::shared_ptr<RenderCommandList>& outCommandList) override;
+        HRESULT Finish() override;
+        void Execute(_In_ RenderCommandList& deferredCommandList) override;
+
+    private:
+        ComPtr<ID3D11Device> m_device;
+        ComPtr<ID3D11DeviceContext> m_context;
+        ComPtr<IDXGISwapChain> m_swapChain;
+        ComPtr<ID3D11CommandList> m_commandList;
+    };
+}
@@ -32,6 +32,44 @@ namespace library
         XMMATRIX Transformation;
     };
 
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PackedInstanceData
+
+      Summary:  Instance data of a grid-aligned voxel containing its
+                integer grid coordinate and block type. 8 bytes per
+                instance instead of the 64 bytes of InstanceData
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PackedInstanceData
+    {
+        INT16 X;
+        INT16 Y;
+        INT16 Z;
+        INT16 BlockType;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   BatchInstanceData
+
+      Summary:  Instance data of a renderable drawn in an instanced
+                batch, holding what its constant buffer would
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BatchInstanceData
+    {
+        XMMATRIX World;
+        XMFLOAT4 OutputColor;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   InstanceRange
+
+      Summary:  Contiguous range of instances in an instance array
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct InstanceRange
+    {
+        UINT uOffset;
+        UINT uCount;
+    };
+
     struct AnimationData
     {
         XMUINT4 aBoneIndices;
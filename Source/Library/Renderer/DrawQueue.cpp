@@ -0,0 +1,458 @@
+#include "Renderer/DrawQueue.h"
+
+#include <cstring>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::DrawQueue
+
+      Summary:  Constructor
+
+      Modifies: [m_aPackets, m_aEntries, m_aScratch, m_aChunks,
+                  m_vertexShaderIds, m_pixelShaderIds, m_materialIds,
+                  m_vertexBufferIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DrawQueue::DrawQueue()
+        : m_aPackets()
+        , m_aEntries()
+        , m_aScratch()
+        , m_aChunks()
+        , m_vertexShaderIds()
+        , m_pixelShaderIds()
+        , m_materialIds()
+        , m_vertexBufferIds()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::Clear
+
+      Summary:  Removes the packets and state ids of the last frame,
+                keeping the storage for the next one. Buffers freed
+                since then may come back at the same address, so ids
+                are never carried over
+
+      Modifies: [m_aPackets, m_aEntries, m_vertexShaderIds,
+                  m_pixelShaderIds, m_materialIds, m_vertexBufferIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawQueue::Clear()
+    {
+        m_aPackets.clear();
+        m_aEntries.clear();
+        m_vertexShaderIds.clear();
+        m_pixelShaderIds.clear();
+        m_materialIds.clear();
+        m_vertexBufferIds.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::Add
+
+      Summary:  Adds a packet to the frame
+
+      Args:     eDrawPass pass
+                  Pass the packet is drawn in
+                const DrawPacket& packet
+                  Bindings and draw arguments
+                FLOAT depth
+                  Normalized depth of the object, 0 at the near plane
+                  and 1 at the far plane
+
+      Modifies: [m_aPackets].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawQueue::Add(_In_ eDrawPass pass, _In_ const DrawPacket& packet, _In_ FLOAT depth)
+    {
+        m_aPackets.push_back(
+            QueuedPacket
+            {
+                .packet = packet,
+                .pass = pass,
+                .depth = depth
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::GetNumPackets
+
+      Summary:  Returns the number of packets of the frame
+
+      Returns:  UINT
+                  Number of packets
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT DrawQueue::GetNumPackets() const
+    {
+        return static_cast<UINT>(m_aPackets.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::Sort
+
+      Summary:  Builds the key of every packet and orders the packets
+                by key with a least significant digit radix sort of
+                eight 8-bit digits. Digits every key shares, like the
+                unused high bits of the pass, are skipped. Packets with
+                equal keys keep their order
+
+      Modifies: [m_aEntries, m_aScratch, m_vertexShaderIds,
+                  m_pixelShaderIds, m_materialIds, m_vertexBufferIds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawQueue::Sort()
+    {
+        m_aEntries.resize(m_aPackets.size());
+        for (UINT i = 0u; i < m_aPackets.size(); ++i)
+        {
+            m_aEntries[i] =
+            {
+                .uKey = makeSortKey(m_aPackets[i].pass, m_aPackets[i].packet, m_aPackets[i].depth),
+                .uPacket = i
+            };
+        }
+
+        if (m_aEntries.size() < 2u)
+        {
+            return;
+        }
+
+        m_aScratch.resize(m_aEntries.size());
+        for (UINT uShift = 0u; uShift < 64u; uShift += 8u)
+        {
+            UINT aCounts[256] = { 0u };
+            for (const SortEntry& entry : m_aEntries)
+            {
+                ++aCounts[(entry.uKey >> uShift) & 0xffu];
+            }
+
+            if (aCounts[(m_aEntries[0].uKey >> uShift) & 0xffu] == m_aEntries.size())
+            {
+                continue;
+            }
+
+            UINT uOffset = 0u;
+            for (UINT& uCount : aCounts)
+            {
+                UINT uDigitCount = uCount;
+                uCount = uOffset;
+                uOffset += uDigitCount;
+            }
+
+            for (const SortEntry& entry : m_aEntries)
+            {
+                m_aScratch[aCounts[(entry.uKey >> uShift) & 0xffu]++] = entry;
+            }
+            m_aEntries.swap(m_aScratch);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::Split
+
+      Summary:  Divides the sorted packets into contiguous chunks of
+                nearly equal size, with at least MIN_PACKETS_PER_CHUNK
+                packets each when there is more than one chunk
+
+      Args:     UINT uMaxChunks
+                  Largest number of chunks wanted
+
+      Modifies: [m_aChunks].
+
+      Returns:  UINT
+                  Number of chunks, at least 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT DrawQueue::Split(_In_ UINT uMaxChunks)
+    {
+        UINT uNumPackets = static_cast<UINT>(m_aEntries.size());
+        UINT uNumChunks = uNumPackets / MIN_PACKETS_PER_CHUNK;
+        if (uNumChunks > uMaxChunks)
+        {
+            uNumChunks = uMaxChunks;
+        }
+        if (uNumChunks == 0u)
+        {
+            uNumChunks = 1u;
+        }
+
+        m_aChunks.resize(uNumChunks);
+        UINT uPacketsPerChunk = (uNumPackets + uNumChunks - 1u) / uNumChunks;
+        for (UINT i = 0u; i < uNumChunks; ++i)
+        {
+            UINT uBegin = i * uPacketsPerChunk;
+            UINT uEnd = uBegin + uPacketsPerChunk;
+            if (uBegin > uNumPackets)
+            {
+                uBegin = uNumPackets;
+            }
+            if (uEnd > uNumPackets)
+            {
+                uEnd = uNumPackets;
+            }
+
+            m_aChunks[i] =
+            {
+                .uBegin = uBegin,
+                .uEnd = uEnd,
+                .stats = { .uNumPackets = uEnd - uBegin }
+            };
+        }
+
+        return uNumChunks;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::SubmitChunk
+
+      Summary:  Records the packets of a chunk in key order. A binding
+                is recorded only when it differs from the one the
+                previous packet of the chunk left, the first packet
+                binds every slot. A chunk therefore records the same
+                bindings on the immediate list as on a deferred one,
+                and different chunks may be recorded from different
+                threads. Submitting a chunk again restarts its counters
+
+      Args:     UINT uChunk
+                  Index of the chunk, below the count Split returned
+                RenderCommandList& commandList
+                  Backend the chunk is recorded into
+
+      Modifies: [m_aChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawQueue::SubmitChunk(_In_ UINT uChunk, _In_ RenderCommandList& commandList)
+    {
+        Chunk& chunk = m_aChunks[uChunk];
+        DrawQueueStats& stats = chunk.stats;
+        stats = { .uNumPackets = chunk.uEnd - chunk.uBegin };
+
+        const DrawPacket* pBound = nullptr;
+        for (UINT uEntry = chunk.uBegin; uEntry < chunk.uEnd; ++uEntry)
+        {
+            const DrawPacket& packet = m_aPackets[m_aEntries[uEntry].uPacket].packet;
+
+            if (!pBound
+                || pBound->uNumVertexBuffers != packet.uNumVertexBuffers
+                || memcmp(pBound->aVertexBuffers, packet.aVertexBuffers, sizeof(ID3D11Buffer*) * packet.uNumVertexBuffers) != 0
+                || memcmp(pBound->aStrides, packet.aStrides, sizeof(UINT) * packet.uNumVertexBuffers) != 0)
+            {
+                UINT aOffsets[MAX_DRAW_VERTEX_BUFFERS] = { 0u };
+                commandList.IASetVertexBuffers(0u, packet.uNumVertexBuffers, packet.aVertexBuffers, packet.aStrides, aOffsets);
+                ++stats.uNumStateChanges;
+            }
+            else
+            {
+                ++stats.uNumSkippedStateChanges;
+            }
+
+            if (!pBound || pBound->pInputLayout != packet.pInputLayout)
+            {
+                commandList.IASetInputLayout(packet.pInputLayout);
+                ++stats.uNumStateChanges;
+            }
+            else
+            {
+                ++stats.uNumSkippedStateChanges;
+            }
+
+            if (!pBound || pBound->pIndexBuffer != packet.pIndexBuffer)
+            {
+                commandList.IASetIndexBuffer(packet.pIndexBuffer, INDEX_FORMAT, 0u);
+                ++stats.uNumStateChanges;
+            }
+            else
+            {
+                ++stats.uNumSkippedStateChanges;
+            }
+
+            if (!pBound || pBound->pConstantBuffer != packet.pConstantBuffer)
+            {
+                commandList.VSSetConstantBuffers(2u, 1u, &packet.pConstantBuffer);
+                commandList.PSSetConstantBuffers(2u, 1u, &packet.pConstantBuffer);
+                stats.uNumStateChanges += 2u;
+            }
+            else
+            {
+                stats.uNumSkippedStateChanges += 2u;
+            }
+
+            if (!pBound || pBound->pVertexShader != packet.pVertexShader)
+            {
+                commandList.VSSetShader(packet.pVertexShader, nullptr, 0u);
+                ++stats.uNumStateChanges;
+            }
+            else
+            {
+                ++stats.uNumSkippedStateChanges;
+            }
+
+            if (!pBound || pBound->pPixelShader != packet.pPixelShader)
+            {
+                commandList.PSSetShader(packet.pPixelShader, nullptr, 0u);
+                ++stats.uNumStateChanges;
+            }
+            else
+            {
+                ++stats.uNumSkippedStateChanges;
+            }
+
+            for (UINT i = 0u; i < NUM_DRAW_SHADER_RESOURCES; ++i)
+            {
+                if (!pBound || pBound->aShaderResourceViews[i] != packet.aShaderResourceViews[i])
+                {
+                    commandList.PSSetShaderResources(i, 1u, &packet.aShaderResourceViews[i]);
+                    ++stats.uNumStateChanges;
+                }
+                else
+                {
+                    ++stats.uNumSkippedStateChanges;
+                }
+            }
+
+            for (UINT i = 0u; i < NUM_DRAW_SAMPLERS; ++i)
+            {
+                if (!pBound || pBound->aSamplers[i] != packet.aSamplers[i])
+                {
+                    commandList.PSSetSamplers(i, 1u, &packet.aSamplers[i]);
+                    ++stats.uNumStateChanges;
+                }
+                else
+                {
+                    ++stats.uNumSkippedStateChanges;
+                }
+            }
+
+            if (packet.bInstanced)
+            {
+                commandList.DrawIndexedInstanced(packet.uNumIndices, packet.uNumInstances, packet.uBaseIndex, packet.baseVertex, packet.uBaseInstance);
+            }
+            else
+            {
+                commandList.DrawIndexed(packet.uNumIndices, packet.uBaseIndex, packet.baseVertex);
+            }
+            ++stats.uNumDraws;
+
+            pBound = &packet;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::Submit
+
+      Summary:  Records every packet into one command list
+
+      Args:     RenderCommandList& commandList
+                  Backend the packets are recorded into
+
+      Modifies: [m_aChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DrawQueue::Submit(_In_ RenderCommandList& commandList)
+    {
+        Split(1u);
+        SubmitChunk(0u, commandList);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::GetStats
+
+      Summary:  Returns the counters of the last submitted frame
+
+      Returns:  DrawQueueStats
+                  Counters summed over the chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DrawQueueStats DrawQueue::GetStats() const
+    {
+        DrawQueueStats stats =
+        {
+            .uNumChunks = static_cast<UINT>(m_aChunks.size())
+        };
+        for (const Chunk& chunk : m_aChunks)
+        {
+            stats.uNumPackets += chunk.stats.uNumPackets;
+            stats.uNumDraws += chunk.stats.uNumDraws;
+            stats.uNumStateChanges += chunk.stats.uNumStateChanges;
+            stats.uNumSkippedStateChanges += chunk.stats.uNumSkippedStateChanges;
+        }
+
+        return stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::makeSortKey
+
+      Summary:  Builds the sort key of a packet. The material is the
+                first shader resource the packet binds
+
+      Args:     eDrawPass pass
+                  Pass the packet is drawn in
+                const DrawPacket& packet
+                  Bindings of the packet
+                FLOAT depth
+                  Normalized depth of the object
+
+      Returns:  UINT64
+                  Sort key
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 DrawQueue::makeSortKey(_In_ eDrawPass pass, _In_ const DrawPacket& packet, _In_ FLOAT depth)
+    {
+        UINT64 uShader = (static_cast<UINT64>(getStateId(m_vertexShaderIds, packet.pVertexShader, MAX_SHADER_ID)) << 6u) | getStateId(m_pixelShaderIds, packet.pPixelShader, MAX_SHADER_ID);
+
+        const void* pMaterial = nullptr;
+        for (ID3D11ShaderResourceView* pShaderResourceView : packet.aShaderResourceViews)
+        {
+            if (pShaderResourceView)
+            {
+                pMaterial = pShaderResourceView;
+                break;
+            }
+        }
+        UINT64 uMaterial = getStateId(m_materialIds, pMaterial, MAX_RESOURCE_ID);
+
+        UINT64 uVertexBuffer = getStateId(m_vertexBufferIds, packet.uNumVertexBuffers > 0u ? packet.aVertexBuffers[0] : nullptr, MAX_RESOURCE_ID);
+
+        if (depth < 0.0f)
+        {
+            depth = 0.0f;
+        }
+        else if (depth > 1.0f)
+        {
+            depth = 1.0f;
+        }
+        UINT64 uDepth = static_cast<UINT64>(depth * 65535.0f);
+
+        return (static_cast<UINT64>(pass) << 60u) | (uShader << 48u) | (uMaterial << 32u) | (uVertexBuffer << 16u) | uDepth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DrawQueue::getStateId
+
+      Summary:  Returns a small id of a state object, given in first
+                use order within the frame. Null is always 0, objects
+                past uMaxId all get uMaxId
+
+      Args:     std::unordered_map<const void*, UINT>& stateIds
+                  Ids of the key field the object is used in
+                const void* pState
+                  State object
+                UINT uMaxId
+                  Largest id the key field holds
+
+      Modifies: [stateIds].
+
+      Returns:  UINT
+                  Id of the state object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT DrawQueue::getStateId(_Inout_ std::unordered_map<const void*, UINT>& stateIds, _In_opt_ const void* pState, _In_ UINT uMaxId)
+    {
+        if (!pState)
+        {
+            return 0u;
+        }
+
+        auto it = stateIds.find(pState);
+        if (it == stateIds.end())
+        {
+            UINT uId = static_cast<UINT>(stateIds.size()) + 1u;
+            it = stateIds.emplace(pState, uId < uMaxId ? uId : uMaxId).first;
+        }
+
+        return it->second;
+    }
+}
@@ -0,0 +1,184 @@
+/*+===================================================================
+  File:      DRAWQUEUE.H
+
+  Summary:   DrawQueue header file contains declarations of the sorted
+             draw packet queue Renderer submits a frame through, used
+             for the lab samples of Game Graphics Programming course.
+
+  Classes: DrawQueue
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Renderer/RenderCommandList.h"
+
+namespace library
+{
+    #define MAX_DRAW_VERTEX_BUFFERS (3)
+    #define NUM_DRAW_SHADER_RESOURCES (3)
+    #define NUM_DRAW_SAMPLERS (2)
+
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eDrawPass
+
+        Summary:  Passes of a frame, submitted in this order
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eDrawPass
+    {
+        SKY,
+        SCENE,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DrawPacket
+
+      Summary:  Everything one draw call binds. The constant buffer is
+                bound to slot 2 of both stages. Every shader resource
+                and sampler slot is bound as given, a null one unbinds
+                its slot, so a packet never samples a texture left by
+                the packet recorded before it. Instanced
+                packets are drawn with DrawIndexedInstanced from
+                uBaseInstance of the instance buffer, so one with no
+                instances draws nothing, the others with DrawIndexed
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawPacket
+    {
+        ID3D11Buffer* aVertexBuffers[MAX_DRAW_VERTEX_BUFFERS];
+        UINT aStrides[MAX_DRAW_VERTEX_BUFFERS];
+        UINT uNumVertexBuffers;
+        ID3D11InputLayout* pInputLayout;
+        ID3D11Buffer* pIndexBuffer;
+        ID3D11Buffer* pConstantBuffer;
+        ID3D11VertexShader* pVertexShader;
+        ID3D11PixelShader* pPixelShader;
+        ID3D11ShaderResourceView* aShaderResourceViews[NUM_DRAW_SHADER_RESOURCES];
+        ID3D11SamplerState* aSamplers[NUM_DRAW_SAMPLERS];
+        UINT uNumIndices;
+        UINT uBaseIndex;
+        INT baseVertex;
+        BOOL bInstanced;
+        UINT uNumInstances;
+        UINT uBaseInstance;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   DrawQueueStats
+
+      Summary:  Counters of the last submitted frame, summed over its
+                chunks. Skipped state changes are bindings equal to
+                what was already bound
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawQueueStats
+    {
+        UINT uNumPackets;
+        UINT uNumChunks;
+        UINT uNumDraws;
+        UINT uNumStateChanges;
+        UINT uNumSkippedStateChanges;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DrawQueue
+
+      Summary:  Collects the draw packets of a frame, radix sorts them
+                by a 64-bit key and submits them, skipping bindings
+                that did not change since the previous packet.
+                From the most significant bits the key holds the pass
+                (4 bits), the vertex shader (6), the pixel shader (6),
+                the material (16), the first vertex buffer (16) and the
+                depth (16), so packets sharing state are adjacent and
+                near ones come first. The state objects get small ids
+                in first use order each frame, one counter per field.
+                Ids past a field's width share its largest value, which
+                only loosens the grouping, never the draws.
+                The sorted packets can be split into contiguous chunks
+                that threads record into their own command lists
+
+      Methods:  Clear
+                  Removes the packets of the last frame
+                Add
+                  Adds a packet
+                GetNumPackets
+                  Returns the number of packets
+                Sort
+                  Orders the packets by key
+                Split
+                  Divides the sorted packets into chunks
+                SubmitChunk
+                  Records one chunk into a command list
+                Submit
+                  Records every packet into a command list
+                GetStats
+                  Returns the counters of the last frame
+                DrawQueue
+                  Constructor.
+                ~DrawQueue
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DrawQueue final
+    {
+    public:
+        static constexpr const UINT MIN_PACKETS_PER_CHUNK = 256u;
+        static constexpr const UINT MAX_SHADER_ID = 0x3fu;
+        static constexpr const UINT MAX_RESOURCE_ID = 0xffffu;
+        static constexpr const UINT INDEX_FORMAT = 57u;   // DXGI_FORMAT_R16_UINT, indices are WORDs
+
+    public:
+        DrawQueue();
+        DrawQueue(const DrawQueue& other) = delete;
+        DrawQueue(DrawQueue&& other) = delete;
+        DrawQueue& operator=(const DrawQueue& other) = delete;
+        DrawQueue& operator=(DrawQueue&& other) = delete;
+        ~DrawQueue() = default;
+
+        void Clear();
+        void Add(_In_ eDrawPass pass, _In_ const DrawPacket& packet, _In_ FLOAT depth);
+        UINT GetNumPackets() const;
+
+        void Sort();
+        UINT Split(_In_ UINT uMaxChunks);
+        void SubmitChunk(_In_ UINT uChunk, _In_ RenderCommandList& commandList);
+        void Submit(_In_ RenderCommandList& commandList);
+
+        DrawQueueStats GetStats() const;
+
+    private:
+        struct QueuedPacket
+        {
+            DrawPacket packet;
+            eDrawPass pass;
+            FLOAT depth;
+        };
+
+        struct SortEntry
+        {
+            UINT64 uKey;
+            UINT uPacket;
+        };
+
+        struct Chunk
+        {
+            UINT uBegin;
+            UINT uEnd;
+            DrawQueueStats stats;
+        };
+
+    private:
+        UINT64 makeSortKey(_In_ eDrawPass pass, _In_ const DrawPacket& packet, _In_ FLOAT depth);
+        UINT getStateId(_Inout_ std::unordered_map<const void*, UINT>& stateIds, _In_opt_ const void* pState, _In_ UINT uMaxId);
+
+    private:
+        std::vector<QueuedPacket> m_aPackets;
+        std::vector<SortEntry> m_aEntries;
+        std::vector<SortEntry> m_aScratch;
+        std::vector<Chunk> m_aChunks;
+        std::unordered_map<const void*, UINT> m_vertexShaderIds;
+        std::unordered_map<const void*, UINT> m_pixelShaderIds;
+        std::unordered_map<const void*, UINT> m_materialIds;
+        std::unordered_map<const void*, UINT> m_vertexBufferIds;
+    };
+}
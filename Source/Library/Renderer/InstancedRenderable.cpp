@@ -1,5 +1,7 @@
 #include "Renderer/InstancedRenderable.h"
 
+#include <algorithm>
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -15,6 +17,9 @@ namespace library
         , m_padding{0}
         , m_instanceBuffer(nullptr)
         , m_aInstanceData(std::vector<InstanceData>())  //׳ ̷ غ ̴ϼȶ.
+        , m_aPackedInstanceData()
+        , m_bIsPacked(FALSE)
+        , m_uInstanceCapacity(0u)
     {
     }
 
@@ -34,7 +39,10 @@ namespace library
         : Renderable(outputColor)
         , m_padding{0}
         , m_instanceBuffer(nullptr)
-        , m_aInstanceData(aInstanceData)
+        , m_aInstanceData(std::move(aInstanceData))
+        , m_aPackedInstanceData()
+        , m_bIsPacked(FALSE)
+        , m_uInstanceCapacity(0u)
     {
     }
 
@@ -46,11 +54,152 @@ namespace library
       Args:     std::vector<InstanceData>&& aInstanceData
                   Instance data
 
-      Modifies: [m_aInstanceData].
+      Modifies: [m_aInstanceData, m_aPackedInstanceData, m_bIsPacked].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void InstancedRenderable::SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData)
     {
-        m_aInstanceData = aInstanceData;
+        m_aInstanceData = std::move(aInstanceData);
+        m_aPackedInstanceData.clear();
+        m_bIsPacked = FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetPackedInstanceData
+
+      Summary:  Sets the packed instance data. The vertex shader must
+                expand the grid coordinate, see VoxelVertexShader
+
+      Args:     std::vector<PackedInstanceData>&& aPackedInstanceData
+                  Packed instance data
+
+      Modifies: [m_aInstanceData, m_aPackedInstanceData, m_bIsPacked].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetPackedInstanceData(_In_ std::vector<PackedInstanceData>&& aPackedInstanceData)
+    {
+        m_aPackedInstanceData = std::move(aPackedInstanceData);
+        m_aInstanceData.clear();
+        m_bIsPacked = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::UpdatePackedInstanceData
+
+      Summary:  Copies the changed ranges of the packed instances and
+                uploads only those ranges. The instance buffer is
+                recreated with doubled capacity when it is too small,
+                and then uploaded whole
+
+      Args:     ID3D11Device* pDevice
+                  Pointer to a Direct3D 11 device
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the instances
+                const std::vector<PackedInstanceData>& aPackedInstanceData
+                  Every packed instance of the renderable
+                const std::vector<InstanceRange>& aDirtyRanges
+                  Ranges of instances that differ from the uploaded
+                  ones, the rest of the array is unchanged
+
+      Modifies: [m_instanceBuffer, m_aInstanceData,
+                 m_aPackedInstanceData, m_bIsPacked,
+                 m_uInstanceCapacity].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT InstancedRenderable::UpdatePackedInstanceData(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const std::vector<PackedInstanceData>& aPackedInstanceData, _In_ const std::vector<InstanceRange>& aDirtyRanges)
+    {
+        if (pDevice == nullptr || pImmediateContext == nullptr)
+            return E_INVALIDARG;
+
+        UINT uNumInstances = static_cast<UINT>(aPackedInstanceData.size());
+        BOOL bIsWholeDirty = !m_bIsPacked;
+        if (!m_bIsPacked)
+        {
+            m_aInstanceData.clear();
+            m_bIsPacked = TRUE;
+        }
+
+        m_aPackedInstanceData.resize(uNumInstances);
+        if (uNumInstances == 0u)
+        {
+            return S_OK;
+        }
+
+        if (bIsWholeDirty)
+        {
+            std::copy(aPackedInstanceData.begin(), aPackedInstanceData.end(), m_aPackedInstanceData.begin());
+        }
+        else
+        {
+            for (const InstanceRange& dirtyRange : aDirtyRanges)
+            {
+                if (dirtyRange.uOffset >= uNumInstances)
+                {
+                    continue;
+                }
+
+                UINT uEnd = dirtyRange.uOffset + dirtyRange.uCount < uNumInstances ? dirtyRange.uOffset + dirtyRange.uCount : uNumInstances;
+                std::copy(aPackedInstanceData.begin() + dirtyRange.uOffset, aPackedInstanceData.begin() + uEnd, m_aPackedInstanceData.begin() + dirtyRange.uOffset);
+            }
+        }
+
+        if (m_instanceBuffer == nullptr || uNumInstances > m_uInstanceCapacity)
+        {
+            m_uInstanceCapacity = uNumInstances > m_uInstanceCapacity * 2u ? uNumInstances : m_uInstanceCapacity * 2u;
+
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = GetInstanceStride() * m_uInstanceCapacity,
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = 0
+            };
+
+            m_instanceBuffer.Reset();
+            HRESULT hr = pDevice->CreateBuffer(&bd, nullptr, m_instanceBuffer.GetAddressOf());
+            if (FAILED(hr))
+                return hr;
+
+            bIsWholeDirty = TRUE;
+        }
+
+        if (bIsWholeDirty)
+        {
+            D3D11_BOX box =
+            {
+                .left = 0u,
+                .top = 0u,
+                .front = 0u,
+                .right = GetInstanceStride() * uNumInstances,
+                .bottom = 1u,
+                .back = 1u
+            };
+            pImmediateContext->UpdateSubresource(m_instanceBuffer.Get(), 0u, &box, m_aPackedInstanceData.data(), 0u, 0u);
+
+            return S_OK;
+        }
+
+        for (const InstanceRange& dirtyRange : aDirtyRanges)
+        {
+            if (dirtyRange.uOffset >= uNumInstances || dirtyRange.uCount == 0u)
+            {
+                continue;
+            }
+
+            UINT uEnd = dirtyRange.uOffset + dirtyRange.uCount < uNumInstances ? dirtyRange.uOffset + dirtyRange.uCount : uNumInstances;
+            D3D11_BOX box =
+            {
+                .left = GetInstanceStride() * dirtyRange.uOffset,
+                .top = 0u,
+                .front = 0u,
+                .right = GetInstanceStride() * uEnd,
+                .bottom = 1u,
+                .back = 1u
+            };
+            pImmediateContext->UpdateSubresource(m_instanceBuffer.Get(), 0u, &box, m_aPackedInstanceData.data() + dirtyRange.uOffset, 0u, 0u);
+        }
+
+        return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -76,7 +225,43 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     UINT InstancedRenderable::GetNumInstances() const
     {
-        return m_aInstanceData.size();
+        if (m_bIsPacked)
+        {
+            return static_cast<UINT>(m_aPackedInstanceData.size());
+        }
+
+        return static_cast<UINT>(m_aInstanceData.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceStride
+
+      Summary:  Returns the size of an instance in the instance buffer
+
+      Returns:  UINT
+                  Stride of the instance buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::GetInstanceStride() const
+    {
+        if (m_bIsPacked)
+        {
+            return static_cast<UINT>(sizeof(PackedInstanceData));
+        }
+
+        return static_cast<UINT>(sizeof(InstanceData));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::IsPacked
+
+      Summary:  Returns whether the packed instance data is used
+
+      Returns:  BOOL
+                  TRUE if the instances are PackedInstanceData
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL InstancedRenderable::IsPacked() const
+    {
+        return m_bIsPacked;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -87,7 +272,7 @@ namespace library
       Args:     ID3D11Device* pDevice
                   Pointer to a Direct3D 11 device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_uInstanceCapacity].
 
       Returns:  HRESULT
                   Status code
@@ -97,9 +282,12 @@ namespace library
         if (pDevice == nullptr)
             return E_INVALIDARG;
 
+        // Streamed renderables start empty, a buffer cannot have zero size
+        m_uInstanceCapacity = GetNumInstances() > 0u ? GetNumInstances() : 1u;
+
         D3D11_BUFFER_DESC bd =
         {
-            .ByteWidth = sizeof(InstanceData) * GetNumInstances(),
+            .ByteWidth = GetInstanceStride() * m_uInstanceCapacity,
             .Usage = D3D11_USAGE_DEFAULT,
             .BindFlags = D3D11_BIND_VERTEX_BUFFER,  // VERTEX . ʿ INSTANCE ;;
             .CPUAccessFlags = 0
@@ -107,10 +295,10 @@ namespace library
 
         D3D11_SUBRESOURCE_DATA initData =
         {
-            .pSysMem = m_aInstanceData.data()
+            .pSysMem = m_bIsPacked ? static_cast<const void*>(m_aPackedInstanceData.data()) : static_cast<const void*>(m_aInstanceData.data())
         };
 
-        HRESULT hr = pDevice->CreateBuffer(&bd, &initData, m_instanceBuffer.GetAddressOf());
+        HRESULT hr = pDevice->CreateBuffer(&bd, GetNumInstances() > 0u ? &initData : nullptr, m_instanceBuffer.GetAddressOf());
         if (FAILED(hr))
             return hr;
 
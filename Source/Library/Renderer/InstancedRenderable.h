@@ -25,10 +25,19 @@ namespace library
 
       Methods:  SetInstanceData
                   Sets the instance data
+                SetPackedInstanceData
+                  Sets the packed grid instance data
+                UpdatePackedInstanceData
+                  Uploads the changed ranges of the packed instance
+                  data
                 GetInstanceBuffer
                   Returns a instance buffer
                 GetNumInstances
                   Returns the number of instance data
+                GetInstanceStride
+                  Returns the size of an instance in bytes
+                IsPacked
+                  Returns whether the packed instance data is used
                 initializeInstance
                   Initialize the instance buffer
                 InstancedRenderable
@@ -51,9 +60,13 @@ namespace library
         virtual void Update(_In_ FLOAT deltaTime) override = 0;
 
         void SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData);
+        void SetPackedInstanceData(_In_ std::vector<PackedInstanceData>&& aPackedInstanceData);
+        HRESULT UpdatePackedInstanceData(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const std::vector<PackedInstanceData>& aPackedInstanceData, _In_ const std::vector<InstanceRange>& aDirtyRanges);
 
         virtual ComPtr<ID3D11Buffer>& GetInstanceBuffer();
         virtual UINT GetNumInstances() const;
+        UINT GetInstanceStride() const;
+        BOOL IsPacked() const;
 
         UINT GetNumVertices() const override = 0;
         UINT GetNumIndices() const override = 0;
@@ -67,6 +80,9 @@ namespace library
     protected:
         ComPtr<ID3D11Buffer> m_instanceBuffer;
         std::vector<InstanceData> m_aInstanceData;
+        std::vector<PackedInstanceData> m_aPackedInstanceData;
+        BOOL m_bIsPacked;
+        UINT m_uInstanceCapacity;
 
     private:
         BYTE m_padding[8];
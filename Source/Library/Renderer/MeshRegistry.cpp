@@ -0,0 +1,224 @@
+#include "Renderer/MeshRegistry.h"
+
+namespace library
+{
+    std::mutex MeshRegistry::s_mutex;
+    std::unordered_multimap<UINT64, std::weak_ptr<SharedMesh>> MeshRegistry::s_meshes;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshRegistry::Acquire
+
+      Summary:  Returns the shared buffers of the mesh with the given
+                contents on the given device. The buffers are created
+                the first time the contents are seen
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                const SimpleVertex* aVertices
+                  Vertices of the mesh, valid while the mesh is held
+                UINT uNumVertices
+                  Number of vertices
+                const WORD* aIndices
+                  Indices of the mesh, valid while the mesh is held
+                UINT uNumIndices
+                  Number of indices
+                const NormalData* aNormalData
+                  Tangent space vectors, one per vertex, only read
+                  when the buffers are created
+                std::shared_ptr<const SharedMesh>& outMesh
+                  Shared mesh, kept alive while it is held
+
+      Modifies: [s_meshes].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MeshRegistry::Acquire(
+        _In_ ID3D11Device* pDevice,
+        _In_ const SimpleVertex* aVertices,
+        _In_ UINT uNumVertices,
+        _In_ const WORD* aIndices,
+        _In_ UINT uNumIndices,
+        _In_ const NormalData* aNormalData,
+        _Out_ std::shared_ptr<const SharedMesh>& outMesh
+        )
+    {
+        outMesh.reset();
+
+        if (pDevice == nullptr || aVertices == nullptr || aIndices == nullptr || aNormalData == nullptr)
+            return E_INVALIDARG;
+
+        UINT64 uHash = hash(14695981039346656037ull, aVertices, sizeof(SimpleVertex) * uNumVertices);
+        uHash = hash(uHash, aIndices, sizeof(WORD) * uNumIndices);
+
+        // Meshes are compared outside the lock, the last release of one locks it again
+        std::vector<std::shared_ptr<SharedMesh>> aCandidates;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            auto range = s_meshes.equal_range(uHash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                aCandidates.push_back(it->second.lock());
+            }
+        }
+
+        for (std::shared_ptr<SharedMesh>& candidate : aCandidates)
+        {
+            if (candidate
+                && candidate->pDevice == pDevice
+                && candidate->uNumVertices == uNumVertices
+                && candidate->uNumIndices == uNumIndices
+                && (candidate->aVertices == aVertices || memcmp(candidate->aVertices, aVertices, sizeof(SimpleVertex) * uNumVertices) == 0)
+                && (candidate->aIndices == aIndices || memcmp(candidate->aIndices, aIndices, sizeof(WORD) * uNumIndices) == 0))
+            {
+                outMesh = candidate;
+                return S_OK;
+            }
+        }
+
+        std::shared_ptr<SharedMesh> mesh(new SharedMesh(), release);
+        mesh->pDevice = pDevice;
+        mesh->aVertices = aVertices;
+        mesh->uNumVertices = uNumVertices;
+        mesh->aIndices = aIndices;
+        mesh->uNumIndices = uNumIndices;
+        mesh->uHash = uHash;
+
+        HRESULT hr = createBuffer(pDevice, D3D11_BIND_VERTEX_BUFFER, aVertices, sizeof(SimpleVertex) * uNumVertices, mesh->VertexBuffer);
+        if (FAILED(hr))
+            return hr;
+
+        hr = createBuffer(pDevice, D3D11_BIND_VERTEX_BUFFER, aNormalData, sizeof(NormalData) * uNumVertices, mesh->NormalBuffer);
+        if (FAILED(hr))
+            return hr;
+
+        hr = createBuffer(pDevice, D3D11_BIND_INDEX_BUFFER, aIndices, sizeof(WORD) * uNumIndices, mesh->IndexBuffer);
+        if (FAILED(hr))
+            return hr;
+
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            s_meshes.emplace(uHash, mesh);
+        }
+        outMesh = std::move(mesh);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshRegistry::GetNumMeshes
+
+      Summary:  Returns the number of distinct meshes in use
+
+      Returns:  size_t
+                  Number of meshes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t MeshRegistry::GetNumMeshes()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+
+        return s_meshes.size();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshRegistry::hash
+
+      Summary:  Continues a 64-bit FNV-1a hash over the given bytes
+
+      Args:     UINT64 uHash
+                  Hash of the bytes before
+                const void* pData
+                  Bytes to hash
+                size_t uSize
+                  Number of bytes
+
+      Returns:  UINT64
+                  Hash
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 MeshRegistry::hash(_In_ UINT64 uHash, _In_ const void* pData, _In_ size_t uSize)
+    {
+        const BYTE* pBytes = static_cast<const BYTE*>(pData);
+        for (size_t i = 0u; i < uSize; ++i)
+        {
+            uHash ^= pBytes[i];
+            uHash *= 1099511628211ull;
+        }
+
+        return uHash;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshRegistry::createBuffer
+
+      Summary:  Creates a geometry buffer of a mesh
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+                UINT uBindFlags
+                  Vertex or index buffer
+                const void* pData
+                  Initial contents
+                UINT uSize
+                  Size in bytes
+                ComPtr<ID3D11Buffer>& outBuffer
+                  Created buffer
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT MeshRegistry::createBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uBindFlags, _In_ const void* pData, _In_ UINT uSize, _Out_ ComPtr<ID3D11Buffer>& outBuffer)
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = uSize,
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = uBindFlags,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = pData,
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        return pDevice->CreateBuffer(&bd, &initData, outBuffer.ReleaseAndGetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshRegistry::release
+
+      Summary:  Deleter of a shared mesh. Removes the entries of the
+                released meshes with its hash and destroys the mesh
+
+      Args:     SharedMesh* pMesh
+                  Mesh whose last holder released it
+
+      Modifies: [s_meshes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void MeshRegistry::release(_In_ SharedMesh* pMesh)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            auto range = s_meshes.equal_range(pMesh->uHash);
+            for (auto it = range.first; it != range.second;)
+            {
+                if (it->second.expired())
+                {
+                    it = s_meshes.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        delete pMesh;
+    }
+}
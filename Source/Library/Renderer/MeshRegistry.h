@@ -0,0 +1,93 @@
+/*+===================================================================
+  File:      MESHREGISTRY.H
+
+  Summary:   MeshRegistry header file contains declarations of the
+             registry of geometry buffers shared by small renderables
+             with identical vertices and indices, used for the lab
+             samples of Game Graphics Programming course.
+
+  Classes: MeshRegistry
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <mutex>
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SharedMesh
+
+      Summary:  Geometry buffers of one distinct mesh on one device.
+                The vertices and indices point at the arrays of the
+                renderable that created the mesh, they are not copied
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SharedMesh
+    {
+        ComPtr<ID3D11Buffer> VertexBuffer;
+        ComPtr<ID3D11Buffer> NormalBuffer;
+        ComPtr<ID3D11Buffer> IndexBuffer;
+        ID3D11Device* pDevice;
+        const SimpleVertex* aVertices;
+        UINT uNumVertices;
+        const WORD* aIndices;
+        UINT uNumIndices;
+        UINT64 uHash;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MeshRegistry
+
+      Summary:  Hands out one set of vertex, normal and index buffers
+                per distinct mesh and device, found by a hash of the
+                vertices and indices, so renderables with the same
+                geometry share the buffers and can be drawn as one
+                instanced batch. Only renderables with small meshes in
+                static arrays, like the cubes, use it: the arrays are
+                compared in place and must outlive the mesh, and the
+                normal data must follow from the vertices and indices.
+                A mesh leaves the registry when its last renderable
+                releases it
+
+      Methods:  Acquire
+                  Returns the shared buffers of a mesh, creating them
+                  the first time the mesh is seen
+                GetNumMeshes
+                  Returns the number of distinct meshes
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MeshRegistry final
+    {
+    public:
+        MeshRegistry() = delete;
+        MeshRegistry(const MeshRegistry& other) = delete;
+        MeshRegistry(MeshRegistry&& other) = delete;
+        MeshRegistry& operator=(const MeshRegistry& other) = delete;
+        MeshRegistry& operator=(MeshRegistry&& other) = delete;
+        ~MeshRegistry() = delete;
+
+        static HRESULT Acquire(
+            _In_ ID3D11Device* pDevice,
+            _In_ const SimpleVertex* aVertices,
+            _In_ UINT uNumVertices,
+            _In_ const WORD* aIndices,
+            _In_ UINT uNumIndices,
+            _In_ const NormalData* aNormalData,
+            _Out_ std::shared_ptr<const SharedMesh>& outMesh
+            );
+        static size_t GetNumMeshes();
+
+    private:
+        static UINT64 hash(_In_ UINT64 uHash, _In_ const void* pData, _In_ size_t uSize);
+        static HRESULT createBuffer(_In_ ID3D11Device* pDevice, _In_ UINT uBindFlags, _In_ const void* pData, _In_ UINT uSize, _Out_ ComPtr<ID3D11Buffer>& outBuffer);
+        static void release(_In_ SharedMesh* pMesh);
+
+    private:
+        static std::mutex s_mutex;
+        static std::unordered_multimap<UINT64, std::weak_ptr<SharedMesh>> s_meshes;
+    };
+}
@@ -0,0 +1,453 @@
+#include "Renderer/NullRenderCommandList.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::NullRenderCommandList
+
+      Summary:  Constructor
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NullRenderCommandList::NullRenderCommandList()
+        : m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::ClearRenderTargetView
+
+      Summary:  Counts a clear
+
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target to clear, unused
+                const FLOAT aColorRGBA[4]
+                  Clear color, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        ++m_stats.uNumClears;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::ClearDepthStencilView
+
+      Summary:  Counts a clear
+
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil to clear, unused
+                UINT uClearFlags
+                  D3D11_CLEAR_FLAG of the planes to clear, unused
+                FLOAT depth
+                  Clear depth, unused
+                UINT8 uStencil
+                  Clear stencil, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil)
+    {
+        ++m_stats.uNumClears;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::OMSetRenderTargets
+
+      Summary:  Counts a state change
+
+      Args:     UINT uNumViews
+                  Number of render targets, unused
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                  Render targets, unused
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::OMSetRenderTargets(_In_ UINT uNumViews, _In_opt_ ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::RSSetViewports
+
+      Summary:  Counts a state change
+
+      Args:     UINT uNumViewports
+                  Number of viewports, unused
+                const D3D11_VIEWPORT* pViewports
+                  Viewports, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::RSSetViewports(_In_ UINT uNumViewports, _In_ const D3D11_VIEWPORT* pViewports)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::IASetPrimitiveTopology
+
+      Summary:  Counts a state change
+
+      Args:     UINT uTopology
+                  D3D11_PRIMITIVE_TOPOLOGY of the primitives, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::IASetPrimitiveTopology(_In_ UINT uTopology)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::IASetVertexBuffers
+
+      Summary:  Counts a state change
+
+      Args:     UINT uStartSlot
+                  First input slot, unused
+                UINT uNumBuffers
+                  Number of vertex buffers, unused
+                ID3D11Buffer* const* ppVertexBuffers
+                  Vertex buffers, unused
+                const UINT* puStrides
+                  Stride of each vertex buffer, unused
+                const UINT* puOffsets
+                  Offset of each vertex buffer, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppVertexBuffers, _In_ const UINT* puStrides, _In_ const UINT* puOffsets)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::IASetInputLayout
+
+      Summary:  Counts a state change
+
+      Args:     ID3D11InputLayout* pInputLayout
+                  Input layout, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::IASetIndexBuffer
+
+      Summary:  Counts a state change
+
+      Args:     ID3D11Buffer* pIndexBuffer
+                  Index buffer, unused
+                UINT uFormat
+                  DXGI_FORMAT of the indices, unused
+                UINT uOffset
+                  Offset of the first index in bytes, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ UINT uFormat, _In_ UINT uOffset)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::UpdateSubresource
+
+      Summary:  Counts an upload
+
+      Args:     ID3D11Resource* pDstResource
+                  Destination resource, unused
+                UINT uDstSubresource
+                  Destination subresource, unused
+                const D3D11_BOX* pDstBox
+                  Destination region, unused
+                const void* pSrcData
+                  Source data, unused
+                UINT uSrcRowPitch
+                  Size of a source row, unused
+                UINT uSrcDepthPitch
+                  Size of a source depth slice, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch)
+    {
+        ++m_stats.uNumUploads;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::VSSetConstantBuffers
+
+      Summary:  Counts a state change
+
+      Args:     UINT uStartSlot
+                  First constant buffer slot, unused
+                UINT uNumBuffers
+                  Number of constant buffers, unused
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::PSSetConstantBuffers
+
+      Summary:  Counts a state change
+
+      Args:     UINT uStartSlot
+                  First constant buffer slot, unused
+                UINT uNumBuffers
+                  Number of constant buffers, unused
+                ID3D11Buffer* const* ppConstantBuffers
+                  Constant buffers, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::VSSetShader
+
+      Summary:  Counts a state change
+
+      Args:     ID3D11VertexShader* pVertexShader
+                  Vertex shader, unused
+                ID3D11ClassInstance* const* ppClassInstances
+                  Class instances of the shader interfaces, unused
+                UINT uNumClassInstances
+                  Number of class instances, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::PSSetShader
+
+      Summary:  Counts a state change
+
+      Args:     ID3D11PixelShader* pPixelShader
+                  Pixel shader, unused
+                ID3D11ClassInstance* const* ppClassInstances
+                  Class instances of the shader interfaces, unused
+                UINT uNumClassInstances
+                  Number of class instances, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::PSSetShaderResources
+
+      Summary:  Counts a state change
+
+      Args:     UINT uStartSlot
+                  First resource slot, unused
+                UINT uNumViews
+                  Number of resources, unused
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+                  Shader resources, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_ ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::PSSetSamplers
+
+      Summary:  Counts a state change
+
+      Args:     UINT uStartSlot
+                  First sampler slot, unused
+                UINT uNumSamplers
+                  Number of samplers, unused
+                ID3D11SamplerState* const* ppSamplers
+                  Samplers, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_ ID3D11SamplerState* const* ppSamplers)
+    {
+        ++m_stats.uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::DrawIndexed
+
+      Summary:  Counts a draw of one instance
+
+      Args:     UINT uIndexCount
+                  Number of indices
+                UINT uStartIndexLocation
+                  First index, unused
+                INT baseVertexLocation
+                  Value added to each index, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation)
+    {
+        ++m_stats.uNumDraws;
+        ++m_stats.uNumInstances;
+        m_stats.uNumIndices += uIndexCount;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::DrawIndexedInstanced
+
+      Summary:  Counts a draw of several instances
+
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices of an instance
+                UINT uInstanceCount
+                  Number of instances
+                UINT uStartIndexLocation
+                  First index, unused
+                INT baseVertexLocation
+                  Value added to each index, unused
+                UINT uStartInstanceLocation
+                  Value added to each instance index, unused
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        ++m_stats.uNumDraws;
+        m_stats.uNumInstances += uInstanceCount;
+        m_stats.uNumIndices += uIndexCountPerInstance * uInstanceCount;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::Present
+
+      Summary:  Counts a present
+
+      Args:     UINT uSyncInterval
+                  Vertical blanks to wait for, unused
+                UINT uFlags
+                  DXGI_PRESENT flags, unused
+
+      Modifies: [m_stats].
+
+      Returns:  HRESULT
+                  Status code, always S_OK
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderCommandList::Present(_In_ UINT uSyncInterval, _In_ UINT uFlags)
+    {
+        ++m_stats.uNumPresents;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::CreateDeferredCommandList
+
+      Summary:  Creates another counting list
+
+      Args:     std::shared_ptr<RenderCommandList>& outCommandList
+                  The created list
+
+      Returns:  HRESULT
+                  Status code, always S_OK
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderCommandList::CreateDeferredCommandList(_Out_ std::shared_ptr<RenderCommandList>& outCommandList)
+    {
+        outCommandList = std::make_shared<NullRenderCommandList>();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::Finish
+
+      Summary:  Does nothing, the counters are read by Execute
+
+      Returns:  HRESULT
+                  Status code, always S_OK
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderCommandList::Finish()
+    {
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::Execute
+
+      Summary:  Adds the counters of a deferred list to this list and
+                zeroes them, as if its commands were played here
+
+      Args:     RenderCommandList& deferredCommandList
+                  A list created by CreateDeferredCommandList of this
+                  backend
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::Execute(_In_ RenderCommandList& deferredCommandList)
+    {
+        NullRenderCommandList& nullCommandList = static_cast<NullRenderCommandList&>(deferredCommandList);
+        const RenderCommandStats& deferredStats = nullCommandList.GetStats();
+
+        m_stats.uNumStateChanges += deferredStats.uNumStateChanges;
+        m_stats.uNumUploads += deferredStats.uNumUploads;
+        m_stats.uNumDraws += deferredStats.uNumDraws;
+        m_stats.uNumInstances += deferredStats.uNumInstances;
+        m_stats.uNumIndices += deferredStats.uNumIndices;
+        m_stats.uNumClears += deferredStats.uNumClears;
+        m_stats.uNumPresents += deferredStats.uNumPresents;
+
+        nullCommandList.ResetStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::GetStats
+
+      Summary:  Returns the counters recorded since the last reset
+
+      Returns:  const RenderCommandStats&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderCommandStats& NullRenderCommandList::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderCommandList::ResetStats
+
+      Summary:  Zeroes the counters, usually once per recorded frame
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderCommandList::ResetStats()
+    {
+        m_stats = RenderCommandStats();
+    }
+}
@@ -0,0 +1,140 @@
+/*+===================================================================
+  File:      NULLRENDERCOMMANDLIST.H
+
+  Summary:   NullRenderCommandList header file contains declarations
+             of the backend that counts commands instead of submitting
+             them, used for the lab samples of Game Graphics
+             Programming course.
+
+  Classes: NullRenderCommandList
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Renderer/RenderCommandList.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   RenderCommandStats
+
+      Summary:  Counters of the commands recorded since the last reset.
+                Every bind call is one state change, every draw call
+                one draw
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderCommandStats
+    {
+        UINT uNumStateChanges;
+        UINT uNumUploads;
+        UINT uNumDraws;
+        UINT uNumInstances;
+        UINT uNumIndices;
+        UINT uNumClears;
+        UINT uNumPresents;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    NullRenderCommandList
+
+      Summary:  Counts the commands it receives without touching the
+                resources, so Renderer can record frames without a
+                device to measure and check its CPU-side submission.
+                No GPU, window or Windows SDK is needed
+
+      Methods:  ClearRenderTargetView
+                  Counts a clear
+                ClearDepthStencilView
+                  Counts a clear
+                OMSetRenderTargets
+                  Counts a state change
+                RSSetViewports
+                  Counts a state change
+                IASetPrimitiveTopology
+                  Counts a state change
+                IASetVertexBuffers
+                  Counts a state change
+                IASetInputLayout
+                  Counts a state change
+                IASetIndexBuffer
+                  Counts a state change
+                UpdateSubresource
+                  Counts an upload
+                VSSetConstantBuffers
+                  Counts a state change
+                PSSetConstantBuffers
+                  Counts a state change
+                VSSetShader
+                  Counts a state change
+                PSSetShader
+                  Counts a state change
+                PSSetShaderResources
+                  Counts a state change
+                PSSetSamplers
+                  Counts a state change
+                DrawIndexed
+                  Counts a draw
+                DrawIndexedInstanced
+                  Counts an instanced draw
+                Present
+                  Counts a present
+                CreateDeferredCommandList
+                  Creates another counting list
+                Finish
+                  Does nothing
+                Execute
+                  Adds the counters of a deferred list
+                GetStats
+                  Returns the counters
+                ResetStats
+                  Zeroes the counters
+                NullRenderCommandList
+                  Constructor.
+                ~NullRenderCommandList
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class NullRenderCommandList final : public RenderCommandList
+    {
+    public:
+        NullRenderCommandList();
+        NullRenderCommandList(const NullRenderCommandList& other) = delete;
+        NullRenderCommandList(NullRenderCommandList&& other) = delete;
+        NullRenderCommandList& operator=(const NullRenderCommandList& other) = delete;
+        NullRenderCommandList& operator=(NullRenderCommandList&& other) = delete;
+        ~NullRenderCommandList() = default;
+
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil) override;
+        void OMSetRenderTargets(_In_ UINT uNumViews, _In_opt_ ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void RSSetViewports(_In_ UINT uNumViewports, _In_ const D3D11_VIEWPORT* pViewports) override;
+        void IASetPrimitiveTopology(_In_ UINT uTopology) override;
+
+        void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppVertexBuffers, _In_ const UINT* puStrides, _In_ const UINT* puOffsets) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ UINT uFormat, _In_ UINT uOffset) override;
+
+        void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch) override;
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers) override;
+
+        void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances) override;
+        void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances) override;
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_ ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_ ID3D11SamplerState* const* ppSamplers) override;
+
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+        HRESULT Present(_In_ UINT uSyncInterval, _In_ UINT uFlags) override;
+
+        HRESULT CreateDeferredCommandList(_Out_ std::shared_ptr<RenderCommandList>& outCommandList) override;
+        HRESULT Finish() override;
+        void Execute(_In_ RenderCommandList& deferredCommandList) override;
+
+        const RenderCommandStats& GetStats() const;
+        void ResetStats();
+
+    private:
+        RenderCommandStats m_stats;
+    };
+}
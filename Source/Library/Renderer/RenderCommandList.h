@@ -0,0 +1,127 @@
+/*+===================================================================
+  File:      RENDERCOMMANDLIST.H
+
+  Summary:   RenderCommandList header file contains declarations of
+             the draw submission interface Renderer records into, used
+             for the lab samples of Game Graphics Programming course.
+
+  Classes: RenderCommandList
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include <memory>
+
+#include "Renderer/RenderHandles.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderCommandList
+
+      Summary:  Base class of the backends that receive the draw
+                submission of Renderer. The methods mirror the
+                ID3D11DeviceContext calls of the same name, so a
+                backend that never dereferences the resources can
+                record a frame without a device. The resources are
+                opaque handles and the topology and index format plain
+                D3D11 enum values, so the interface builds without the
+                Windows SDK.
+                Deferred lists start from the default pipeline state and
+                leave the default state behind once executed, so every
+                deferred list binds the state its draws need
+
+      Methods:  ClearRenderTargetView
+                  Pure virtual function that clears a render target
+                ClearDepthStencilView
+                  Pure virtual function that clears a depth stencil
+                OMSetRenderTargets
+                  Pure virtual function that binds render targets
+                RSSetViewports
+                  Pure virtual function that sets the viewports
+                IASetPrimitiveTopology
+                  Pure virtual function that sets the topology
+                IASetVertexBuffers
+                  Pure virtual function that binds vertex buffers
+                IASetInputLayout
+                  Pure virtual function that binds an input layout
+                IASetIndexBuffer
+                  Pure virtual function that binds an index buffer
+                UpdateSubresource
+                  Pure virtual function that uploads to a resource
+                VSSetConstantBuffers
+                  Pure virtual function that binds vertex shader
+                  constant buffers
+                PSSetConstantBuffers
+                  Pure virtual function that binds pixel shader
+                  constant buffers
+                VSSetShader
+                  Pure virtual function that binds a vertex shader
+                PSSetShader
+                  Pure virtual function that binds a pixel shader
+                PSSetShaderResources
+                  Pure virtual function that binds pixel shader
+                  resources
+                PSSetSamplers
+                  Pure virtual function that binds pixel shader
+                  samplers
+                DrawIndexed
+                  Pure virtual function that draws indexed primitives
+                DrawIndexedInstanced
+                  Pure virtual function that draws instanced indexed
+                  primitives
+                Present
+                  Pure virtual function that presents the frame
+                CreateDeferredCommandList
+                  Pure virtual function that creates a list another
+                  thread records into
+                Finish
+                  Pure virtual function that closes a deferred list
+                Execute
+                  Pure virtual function that plays a finished deferred
+                  list
+                RenderCommandList
+                  Constructor.
+                ~RenderCommandList
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderCommandList
+    {
+    public:
+        RenderCommandList() = default;
+        RenderCommandList(const RenderCommandList& other) = delete;
+        RenderCommandList(RenderCommandList&& other) = delete;
+        RenderCommandList& operator=(const RenderCommandList& other) = delete;
+        RenderCommandList& operator=(RenderCommandList&& other) = delete;
+        virtual ~RenderCommandList() = default;
+
+        virtual void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) = 0;
+        virtual void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 uStencil) = 0;
+        virtual void OMSetRenderTargets(_In_ UINT uNumViews, _In_opt_ ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) = 0;
+        virtual void RSSetViewports(_In_ UINT uNumViewports, _In_ const D3D11_VIEWPORT* pViewports) = 0;
+        virtual void IASetPrimitiveTopology(_In_ UINT uTopology) = 0;
+
+        virtual void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppVertexBuffers, _In_ const UINT* puStrides, _In_ const UINT* puOffsets) = 0;
+        virtual void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) = 0;
+        virtual void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ UINT uFormat, _In_ UINT uOffset) = 0;
+
+        virtual void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch) = 0;
+        virtual void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_ ID3D11Buffer* const* ppConstantBuffers) = 0;
+
+        virtual void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances) = 0;
+        virtual void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader, _In_opt_ ID3D11ClassInstance* const* ppClassInstances, _In_ UINT uNumClassInstances) = 0;
+        virtual void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_ ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+        virtual void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_ ID3D11SamplerState* const* ppSamplers) = 0;
+
+        virtual void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation) = 0;
+        virtual void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation) = 0;
+
+        virtual HRESULT Present(_In_ UINT uSyncInterval, _In_ UINT uFlags) = 0;
+
+        virtual HRESULT CreateDeferredCommandList(_Out_ std::shared_ptr<RenderCommandList>& outCommandList) = 0;
+        virtual HRESULT Finish() = 0;
+        virtual void Execute(_In_ RenderCommandList& deferredCommandList) = 0;
+    };
+}
@@ -0,0 +1,103 @@
+/*+===================================================================
+  File:      RENDERHANDLES.H
+
+  Summary:   RenderHandles header file contains the basic types and the
+             opaque handles of the state objects the draw submission
+             passes around, used for the lab samples of Game Graphics
+             Programming course. It does not include Common.h, so
+             RenderCommandList, NullRenderCommandList and DrawQueue
+             also build without the Windows SDK.
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#if defined(_WIN32)
+
+#ifndef  UNICODE
+#define UNICODE
+#endif // ! UNICODE
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // ! WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+
+#else
+
+#include <cstdint>
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef char CHAR;
+typedef int INT;
+typedef unsigned int UINT;
+typedef std::uint8_t UINT8;
+typedef std::uint64_t UINT64;
+typedef float FLOAT;
+typedef const char* PCSTR;
+typedef std::int32_t HRESULT;
+
+#ifndef TRUE
+#define TRUE 1
+#endif // ! TRUE
+
+#ifndef FALSE
+#define FALSE 0
+#endif // ! FALSE
+
+#ifndef S_OK
+#define S_OK ((HRESULT)0L)
+#endif // ! S_OK
+
+#ifndef E_INVALIDARG
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#endif // ! E_INVALIDARG
+
+#ifndef SUCCEEDED
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#endif // ! SUCCEEDED
+
+#ifndef FAILED
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#endif // ! FAILED
+
+#ifndef _In_
+#define _In_
+#endif // ! _In_
+
+#ifndef _In_opt_
+#define _In_opt_
+#endif // ! _In_opt_
+
+#ifndef _In_reads_
+#define _In_reads_(size)
+#endif // ! _In_reads_
+
+#ifndef _Out_
+#define _Out_
+#endif // ! _Out_
+
+#ifndef _Inout_
+#define _Inout_
+#endif // ! _Inout_
+
+#endif // _WIN32
+
+/*--------------------------------------------------------------------
+  Opaque handles of the Direct3D 11 state objects. Only D3D11 backends
+  dereference them, through d3d11.h, which completes the same types
+--------------------------------------------------------------------*/
+struct ID3D11Resource;
+struct ID3D11Buffer;
+struct ID3D11InputLayout;
+struct ID3D11VertexShader;
+struct ID3D11PixelShader;
+struct ID3D11ClassInstance;
+struct ID3D11ShaderResourceView;
+struct ID3D11SamplerState;
+struct ID3D11RenderTargetView;
+struct ID3D11DepthStencilView;
+struct D3D11_VIEWPORT;
+struct D3D11_BOX;
@@ -17,7 +17,7 @@ namespace library
                   Default color to shader the renderable
 
       Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
-                 m_normalBuffer, m_aMeshes, m_aMaterials, m_vertexShader,
+                 m_normalBuffer, m_mesh, m_aMeshes, m_aMaterials, m_vertexShader,
                  m_pixelShader, m_outputColor, m_world, m_bHasNormalMap
                  m_aNormalData].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
@@ -26,6 +26,7 @@ namespace library
         , m_indexBuffer(nullptr)
         , m_constantBuffer(nullptr)
         , m_normalBuffer(nullptr)
+        , m_mesh()
         , m_aMeshes()
         , m_aMaterials()
         , m_aNormalData()
@@ -104,7 +105,7 @@ namespace library
 
             D3D11_SUBRESOURCE_DATA initData =
             {
-                .pSysMem = getVertices(),
+                .pSysMem = m_aNormalData.data(),
                 .SysMemPitch = 0u,
                 .SysMemSlicePitch = 0u
             };
@@ -138,22 +139,95 @@ namespace library
         }
         
         // Create ConstantBuffer
+        hr = initializeConstantBuffer(pDevice);
+        if (FAILED(hr))
+            return hr;
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::initializeShared
+
+      Summary:  Initializes like initialize, but takes the geometry
+                buffers from MeshRegistry so renderables with the same
+                vertices and indices share them. For small meshes in
+                static arrays only, see MeshRegistry
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer
+                 m_mesh, m_constantBuffer, m_aNormalData].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderable::initializeShared(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        if (pDevice == nullptr || pImmediateContext == nullptr)
+            return E_INVALIDARG;
+
+        HRESULT hr = S_OK;
+
+        if (m_aNormalData.empty() == true)
         {
-            // TIP : D3D11_USAGE_DYNAMIC ޸  == size   ϴ ſ. ׳  ƴ϶.
-            D3D11_BUFFER_DESC bd =
-            {
-                .ByteWidth = sizeof(CBChangesEveryFrame),
-                .Usage = D3D11_USAGE_DEFAULT,
-                .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-                .CPUAccessFlags = 0u,
-                .MiscFlags = 0u,
-                .StructureByteStride = 0u
-            };
-            hr = pDevice->CreateBuffer(&bd, 0, m_constantBuffer.GetAddressOf());
-            if (FAILED(hr))
-                return hr;
+            calculateNormalMapVectors();
         }
 
+        hr = MeshRegistry::Acquire(pDevice, getVertices(), GetNumVertices(), getIndices(), GetNumIndices(), m_aNormalData.data(), m_mesh);
+        if (FAILED(hr))
+            return hr;
+
+        m_vertexBuffer = m_mesh->VertexBuffer;
+        m_normalBuffer = m_mesh->NormalBuffer;
+        m_indexBuffer = m_mesh->IndexBuffer;
+
+        // Create ConstantBuffer
+        hr = initializeConstantBuffer(pDevice);
+        if (FAILED(hr))
+            return hr;
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::initializeConstantBuffer
+
+      Summary:  Creates the per object constant buffer. Renderables
+                that share their geometry buffers only need this one
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+
+      Modifies: [m_constantBuffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderable::initializeConstantBuffer(_In_ ID3D11Device* pDevice)
+    {
+        if (pDevice == nullptr)
+            return E_INVALIDARG;
+
+        HRESULT hr = S_OK;
+
+        // TIP : D3D11_USAGE_DYNAMIC ޸  == size   ϴ ſ. ׳  ƴ϶.
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBChangesEveryFrame),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u,
+            .StructureByteStride = 0u
+        };
+        hr = pDevice->CreateBuffer(&bd, 0, m_constantBuffer.GetAddressOf());
+        if (FAILED(hr))
+            return hr;
+
         return hr;
     }
 
@@ -376,6 +450,35 @@ namespace library
         return m_vertexShader->GetVertexLayout();
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetBatchVertexShader
+
+      Summary:  Returns the instanced batch variant of the vertex
+                shader, used when other renderables share the mesh
+                and shaders
+
+      Returns:  ComPtr<ID3D11VertexShader>&
+                  Batch vertex shader. Could be a nullptr
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11VertexShader>& Renderable::GetBatchVertexShader()
+    {
+        return m_vertexShader->GetBatchVertexShader();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetBatchVertexLayout
+
+      Summary:  Returns the input layout of the batch variant of the
+                vertex shader
+
+      Returns:  ComPtr<ID3D11InputLayout>&
+                  Batch vertex input layout. Could be a nullptr
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11InputLayout>& Renderable::GetBatchVertexLayout()
+    {
+        return m_vertexShader->GetBatchVertexLayout();
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetVertexBuffer
 
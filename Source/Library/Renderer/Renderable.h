@@ -14,6 +14,7 @@
 #include "Common.h"
 
 #include "Renderer/DataTypes.h"
+#include "Renderer/MeshRegistry.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Texture/Material.h"
@@ -38,6 +39,11 @@ namespace library
                   Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
+                GetBatchVertexShader
+                  Returns the instanced batch variant of the vertex
+                  shader
+                GetBatchVertexLayout
+                  Returns the input layout of the batch variant
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
@@ -54,7 +60,6 @@ namespace library
     public:
         static constexpr const UINT INVALID_MATERIAL = (0xFFFFFFFF);
 
-    protected:
         struct BasicMeshEntry
         {
             BasicMeshEntry()
@@ -91,6 +96,8 @@ namespace library
         ComPtr<ID3D11VertexShader>& GetVertexShader();
         ComPtr<ID3D11PixelShader>& GetPixelShader();
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
+        ComPtr<ID3D11VertexShader>& GetBatchVertexShader();
+        ComPtr<ID3D11InputLayout>& GetBatchVertexLayout();
         ComPtr<ID3D11Buffer>& GetVertexBuffer();
         ComPtr<ID3D11Buffer>& GetIndexBuffer();
         ComPtr<ID3D11Buffer>& GetConstantBuffer();
@@ -123,6 +130,11 @@ namespace library
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext
             );
+        HRESULT initializeShared(
+            _In_ ID3D11Device* pDevice,
+            _In_ ID3D11DeviceContext* pImmediateContext
+            );
+        HRESULT initializeConstantBuffer(_In_ ID3D11Device* pDevice);
 
         void calculateNormalMapVectors();
         void calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
@@ -132,6 +144,7 @@ namespace library
         ComPtr<ID3D11Buffer> m_indexBuffer;
         ComPtr<ID3D11Buffer> m_constantBuffer;
         ComPtr<ID3D11Buffer> m_normalBuffer;
+        std::shared_ptr<const SharedMesh> m_mesh;
 
         std::vector<BasicMeshEntry> m_aMeshes;
         std::vector<std::shared_ptr<Material>> m_aMaterials;
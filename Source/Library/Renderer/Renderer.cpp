@@ -1,5 +1,13 @@
 #include "Renderer/Renderer.h"
 
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <tuple>
+
+#include "Renderer/D3D11RenderCommandList.h"
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -10,8 +18,14 @@ namespace library
       Modifies: [m_driverType, m_featureLevel, m_d3dDevice, m_d3dDevice1,
                   m_immediateContext, m_immediateContext1, m_swapChain,
                   m_swapChain1, m_renderTargetView, m_depthStencil,
-                  m_depthStencilView, m_cbChangeOnResize, m_cbShadowMatrix,
-                  m_pszMainSceneName, m_camera, m_projection, m_scenes
+                  m_depthStencilView, m_viewport, m_commandList,
+                  m_aDeferredCommandLists, m_cbChangeOnResize,
+                  m_cbShadowMatrix,
+                  m_pszMainSceneName, m_camera, m_projection,
+                  m_cameraConstants, m_aLightConstants, m_bIsResized,
+                  m_drawQueue, m_uMaxRecordingThreads,
+                  m_aBatchedRenderables, m_aBatchInstanceData,
+                  m_batchInstanceBuffer, m_uBatchInstanceCapacity, m_scenes
                   m_invalidTexture, m_shadowMapTexture, m_shadowVertexShader,
                   m_shadowPixelShader].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
@@ -28,12 +42,24 @@ namespace library
         , m_renderTargetView()
         , m_depthStencil()
         , m_depthStencilView()
+        , m_viewport()
+        , m_commandList()
+        , m_aDeferredCommandLists()
         , m_cbChangeOnResize()
         , m_cbShadowMatrix()
         , m_pszMainSceneName(nullptr)
         , m_padding{ '\0' }
         , m_camera(XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f))
         , m_projection()
+        , m_cameraConstants()
+        , m_aLightConstants()
+        , m_bIsResized(TRUE)
+        , m_drawQueue()
+        , m_uMaxRecordingThreads(std::thread::hardware_concurrency())
+        , m_aBatchedRenderables()
+        , m_aBatchInstanceData()
+        , m_batchInstanceBuffer()
+        , m_uBatchInstanceCapacity(0u)
         , m_scenes()
         , m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png"))
         , m_shadowMapTexture()
@@ -54,7 +80,8 @@ namespace library
                   m_d3dDevice1, m_immediateContext1, m_swapChain1,
                   m_swapChain, m_renderTargetView, m_vertexShader,
                   m_vertexLayout, m_pixelShader, m_vertexBuffer
-                  m_cbShadowMatrix].
+                  m_viewport, m_commandList, m_cbShadowMatrix,
+                  m_projection, m_bIsResized].
 
       Returns:  HRESULT
                   Status code
@@ -235,7 +262,7 @@ namespace library
         m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
 
         // Setup the viewport
-        D3D11_VIEWPORT vp =
+        m_viewport =
         {
             .TopLeftX = 0.0f,
             .TopLeftY = 0.0f,
@@ -244,11 +271,14 @@ namespace library
             .MinDepth = 0.0f,
             .MaxDepth = 1.0f,
         };
-        m_immediateContext->RSSetViewports(1, &vp);
+        m_immediateContext->RSSetViewports(1, &m_viewport);
 
         // Set primitive topology
         m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
+        // Frames are recorded into the command list
+        m_commandList = std::make_shared<D3D11RenderCommandList>(m_d3dDevice.Get(), m_immediateContext.Get(), m_swapChain.Get());
+
         // Create the constant buffers
         D3D11_BUFFER_DESC bd =
         {
@@ -263,14 +293,9 @@ namespace library
             return hr;
         }
 
-        // Initialize the projection matrix
+        // Initialize the projection matrix, uploaded by the first Render
         m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
-
-        CBChangeOnResize cbChangesOnResize =
-        {
-            .Projection = XMMatrixTranspose(m_projection)
-        };
-        m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0, nullptr, &cbChangesOnResize, 0, 0);
+        m_bIsResized = TRUE;
 
         bd.ByteWidth = sizeof(CBLights) * NUM_LIGHTS;
         bd.Usage = D3D11_USAGE_DEFAULT;
@@ -420,6 +445,41 @@ namespace library
         m_shadowPixelShader = move(pixelShader);
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetCommandList
+
+      Summary:  Set the backend Render and RenderSceneToTexture record
+                into. Initialize sets a Direct3D 11 backend, a
+                NullRenderCommandList records frames without a device
+
+      Args:     std::shared_ptr<RenderCommandList> commandList
+                  backend
+
+      Modifies: [m_commandList, m_aDeferredCommandLists].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetCommandList(_In_ std::shared_ptr<RenderCommandList> commandList)
+    {
+        m_commandList = move(commandList);
+        m_aDeferredCommandLists.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::SetMaxRecordingThreads
+
+      Summary:  Set how many threads may record the draw packets of a
+                frame, each into its own deferred command list. 1
+                records every packet on the calling thread
+
+      Args:     UINT uMaxRecordingThreads
+                  Largest number of recording threads
+
+      Modifies: [m_uMaxRecordingThreads].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::SetMaxRecordingThreads(_In_ UINT uMaxRecordingThreads)
+    {
+        m_uMaxRecordingThreads = uMaxRecordingThreads;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::HandleInput
 
@@ -447,6 +507,16 @@ namespace library
         m_scenes[m_pszMainSceneName]->Update(deltaTime);
 
         m_camera.Update(deltaTime);
+
+        m_scenes[m_pszMainSceneName]->UpdateAnimations(m_camera.GetEye());
+        HRESULT hr = m_scenes[m_pszMainSceneName]->UpdateTerrainStreaming(m_d3dDevice.Get(), m_immediateContext.Get(), m_camera.GetEye());
+        if (FAILED(hr))
+        {
+            // The chunks stay resident and their ranges dirty, the next frame uploads them again
+            WCHAR szDebugMessage[128];
+            swprintf_s(szDebugMessage, L"Renderer: terrain streaming upload failed (0x%08X)\n", static_cast<UINT>(hr));
+            OutputDebugString(szDebugMessage);
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -458,218 +528,105 @@ namespace library
     {
         //RenderSceneToTexture();
         //Draw ~ Present ̿  ǳ .
-        m_immediateContext->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);    
+        m_commandList->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
+        m_commandList->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);    
 
-        UINT strides[3] =
+        std::shared_ptr<library::Scene> scene = m_scenes[m_pszMainSceneName];
+
+        updateFrameConstants(*scene);
+
+        // Objects near the eye have a smaller depth and are drawn first within the same state
+        XMMATRIX viewProjection = m_camera.GetView() * m_projection;
+        auto getDepth = [&viewProjection](const XMMATRIX& world)
         {
-            static_cast<UINT>(sizeof(SimpleVertex)),
-            static_cast<UINT>(sizeof(NormalData)),
-            static_cast<UINT>(sizeof(AnimationData))
+            return XMVectorGetZ(XMVector3TransformCoord(world.r[3], viewProjection));
         };
-        UINT offsets[3] = { 0u };
-        std::shared_ptr<library::Scene> scene = m_scenes[m_pszMainSceneName];
+
+        m_drawQueue.Clear();
 
         // Skybox.
         if (scene->GetSkyBox() != nullptr)
         {
-            m_immediateContext->IASetVertexBuffers(0u, 1u, scene->GetSkyBox()->GetVertexBuffer().GetAddressOf(), &strides[0], &offsets[0]);
-            m_immediateContext->IASetInputLayout(scene->GetSkyBox()->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(scene->GetSkyBox()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
-
-            CBChangeOnCameraMovement cb0 =
-            {
-                .View = m_camera.GetView(),
-            };
-            XMStoreFloat4(&cb0.CameraPosition, m_camera.GetEye());
-            CBChangeOnResize cb1 =  //QUESTION : projection  ͵  ǳ? initialize ߴµ.
-            {
-                .Projection = m_projection
-            };
+            std::shared_ptr<Skybox>& skybox = scene->GetSkyBox();
 
             CBChangesEveryFrame cb2 =
             {
-                .World =  scene->GetSkyBox()->GetWorldMatrix(),
-                .OutputColor = scene->GetSkyBox()->GetOutputColor(),
-                .HasNormalMap = scene->GetSkyBox()->HasNormalMap()
+                .World = skybox->GetWorldMatrix(),
+                .OutputColor = skybox->GetOutputColor(),
+                .HasNormalMap = skybox->HasNormalMap()
             };
             cb2.World *= XMMatrixTranslationFromVector(m_camera.GetEye());
 
-            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
-            {
-                FLOAT attenuationDistance = scene->GetPointLight(i)->GetAttenuationDistance();
-                FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
-
-                CBLights cb3 =
-                {
-                    //.LightPositions = scene->GetPointLight(0)->GetPosition(),
-                    //.LightColors = scene->GetPointLight(0)->GetColor(),    //ʹ ġ ʿ X.
-                    //.LightViews = scene->GetPointLight(0)->GetViewMatrix(),
-                    //.LightProjections = scene->GetPointLight(0)->GetProjectionMatrix()
-                    .Position = scene->GetPointLight(i)->GetPosition(),
-                    .Color = scene->GetPointLight(i)->GetColor(),
-                    .AttenuationDistance = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared),
-                };
-
-                m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cb3, 0u, 0u);
-            }
-
             //Transpose
-            cb0.View = XMMatrixTranspose(cb0.View);
-            cb1.Projection = XMMatrixTranspose(cb1.Projection);
             cb2.World = XMMatrixTranspose(cb2.World);
-            /*cb3.LightViews[0] = XMMatrixTranspose(cb3.LightViews[0]);
-            cb3.LightProjections[0] = XMMatrixTranspose(cb3.LightProjections[0]);*/
-
-            m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cb0, 0u, 0u);
-            m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0u, nullptr, &cb1, 0u, 0u);
-            m_immediateContext->UpdateSubresource(scene->GetSkyBox()->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
-            //m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cb3, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, scene->GetSkyBox()->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+            m_commandList->UpdateSubresource(skybox->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
 
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, scene->GetSkyBox()->GetConstantBuffer().GetAddressOf());    //TIP :  ߴ; PS  Ŷ PS  ȴ.
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->VSSetShader(scene->GetSkyBox()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(scene->GetSkyBox()->GetPixelShader().Get(), nullptr, 0u);
+            DrawPacket packet =
+            {
+                .aVertexBuffers = { skybox->GetVertexBuffer().Get() },
+                .aStrides = { static_cast<UINT>(sizeof(SimpleVertex)) },
+                .uNumVertexBuffers = 1u,
+                .pInputLayout = skybox->GetVertexLayout().Get(),
+                .pIndexBuffer = skybox->GetIndexBuffer().Get(),
+                .pConstantBuffer = skybox->GetConstantBuffer().Get(),
+                .pVertexShader = skybox->GetVertexShader().Get(),
+                .pPixelShader = skybox->GetPixelShader().Get(),
+                .uNumIndices = skybox->GetNumIndices()
+            };
 
-            if (scene->GetSkyBox()->HasTexture())
+            if (skybox->HasTexture())
             {
-                for (UINT i = 0u; i < scene->GetSkyBox()->GetNumMeshes(); ++i)
+                for (UINT i = 0u; i < skybox->GetNumMeshes(); ++i)
                 {
-                    UINT materialIndex = scene->GetSkyBox()->GetMesh(i).uMaterialIndex;    //TIP : (Ʋ )  material ٸ mesh ϴ 쵵 ִ. ׷ number ؾ Ѵ. ׳  0 ϴ  ƴ϶.
-                    eTextureSamplerType textureSamplerType = scene->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-                    if (scene->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse)
+                    UINT materialIndex = skybox->GetMesh(i).uMaterialIndex;
+                    DrawPacket meshPacket = packet;
+                    if (skybox->GetMaterial(materialIndex)->pDiffuse)
                     {
-                        m_immediateContext->PSSetShaderResources(2u, 1u, scene->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
+                        eTextureSamplerType textureSamplerType = skybox->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+                        meshPacket.aShaderResourceViews[2] = skybox->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().Get();
+                        meshPacket.aSamplers[0] = Texture::s_samplers[static_cast<size_t>(textureSamplerType)].Get();
                     }
-                    m_immediateContext->DrawIndexed(
-                        scene->GetSkyBox()->GetMesh(i).uNumIndices
-                        , scene->GetSkyBox()->GetMesh(i).uBaseIndex
-                        , scene->GetSkyBox()->GetMesh(i).uBaseVertex);  //TIP :  buffer ¼ warning   ? װ   ߴµ..
+                    meshPacket.uNumIndices = skybox->GetMesh(i).uNumIndices;
+                    meshPacket.uBaseIndex = skybox->GetMesh(i).uBaseIndex;
+                    meshPacket.baseVertex = static_cast<INT>(skybox->GetMesh(i).uBaseVertex);
+
+                    m_drawQueue.Add(eDrawPass::SKY, meshPacket, 0.0f);
                 }
             }
             else
             {
-                m_immediateContext->DrawIndexed(scene->GetSkyBox()->GetNumIndices(), 0u, 0);
+                m_drawQueue.Add(eDrawPass::SKY, packet, 0.0f);
             }
         }
 
-        for (auto renderable : scene->GetRenderables())
+        // Renderables reflect the skybox.
+        ID3D11ShaderResourceView* pEnvironmentView = nullptr;
+        ID3D11SamplerState* pEnvironmentSampler = nullptr;
+        if (scene->GetSkyBox() != nullptr && scene->GetSkyBox()->GetMaterial(0) && scene->GetSkyBox()->GetMaterial(0)->pDiffuse)
         {
-            ComPtr<ID3D11Buffer> vertexNormalBuffers[2] =
-            {
-                renderable.second->GetVertexBuffer(),
-                renderable.second->GetNormalBuffer()
-            };
-
-            m_immediateContext->IASetVertexBuffers(0u, 2u, vertexNormalBuffers->GetAddressOf(), strides, offsets);
-            m_immediateContext->IASetInputLayout(renderable.second->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
-            
-            CBChangeOnCameraMovement cb0 =
-            {
-                .View = m_camera.GetView(),
-            };
-            XMStoreFloat4(&cb0.CameraPosition, m_camera.GetEye());
-            CBChangeOnResize cb1 =  //QUESTION : projection  ͵  ǳ? initialize ߴµ
-            {
-                .Projection = m_projection
-            };
-
-            CBChangesEveryFrame cb2 =
-            {
-                .World = renderable.second->GetWorldMatrix(),
-                .OutputColor = renderable.second->GetOutputColor(),
-                .HasNormalMap = renderable.second->HasNormalMap()
-            };
-            
-            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
-            {
-                FLOAT attenuationDistance = scene->GetPointLight(i)->GetAttenuationDistance();
-                FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
-
-                CBLights cb3 =
-                {
-                    //.LightPositions = scene->GetPointLight(0)->GetPosition(),
-                    //.LightColors = scene->GetPointLight(0)->GetColor(),    //ʹ ġ ʿ X.
-                    //.LightViews = scene->GetPointLight(0)->GetViewMatrix(),
-                    //.LightProjections = scene->GetPointLight(0)->GetProjectionMatrix()
-                    .Position = scene->GetPointLight(i)->GetPosition(),
-                    .Color = scene->GetPointLight(i)->GetColor(),
-                    .AttenuationDistance = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared),
-                };
-
-                m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cb3, 0u, 0u);
-            }
+            eTextureSamplerType textureSamplerType = scene->GetSkyBox()->GetMaterial(0)->pDiffuse->GetSamplerType();
+            pEnvironmentView = scene->GetSkyBox()->GetMaterial(0)->pDiffuse->GetTextureResourceView().Get();
+            pEnvironmentSampler = Texture::s_samplers[static_cast<size_t>(textureSamplerType)].Get();
+        }
 
-            //Transpose
-            cb0.View = XMMatrixTranspose(cb0.View);
-            cb1.Projection = XMMatrixTranspose(cb1.Projection);
-            cb2.World = XMMatrixTranspose(cb2.World);
-            /*cb3.LightViews[0] = XMMatrixTranspose(cb3.LightViews[0]);
-            cb3.LightProjections[0] = XMMatrixTranspose(cb3.LightProjections[0]);*/
-            
-            m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cb0, 0u, 0u);
-            m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0u, nullptr, &cb1, 0u, 0u);
-            m_immediateContext->UpdateSubresource(renderable.second->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
-            //m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cb3, 0u, 0u);
-            
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, renderable.second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, renderable.second->GetConstantBuffer().GetAddressOf());    //TIP :  ߴ; PS  Ŷ PS  ȴ.
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->VSSetShader(renderable.second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(renderable.second->GetPixelShader().Get(), nullptr, 0u);
-
-            if (scene->GetSkyBox() != nullptr)
+        // Renderables whose vertex shader has a batch variant may share one draw with others of the same mesh
+        m_aBatchedRenderables.clear();
+        for (auto renderable : scene->GetRenderables())
+        {
+            if (renderable.second->GetBatchVertexShader())
             {
-                if (scene->GetSkyBox()->GetMaterial(0))
-                {
-                    eTextureSamplerType textureSamplerType = scene->GetSkyBox()->GetMaterial(0)->pDiffuse->GetSamplerType();
-                    m_immediateContext->PSSetShaderResources(2u, 1u, scene->GetSkyBox()->GetMaterial(0)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                }
+                m_aBatchedRenderables.push_back(renderable.second.get());
+                continue;
             }
 
-            m_immediateContext->DrawIndexed(renderable.second->GetNumIndices(), 0u, 0u);
+            addRenderable(*renderable.second, getDepth(renderable.second->GetWorldMatrix()), pEnvironmentView, pEnvironmentSampler);
         }
-        
+        addBatches(viewProjection, pEnvironmentView, pEnvironmentSampler);
+
         // Model.
         for (auto model : scene->GetModels())
         {
-            ComPtr<ID3D11Buffer> vertexNormalAnimationBuffers[3] =
-            {
-                model.second->GetVertexBuffer(),
-                model.second->GetNormalBuffer(),
-                model.second->GetAnimationBuffer()
-            };
-
-            m_immediateContext->IASetVertexBuffers(0u, 3u, vertexNormalAnimationBuffers->GetAddressOf(), strides, offsets);
-            m_immediateContext->IASetInputLayout(model.second->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
-
-            CBChangeOnCameraMovement cb0 =
-            {
-                .View = m_camera.GetView(),
-            };
-            XMStoreFloat4(&cb0.CameraPosition, m_camera.GetEye());
-            CBChangeOnResize cb1 =
-            {
-                .Projection = m_projection
-            };
-
             CBChangesEveryFrame cb2 =
             {
                 .World = model.second->GetWorldMatrix(),
@@ -677,101 +634,57 @@ namespace library
                 .HasNormalMap = model.second->HasNormalMap()
             };
 
-            CBLights cb3[2];
-            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
-            {
-                FLOAT attenuationDistance = scene->GetPointLight(i)->GetAttenuationDistance();
-                FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
-
-                cb3[i].Position = scene->GetPointLight(i)->GetPosition();
-                cb3[i].Color = scene->GetPointLight(i)->GetColor();
-                cb3[i].AttenuationDistance = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared);
-            }
-
             //Transpose
-            cb0.View = XMMatrixTranspose(cb0.View);
-            cb1.Projection = XMMatrixTranspose(cb1.Projection);
             cb2.World = XMMatrixTranspose(cb2.World);
-            /*cb3.LightViews[0] = XMMatrixTranspose(cb3.LightViews[0]);
-            cb3.LightProjections[0] = XMMatrixTranspose(cb3.LightProjections[0]);*/
 
-            m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cb0, 0u, 0u);
-            m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0u, nullptr, &cb1, 0u, 0u);
-            m_immediateContext->UpdateSubresource(model.second->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
-            m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, cb3, 0u, 0u);
+            m_commandList->UpdateSubresource(model.second->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
 
-            ComPtr<ID3D11Buffer> lightBuffers[2] =
+            DrawPacket packet =
             {
-                m_cbLights,
-                m_cbLights,
+                .aVertexBuffers = { model.second->GetVertexBuffer().Get(), model.second->GetNormalBuffer().Get(), model.second->GetAnimationBuffer().Get() },
+                .aStrides = { static_cast<UINT>(sizeof(SimpleVertex)), static_cast<UINT>(sizeof(NormalData)), static_cast<UINT>(sizeof(AnimationData)) },
+                .uNumVertexBuffers = 3u,
+                .pInputLayout = model.second->GetVertexLayout().Get(),
+                .pIndexBuffer = model.second->GetIndexBuffer().Get(),
+                .pConstantBuffer = model.second->GetConstantBuffer().Get(),
+                .pVertexShader = model.second->GetVertexShader().Get(),
+                .pPixelShader = model.second->GetPixelShader().Get(),
+                .uNumIndices = model.second->GetNumIndices()
             };
-
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, model.second->GetConstantBuffer().GetAddressOf());
-            //m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, model.second->GetConstantBuffer().GetAddressOf());    //TIP :  ߴ; PS  Ŷ PS  ȴ.
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->VSSetShader(model.second->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(model.second->GetPixelShader().Get(), nullptr, 0u);
+            FLOAT depth = getDepth(model.second->GetWorldMatrix());
 
             if (model.second->HasTexture())
             {
                 for (UINT i = 0u; i < model.second->GetNumMeshes(); ++i)
                 {
-                    UINT materialIndex = model.second->GetMesh(i).uMaterialIndex;    //TIP : (Ʋ )  material ٸ mesh ϴ 쵵 ִ. ׷ number ؾ Ѵ. ׳  0 ϴ  ƴ϶.
+                    UINT materialIndex = model.second->GetMesh(i).uMaterialIndex;
+                    DrawPacket meshPacket = packet;
                     if (model.second->GetMaterial(materialIndex)->pDiffuse)
                     {
-                        m_immediateContext->PSSetShaderResources(0u, 1u, model.second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, model.second->GetMaterial(materialIndex)->pDiffuse->GetSamplerState().GetAddressOf());
+                        meshPacket.aShaderResourceViews[0] = model.second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().Get();
+                        meshPacket.aSamplers[0] = model.second->GetMaterial(materialIndex)->pDiffuse->GetSamplerState().Get();
                     }
                     if (model.second->GetMaterial(materialIndex)->pNormal)
                     {
-                        m_immediateContext->PSSetShaderResources(1u, 1u, model.second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(1u, 1u, model.second->GetMaterial(materialIndex)->pNormal->GetSamplerState().GetAddressOf());
+                        meshPacket.aShaderResourceViews[1] = model.second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().Get();
+                        meshPacket.aSamplers[1] = model.second->GetMaterial(materialIndex)->pNormal->GetSamplerState().Get();
                     }
-                    // Set Shadow ShaderResources & Samplers
-                    /*m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());*/
-                    m_immediateContext->DrawIndexed(
-                          model.second->GetMesh(i).uNumIndices
-                        , model.second->GetMesh(i).uBaseIndex
-                        , model.second->GetMesh(i).uBaseVertex);  //TIP :  buffer ¼ warning   ? װ   ߴµ..
+                    meshPacket.uNumIndices = model.second->GetMesh(i).uNumIndices;
+                    meshPacket.uBaseIndex = model.second->GetMesh(i).uBaseIndex;
+                    meshPacket.baseVertex = static_cast<INT>(model.second->GetMesh(i).uBaseVertex);
+
+                    m_drawQueue.Add(eDrawPass::SCENE, meshPacket, depth);
                 }
             }
             else
             {
-                m_immediateContext->DrawIndexed(model.second->GetNumIndices(), 0u, 0);
+                m_drawQueue.Add(eDrawPass::SCENE, packet, depth);
             }
         }
 
         // DrawInstanced
-        strides[2] = static_cast<UINT>(sizeof(InstanceData));
-        for (auto voxel : m_scenes[m_pszMainSceneName]->GetVoxels())
+        for (auto voxel : scene->GetVoxels())
         {
-            ComPtr<ID3D11Buffer> vertexNormalInstanceBuffer[3] =
-            {
-                voxel->GetVertexBuffer(),
-                voxel->GetNormalBuffer(),
-                voxel->GetInstanceBuffer()
-            };
-            m_immediateContext->IASetVertexBuffers(0u, 3u, vertexNormalInstanceBuffer->GetAddressOf(), strides, offsets);
-            m_immediateContext->IASetInputLayout(voxel->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(voxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-
-            CBChangeOnCameraMovement cb0 =
-            {
-                .View = m_camera.GetView(),
-            };
-            XMStoreFloat4(&cb0.CameraPosition, m_camera.GetEye());
-            CBChangeOnResize cb1 =
-            {
-                .Projection = m_projection
-            };
-
             CBChangesEveryFrame cb2 =
             {
                 .World = voxel->GetWorldMatrix(),
@@ -779,71 +692,117 @@ namespace library
                 .HasNormalMap = voxel->HasNormalMap()
             };
 
-            CBLights cb3 =
-            {
-                //.LightPositions = scene->GetPointLight(0)->GetPosition(),
-                //.LightColors = scene->GetPointLight(0)->GetColor(),    //ʹ ġ ʿ X.
-                //.LightViews = scene->GetPointLight(0)->GetViewMatrix(),
-                //.LightProjections = scene->GetPointLight(0)->GetProjectionMatrix()
-            };
-
             //Transpose
-            cb0.View = XMMatrixTranspose(cb0.View);
-            cb1.Projection = XMMatrixTranspose(cb1.Projection);
             cb2.World = XMMatrixTranspose(cb2.World);
-            /*cb3.LightViews[0] = XMMatrixTranspose(cb3.LightViews[0]);
-            cb3.LightProjections[0] = XMMatrixTranspose(cb3.LightProjections[0]);*/
 
-            m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cb0, 0u, 0u);
-            m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0u, nullptr, &cb1, 0u, 0u);
-            m_immediateContext->UpdateSubresource(voxel->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
-            m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cb3, 0u, 0u);
+            m_commandList->UpdateSubresource(voxel->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, voxel->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, voxel->GetConstantBuffer().GetAddressOf());    //TIP :  ߴ; PS  Ŷ PS  ȴ.
-            m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-            m_immediateContext->VSSetShader(voxel->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(voxel->GetPixelShader().Get(), nullptr, 0u);
+            DrawPacket packet =
+            {
+                .aVertexBuffers = { voxel->GetVertexBuffer().Get(), voxel->GetNormalBuffer().Get(), voxel->GetInstanceBuffer().Get() },
+                .aStrides = { static_cast<UINT>(sizeof(SimpleVertex)), static_cast<UINT>(sizeof(NormalData)), voxel->GetInstanceStride() },
+                .uNumVertexBuffers = 3u,
+                .pInputLayout = voxel->GetVertexLayout().Get(),
+                .pIndexBuffer = voxel->GetIndexBuffer().Get(),
+                .pConstantBuffer = voxel->GetConstantBuffer().Get(),
+                .pVertexShader = voxel->GetVertexShader().Get(),
+                .pPixelShader = voxel->GetPixelShader().Get(),
+                .uNumIndices = voxel->GetNumIndices(),
+                .bInstanced = TRUE,
+                .uNumInstances = voxel->GetNumInstances()
+            };
+            FLOAT depth = getDepth(voxel->GetWorldMatrix());
 
             if (voxel->HasTexture())
             {
                 for (UINT i = 0u; i < voxel->GetNumMaterials(); ++i)
                 {
-                    UINT materialIndex = voxel->GetMesh(i).uMaterialIndex;    //TIP : (Ʋ )  material ٸ mesh ϴ 쵵 ִ. ׷ number ؾ Ѵ. ׳  0 ϴ  ƴ϶.
+                    UINT materialIndex = voxel->GetMesh(i).uMaterialIndex;
+                    DrawPacket meshPacket = packet;
                     if (voxel->GetMaterial(materialIndex)->pDiffuse)
                     {
-                        m_immediateContext->PSSetShaderResources(0u, 1u, voxel->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, voxel->GetMaterial(materialIndex)->pDiffuse->GetSamplerState().GetAddressOf());
+                        meshPacket.aShaderResourceViews[0] = voxel->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().Get();
+                        meshPacket.aSamplers[0] = voxel->GetMaterial(materialIndex)->pDiffuse->GetSamplerState().Get();
                     }
                     if (voxel->GetMaterial(materialIndex)->pNormal)
                     {
-                        m_immediateContext->PSSetShaderResources(1u, 1u, voxel->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(1u, 1u, voxel->GetMaterial(materialIndex)->pNormal->GetSamplerState().GetAddressOf());
+                        meshPacket.aShaderResourceViews[1] = voxel->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().Get();
+                        meshPacket.aSamplers[1] = voxel->GetMaterial(materialIndex)->pNormal->GetSamplerState().Get();
                     }
-                    // Set Shadow ShaderResources & Samplers
-                    /*m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                    m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());*/
-                    m_immediateContext->DrawIndexedInstanced(
-                          voxel->GetMesh(i).uNumIndices
-                        , voxel->GetNumInstances()
-                        , voxel->GetMesh(i).uBaseIndex
-                        , voxel->GetMesh(i).uBaseVertex
-                        , 0u);  //TIP :  buffer ¼ warning   ? װ   ߴµ..
+                    meshPacket.uNumIndices = voxel->GetMesh(i).uNumIndices;
+                    meshPacket.uBaseIndex = voxel->GetMesh(i).uBaseIndex;
+                    meshPacket.baseVertex = static_cast<INT>(voxel->GetMesh(i).uBaseVertex);
+
+                    m_drawQueue.Add(eDrawPass::SCENE, meshPacket, depth);
                 }
             }
             else
             {
-                m_immediateContext->DrawIndexedInstanced(voxel->GetNumIndices(), voxel->GetNumInstances(), 0u, 0, 0u);
+                m_drawQueue.Add(eDrawPass::SCENE, packet, depth);
+            }
+        }
+
+        m_drawQueue.Sort();
+
+        // Each chunk of sorted packets is recorded by its own thread into a deferred list,
+        // constant buffers were already uploaded above so chunks only bind and draw
+        UINT uMaxChunks = m_uMaxRecordingThreads;
+        if (uMaxChunks > static_cast<UINT>(m_aDeferredCommandLists.size()))
+        {
+            while (m_aDeferredCommandLists.size() < uMaxChunks)
+            {
+                std::shared_ptr<RenderCommandList> deferredCommandList;
+                if (FAILED(m_commandList->CreateDeferredCommandList(deferredCommandList)))
+                {
+                    break;
+                }
+                m_aDeferredCommandLists.push_back(move(deferredCommandList));
+            }
+            if (m_aDeferredCommandLists.size() < uMaxChunks)
+            {
+                uMaxChunks = static_cast<UINT>(m_aDeferredCommandLists.size());
+            }
+        }
+
+        UINT uNumChunks = m_drawQueue.Split(uMaxChunks);
+        if (uNumChunks == 1u)
+        {
+            bindFrameState(*m_commandList);
+            m_drawQueue.SubmitChunk(0u, *m_commandList);
+        }
+        else
+        {
+            std::vector<UINT> aChunkIndices(uNumChunks);
+            std::iota(aChunkIndices.begin(), aChunkIndices.end(), 0u);
+            std::vector<HRESULT> aChunkResults(uNumChunks, S_OK);
+
+            std::for_each(std::execution::par, aChunkIndices.begin(), aChunkIndices.end(),
+                [this, &aChunkResults](UINT uChunk)
+                {
+                    RenderCommandList& deferredCommandList = *m_aDeferredCommandLists[uChunk];
+                    bindFrameState(deferredCommandList);
+                    m_drawQueue.SubmitChunk(uChunk, deferredCommandList);
+                    aChunkResults[uChunk] = deferredCommandList.Finish();
+                }
+            );
+
+            // Played back in key order, so the frame matches a single threaded one
+            for (UINT i = 0u; i < uNumChunks; ++i)
+            {
+                if (SUCCEEDED(aChunkResults[i]))
+                {
+                    m_commandList->Execute(*m_aDeferredCommandLists[i]);
+                }
+                else
+                {
+                    // The deferred list has nothing to play, so the chunk is recorded again here
+                    bindFrameState(*m_commandList);
+                    m_drawQueue.SubmitChunk(i, *m_commandList);
+                }
             }
         }
 
-        m_swapChain->Present(0, 0);
+        m_commandList->Present(0u, 0u);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -855,12 +814,12 @@ namespace library
     {
         //Unbind current pixel shader resources
         ComPtr<ID3D11ShaderResourceView> const pSRV[2] = { NULL, NULL };
-        m_immediateContext->PSSetShaderResources(0, 2, pSRV->GetAddressOf());
-        m_immediateContext->PSSetShaderResources(2, 1, pSRV->GetAddressOf());
+        m_commandList->PSSetShaderResources(0, 2, pSRV->GetAddressOf());
+        m_commandList->PSSetShaderResources(2, 1, pSRV->GetAddressOf());
 
-        m_immediateContext->OMSetRenderTargets(1, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
-        m_immediateContext->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+        m_commandList->OMSetRenderTargets(1, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
+        m_commandList->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
+        m_commandList->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
 
         UINT stride[3] =
         {
@@ -872,9 +831,9 @@ namespace library
 
         for (auto renderable : scene->GetRenderables())
         {
-            m_immediateContext->IASetVertexBuffers(0u, 1u, renderable.second->GetVertexBuffer().GetAddressOf(), &stride[0], &offset[0]);
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
+            m_commandList->IASetVertexBuffers(0u, 1u, renderable.second->GetVertexBuffer().GetAddressOf(), &stride[0], &offset[0]);
+            m_commandList->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            m_commandList->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
 
             CBShadowMatrix cb0 =
             {
@@ -889,21 +848,21 @@ namespace library
             cb0.View = XMMatrixTranspose(cb0.View);
             cb0.Projection = XMMatrixTranspose(cb0.Projection);
 
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cb0, 0u, 0u);
+            m_commandList->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cb0, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_commandList->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_commandList->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+            m_commandList->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+            m_commandList->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
 
             if (renderable.second->HasTexture())
             {
                 for (UINT i = 0u; i < renderable.second->GetNumMeshes(); ++i)
                 {
                     UINT materialIndex = renderable.second->GetMesh(i).uMaterialIndex;    //TIP : (Ʋ )  material ٸ mesh ϴ 쵵 ִ. ׷ number ؾ Ѵ. ׳  0 ϴ  ƴ϶.
-                    m_immediateContext->DrawIndexed(
+                    m_commandList->DrawIndexed(
                         renderable.second->GetMesh(i).uNumIndices
                         , renderable.second->GetMesh(i).uBaseIndex
                         , renderable.second->GetMesh(i).uBaseVertex);  //TIP :  buffer ¼ warning   ? װ   ߴµ..
@@ -911,16 +870,16 @@ namespace library
             }
             else
             {
-                m_immediateContext->DrawIndexed(renderable.second->GetNumIndices(), 0u, 0);
+                m_commandList->DrawIndexed(renderable.second->GetNumIndices(), 0u, 0);
             }
         }
 
         // Model.
         for (auto model : scene->GetModels())
         {
-            m_immediateContext->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &stride[0], &offset[0]);
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
+            m_commandList->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &stride[0], &offset[0]);
+            m_commandList->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            m_commandList->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);    //WORD R_16 .
 
             CBShadowMatrix cb0 =
             {
@@ -935,21 +894,21 @@ namespace library
             cb0.View = XMMatrixTranspose(cb0.View);
             cb0.Projection = XMMatrixTranspose(cb0.Projection);
 
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cb0, 0u, 0u);
+            m_commandList->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cb0, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_commandList->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_commandList->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+            m_commandList->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+            m_commandList->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
 
             if (model.second->HasTexture())
             {
                 for (UINT i = 0u; i < model.second->GetNumMeshes(); ++i)
                 {
                     UINT materialIndex = model.second->GetMesh(i).uMaterialIndex;    //TIP : (Ʋ )  material ٸ mesh ϴ 쵵 ִ. ׷ number ؾ Ѵ. ׳  0 ϴ  ƴ϶.
-                    m_immediateContext->DrawIndexed(
+                    m_commandList->DrawIndexed(
                         model.second->GetMesh(i).uNumIndices
                         , model.second->GetMesh(i).uBaseIndex
                         , model.second->GetMesh(i).uBaseVertex);  //TIP :  buffer ¼ warning   ? װ   ߴµ..
@@ -957,21 +916,22 @@ namespace library
             }
             else
             {
-                m_immediateContext->DrawIndexed(model.second->GetNumIndices(), 0u, 0);
+                m_commandList->DrawIndexed(model.second->GetNumIndices(), 0u, 0);
             }
         }
 
         // DrawInstanced
         for (auto voxel : m_scenes[m_pszMainSceneName]->GetVoxels())
         {
+            stride[1] = voxel->GetInstanceStride();
             ComPtr<ID3D11Buffer> vertexNormalInstanceBuffer[2] =
             {
                 voxel->GetVertexBuffer(),
                 voxel->GetInstanceBuffer()
             };
-            m_immediateContext->IASetVertexBuffers(0u, 2u, vertexNormalInstanceBuffer->GetAddressOf(), stride, offset);
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
-            m_immediateContext->IASetIndexBuffer(voxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+            m_commandList->IASetVertexBuffers(0u, 2u, vertexNormalInstanceBuffer->GetAddressOf(), stride, offset);
+            m_commandList->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            m_commandList->IASetIndexBuffer(voxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
 
             CBShadowMatrix cb0 =
             {
@@ -986,21 +946,21 @@ namespace library
             cb0.View = XMMatrixTranspose(cb0.View);
             cb0.Projection = XMMatrixTranspose(cb0.Projection);
 
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cb0, 0u, 0u);
+            m_commandList->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cb0, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_commandList->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_commandList->PSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
-            m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+            m_commandList->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
+            m_commandList->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
 
             if (voxel->HasTexture())
             {
                 for (UINT i = 0u; i < voxel->GetNumMaterials(); ++i)
                 {
                     UINT materialIndex = voxel->GetMesh(i).uMaterialIndex;    //TIP : (Ʋ )  material ٸ mesh ϴ 쵵 ִ. ׷ number ؾ Ѵ. ׳  0 ϴ  ƴ϶.
-                    m_immediateContext->DrawIndexedInstanced(
+                    m_commandList->DrawIndexedInstanced(
                         voxel->GetMesh(i).uNumIndices
                         , voxel->GetNumInstances()
                         , voxel->GetMesh(i).uBaseIndex
@@ -1010,11 +970,318 @@ namespace library
             }
             else
             {
-                m_immediateContext->DrawIndexedInstanced(voxel->GetNumIndices(), voxel->GetNumInstances(), 0u, 0, 0u);
+                m_commandList->DrawIndexedInstanced(voxel->GetNumIndices(), voxel->GetNumInstances(), 0u, 0, 0u);
             }
         }
 
-        m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+        m_commandList->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::updateFrameConstants
+
+      Summary:  Uploads the camera, projection and light constant buffers
+                when their contents changed since the last frame
+
+      Args:     Scene& scene
+                  Scene whose lights are uploaded
+
+      Modifies: [m_cameraConstants, m_aLightConstants, m_bIsResized].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::updateFrameConstants(_In_ Scene& scene)
+    {
+        CBChangeOnCameraMovement cb0 =
+        {
+            .View = XMMatrixTranspose(m_camera.GetView())
+        };
+        XMStoreFloat4(&cb0.CameraPosition, m_camera.GetEye());
+        if (m_bIsResized || memcmp(&cb0, &m_cameraConstants, sizeof(cb0)) != 0)
+        {
+            m_cameraConstants = cb0;
+            m_commandList->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &m_cameraConstants, 0u, 0u);
+        }
+
+        CBLights cb3[NUM_LIGHTS];
+        for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+        {
+            FLOAT attenuationDistance = scene.GetPointLight(i)->GetAttenuationDistance();
+            FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
+
+            cb3[i] =
+            {
+                .Position = scene.GetPointLight(i)->GetPosition(),
+                .Color = scene.GetPointLight(i)->GetColor(),
+                .AttenuationDistance = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared)
+            };
+        }
+        if (m_bIsResized || memcmp(cb3, m_aLightConstants, sizeof(cb3)) != 0)
+        {
+            memcpy(m_aLightConstants, cb3, sizeof(cb3));
+            m_commandList->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, m_aLightConstants, 0u, 0u);
+        }
+
+        if (m_bIsResized)
+        {
+            CBChangeOnResize cb1 =
+            {
+                .Projection = XMMatrixTranspose(m_projection)
+            };
+            m_commandList->UpdateSubresource(m_cbChangeOnResize.Get(), 0u, nullptr, &cb1, 0u, 0u);
+            m_bIsResized = FALSE;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::bindFrameState
+
+      Summary:  Binds the render targets, viewport, topology and the
+                camera, projection and light constant buffers every
+                object of the frame shares. Deferred lists start from
+                the default state, so each of them binds it again
+
+      Args:     RenderCommandList& commandList
+                  List the state is recorded into
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::bindFrameState(_In_ RenderCommandList& commandList)
+    {
+        commandList.OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+        commandList.RSSetViewports(1u, &m_viewport);
+        commandList.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+        commandList.VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        commandList.VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
+        commandList.VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+
+        commandList.PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
+        commandList.PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::addRenderable
+
+      Summary:  Uploads the constant buffer of a renderable and adds
+                its packet, drawn on its own
+
+      Args:     Renderable& renderable
+                  Renderable to draw
+                FLOAT depth
+                  Normalized depth of the renderable
+                ID3D11ShaderResourceView* pEnvironmentView
+                  Skybox texture the renderable reflects
+                ID3D11SamplerState* pEnvironmentSampler
+                  Sampler of the skybox texture
+
+      Modifies: [m_drawQueue].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::addRenderable(_In_ Renderable& renderable, _In_ FLOAT depth, _In_opt_ ID3D11ShaderResourceView* pEnvironmentView, _In_opt_ ID3D11SamplerState* pEnvironmentSampler)
+    {
+        CBChangesEveryFrame cb2 =
+        {
+            .World = renderable.GetWorldMatrix(),
+            .OutputColor = renderable.GetOutputColor(),
+            .HasNormalMap = renderable.HasNormalMap()
+        };
+
+        //Transpose
+        cb2.World = XMMatrixTranspose(cb2.World);
+
+        m_commandList->UpdateSubresource(renderable.GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
+
+        DrawPacket packet =
+        {
+            .aVertexBuffers = { renderable.GetVertexBuffer().Get(), renderable.GetNormalBuffer().Get() },
+            .aStrides = { static_cast<UINT>(sizeof(SimpleVertex)), static_cast<UINT>(sizeof(NormalData)) },
+            .uNumVertexBuffers = 2u,
+            .pInputLayout = renderable.GetVertexLayout().Get(),
+            .pIndexBuffer = renderable.GetIndexBuffer().Get(),
+            .pConstantBuffer = renderable.GetConstantBuffer().Get(),
+            .pVertexShader = renderable.GetVertexShader().Get(),
+            .pPixelShader = renderable.GetPixelShader().Get(),
+            .aShaderResourceViews = { nullptr, nullptr, pEnvironmentView },
+            .aSamplers = { pEnvironmentSampler },
+            .uNumIndices = renderable.GetNumIndices()
+        };
+
+        m_drawQueue.Add(eDrawPass::SCENE, packet, depth);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::addBatches
+
+      Summary:  Groups the renderables whose vertex shader has a batch
+                variant by mesh, shaders and normal map. A group of one
+                is drawn on its own. The others write their world
+                matrices and colors to the instance buffer and get one
+                instanced packet each, drawn with the batch variant
+
+      Args:     const XMMATRIX& viewProjection
+                  View projection matrix of the camera, for the depth
+                  of the nearest renderable of a group
+                ID3D11ShaderResourceView* pEnvironmentView
+                  Skybox texture the renderables reflect
+                ID3D11SamplerState* pEnvironmentSampler
+                  Sampler of the skybox texture
+
+      Modifies: [m_aBatchedRenderables, m_aBatchInstanceData,
+                  m_batchInstanceBuffer, m_uBatchInstanceCapacity,
+                  m_drawQueue].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::addBatches(_In_ const XMMATRIX& viewProjection, _In_opt_ ID3D11ShaderResourceView* pEnvironmentView, _In_opt_ ID3D11SamplerState* pEnvironmentSampler)
+    {
+        UINT uNumRenderables = static_cast<UINT>(m_aBatchedRenderables.size());
+        if (uNumRenderables == 0u)
+        {
+            return;
+        }
+
+        auto getBatchKey = [](Renderable* pRenderable)
+        {
+            return std::make_tuple(pRenderable->GetVertexBuffer().Get(), pRenderable->GetVertexShader().Get(), pRenderable->GetPixelShader().Get(), pRenderable->HasNormalMap());
+        };
+        std::sort(m_aBatchedRenderables.begin(), m_aBatchedRenderables.end(),
+            [&getBatchKey](Renderable* pLeft, Renderable* pRight)
+            {
+                return getBatchKey(pLeft) < getBatchKey(pRight);
+            }
+        );
+
+        auto getGroupEnd = [this, &getBatchKey, uNumRenderables](UINT uBegin)
+        {
+            UINT uEnd = uBegin + 1u;
+            while (uEnd < uNumRenderables && getBatchKey(m_aBatchedRenderables[uEnd]) == getBatchKey(m_aBatchedRenderables[uBegin]))
+            {
+                ++uEnd;
+            }
+
+            return uEnd;
+        };
+
+        UINT uNumInstances = 0u;
+        for (UINT uBegin = 0u, uEnd = 0u; uBegin < uNumRenderables; uBegin = uEnd)
+        {
+            uEnd = getGroupEnd(uBegin);
+            if (uEnd - uBegin > 1u)
+            {
+                uNumInstances += uEnd - uBegin;
+            }
+        }
+
+        // A null backend without a device records the batches without an instance buffer
+        if (m_d3dDevice && uNumInstances > 0u && (m_batchInstanceBuffer == nullptr || uNumInstances > m_uBatchInstanceCapacity))
+        {
+            m_uBatchInstanceCapacity = uNumInstances > m_uBatchInstanceCapacity * 2u ? uNumInstances : m_uBatchInstanceCapacity * 2u;
+
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = static_cast<UINT>(sizeof(BatchInstanceData)) * m_uBatchInstanceCapacity,
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = 0u
+            };
+
+            m_batchInstanceBuffer.Reset();
+            if (FAILED(m_d3dDevice->CreateBuffer(&bd, nullptr, m_batchInstanceBuffer.GetAddressOf())))
+            {
+                m_uBatchInstanceCapacity = 0u;
+                uNumInstances = 0u;
+            }
+        }
+
+        m_aBatchInstanceData.resize(uNumInstances);
+        UINT uBaseInstance = 0u;
+        for (UINT uBegin = 0u, uEnd = 0u; uBegin < uNumRenderables; uBegin = uEnd)
+        {
+            uEnd = getGroupEnd(uBegin);
+
+            // Without an instance buffer every renderable is drawn on its own
+            if (uEnd - uBegin == 1u || uNumInstances == 0u)
+            {
+                for (UINT i = uBegin; i < uEnd; ++i)
+                {
+                    FLOAT depth = XMVectorGetZ(XMVector3TransformCoord(m_aBatchedRenderables[i]->GetWorldMatrix().r[3], viewProjection));
+                    addRenderable(*m_aBatchedRenderables[i], depth, pEnvironmentView, pEnvironmentSampler);
+                }
+                continue;
+            }
+
+            Renderable* pFirst = m_aBatchedRenderables[uBegin];
+            FLOAT depth = 1.0f;
+            for (UINT i = uBegin; i < uEnd; ++i)
+            {
+                const XMMATRIX& world = m_aBatchedRenderables[i]->GetWorldMatrix();
+                m_aBatchInstanceData[uBaseInstance + i - uBegin] =
+                {
+                    .World = world,
+                    .OutputColor = m_aBatchedRenderables[i]->GetOutputColor()
+                };
+
+                FLOAT instanceDepth = XMVectorGetZ(XMVector3TransformCoord(world.r[3], viewProjection));
+                if (instanceDepth < depth)
+                {
+                    depth = instanceDepth;
+                }
+            }
+
+            // The instances hold the world matrices and colors, the constant buffer only the normal map flag
+            CBChangesEveryFrame cb2 =
+            {
+                .World = XMMatrixIdentity(),
+                .OutputColor = pFirst->GetOutputColor(),
+                .HasNormalMap = pFirst->HasNormalMap()
+            };
+            m_commandList->UpdateSubresource(pFirst->GetConstantBuffer().Get(), 0u, nullptr, &cb2, 0u, 0u);
+
+            DrawPacket packet =
+            {
+                .aVertexBuffers = { pFirst->GetVertexBuffer().Get(), pFirst->GetNormalBuffer().Get(), m_batchInstanceBuffer.Get() },
+                .aStrides = { static_cast<UINT>(sizeof(SimpleVertex)), static_cast<UINT>(sizeof(NormalData)), static_cast<UINT>(sizeof(BatchInstanceData)) },
+                .uNumVertexBuffers = 3u,
+                .pInputLayout = pFirst->GetBatchVertexLayout().Get(),
+                .pIndexBuffer = pFirst->GetIndexBuffer().Get(),
+                .pConstantBuffer = pFirst->GetConstantBuffer().Get(),
+                .pVertexShader = pFirst->GetBatchVertexShader().Get(),
+                .pPixelShader = pFirst->GetPixelShader().Get(),
+                .aShaderResourceViews = { nullptr, nullptr, pEnvironmentView },
+                .aSamplers = { pEnvironmentSampler },
+                .uNumIndices = pFirst->GetNumIndices(),
+                .bInstanced = TRUE,
+                .uNumInstances = uEnd - uBegin,
+                .uBaseInstance = uBaseInstance
+            };
+
+            m_drawQueue.Add(eDrawPass::SCENE, packet, depth);
+            uBaseInstance += uEnd - uBegin;
+        }
+
+        if (uNumInstances == 0u)
+        {
+            return;
+        }
+
+        D3D11_BOX box =
+        {
+            .left = 0u,
+            .top = 0u,
+            .front = 0u,
+            .right = static_cast<UINT>(sizeof(BatchInstanceData)) * uNumInstances,
+            .bottom = 1u,
+            .back = 1u
+        };
+        m_commandList->UpdateSubresource(m_batchInstanceBuffer.Get(), 0u, &box, m_aBatchInstanceData.data(), 0u, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetDrawQueueStats
+
+      Summary:  Returns the packets, chunks, draws and state changes
+                of the last rendered frame
+
+      Returns:  DrawQueueStats
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DrawQueueStats Renderer::GetDrawQueueStats() const
+    {
+        return m_drawQueue.GetStats();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
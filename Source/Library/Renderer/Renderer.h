@@ -17,6 +17,8 @@
 #include "Light/PointLight.h"
 #include "Model/Model.h"
 #include "Renderer/DataTypes.h"
+#include "Renderer/DrawQueue.h"
+#include "Renderer/RenderCommandList.h"
 #include "Renderer/Renderable.h"
 #include "Scene/Scene.h"
 #include "Shader/PixelShader.h"
@@ -41,6 +43,12 @@ namespace library
                   Update the renderables each frame
                 Render
                   Renders the frame
+                SetCommandList
+                  Sets the backend the frame is recorded into
+                SetMaxRecordingThreads
+                  Sets how many threads record the draw packets
+                GetDrawQueueStats
+                  Returns the draw counters of the last frame
                 GetDriverType
                   Returns the Direct3D driver type
                 Renderer
@@ -64,14 +72,23 @@ namespace library
         std::shared_ptr<Scene> GetSceneOrNull(_In_ PCWSTR pszSceneName);
         HRESULT SetMainScene(_In_ PCWSTR pszSceneName);
         void SetShadowMapShaders(_In_ std::shared_ptr<ShadowVertexShader> vertexShader, _In_ std::shared_ptr<PixelShader> pixelShader);
+        void SetCommandList(_In_ std::shared_ptr<RenderCommandList> commandList);
+        void SetMaxRecordingThreads(_In_ UINT uMaxRecordingThreads);
 
         void HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime);
         void Update(_In_ FLOAT deltaTime);
         void Render();
         void RenderSceneToTexture();
 
+        DrawQueueStats GetDrawQueueStats() const;
         D3D_DRIVER_TYPE GetDriverType() const;
 
+    private:
+        void updateFrameConstants(_In_ Scene& scene);
+        void bindFrameState(_In_ RenderCommandList& commandList);
+        void addRenderable(_In_ Renderable& renderable, _In_ FLOAT depth, _In_opt_ ID3D11ShaderResourceView* pEnvironmentView, _In_opt_ ID3D11SamplerState* pEnvironmentSampler);
+        void addBatches(_In_ const XMMATRIX& viewProjection, _In_opt_ ID3D11ShaderResourceView* pEnvironmentView, _In_opt_ ID3D11SamplerState* pEnvironmentSampler);
+
     private:
         D3D_DRIVER_TYPE m_driverType;
         D3D_FEATURE_LEVEL m_featureLevel;
@@ -84,6 +101,9 @@ namespace library
         ComPtr<ID3D11RenderTargetView> m_renderTargetView;
         ComPtr<ID3D11Texture2D> m_depthStencil;
         ComPtr<ID3D11DepthStencilView> m_depthStencilView;
+        D3D11_VIEWPORT m_viewport;
+        std::shared_ptr<RenderCommandList> m_commandList;
+        std::vector<std::shared_ptr<RenderCommandList>> m_aDeferredCommandLists;
         ComPtr<ID3D11Buffer> m_cbChangeOnResize;
         ComPtr<ID3D11Buffer> m_cbLights;
         ComPtr<ID3D11Buffer> m_cbShadowMatrix;
@@ -91,6 +111,15 @@ namespace library
         BYTE m_padding[8];
         Camera m_camera;
         XMMATRIX m_projection;
+        CBChangeOnCameraMovement m_cameraConstants;
+        CBLights m_aLightConstants[NUM_LIGHTS];
+        BOOL m_bIsResized;
+        DrawQueue m_drawQueue;
+        UINT m_uMaxRecordingThreads;
+        std::vector<Renderable*> m_aBatchedRenderables;
+        std::vector<BatchInstanceData> m_aBatchInstanceData;
+        ComPtr<ID3D11Buffer> m_batchInstanceBuffer;
+        UINT m_uBatchInstanceCapacity;
 
         std::unordered_map<std::wstring, std::shared_ptr<Scene>> m_scenes;
         std::shared_ptr<Texture> m_invalidTexture;
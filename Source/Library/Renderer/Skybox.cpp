@@ -63,6 +63,20 @@ namespace library
         return m_aMaterials[0]->pDiffuse;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::isAssetShared
+
+      Summary:  The skybox flips the winding of the sphere and replaces
+                its material, so it never shares the sphere asset
+
+      Returns:  BOOL
+                  FALSE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Skybox::isAssetShared() const
+    {
+        return FALSE;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Skybox::initSingleMesh
 
@@ -77,6 +91,11 @@ namespace library
     {
         const aiVector3D zero3d(0.0f, 0.0f, 0.0f);
 
+        // Each mesh writes its own slice of the presized arrays
+        SimpleVertex* pVertices = m_asset->aVertices.data() + m_aMeshes[uMeshIndex].uBaseVertex;
+        NormalData* pNormalData = m_aNormalData.data() + m_aMeshes[uMeshIndex].uBaseVertex;
+        WORD* pIndices = m_asset->aIndices.data() + m_aMeshes[uMeshIndex].uBaseIndex;
+
         for (UINT i = 0u; i < pMesh->mNumVertices; ++i)
         {
             const aiVector3D& position = pMesh->mVertices[i];
@@ -97,8 +116,8 @@ namespace library
                 .Tangent = XMFLOAT3(tangent.x, tangent.y, tangent.z),
                 .Bitangent = XMFLOAT3(bitangent.x, bitangent.y, bitangent.z)
             };
-            m_aVertices.push_back(vertex);
-            m_aNormalData.push_back(normalData);
+            pVertices[i] = vertex;
+            pNormalData[i] = normalData;
         }
 
         for (UINT i = 0u; i < pMesh->mNumFaces; ++i)
@@ -111,9 +130,9 @@ namespace library
                 static_cast<WORD>(face.mIndices[1]),
                 static_cast<WORD>(face.mIndices[0]),
             };
-            m_aIndices.push_back(aIndices[0]);
-            m_aIndices.push_back(aIndices[1]);
-            m_aIndices.push_back(aIndices[2]);
+            pIndices[i * 3u] = aIndices[0];
+            pIndices[i * 3u + 1u] = aIndices[1];
+            pIndices[i * 3u + 2u] = aIndices[2];
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "Scene/BiomeTable.h"
+
+#include <cfloat>
+#include <fstream>
+#include <sstream>
+
+#include "Scene/TerrainGenerator.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::BiomeTable
+
+      Summary:  Constructor. Sorts the moisture thresholds of every band
+                into one list of buckets and classifies one
+                representative cell of each band and bucket
+
+      Args:     const BiomeThresholds& thresholds
+                  Thresholds of the biomes, ascending
+
+      Modifies: [m_thresholds, m_aMoistureThresholds, m_aBlockTypes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BiomeTable::BiomeTable(_In_ const BiomeThresholds& thresholds)
+        : m_thresholds(thresholds)
+        , m_aMoistureThresholds()
+        , m_aBlockTypes()
+    {
+        assert(thresholds.OceanHeight <= thresholds.SandHeight);
+        assert(thresholds.SandHeight <= thresholds.MidlandHeight);
+        assert(thresholds.MidlandHeight <= thresholds.HighlandHeight);
+        assert(thresholds.HighlandHeight <= thresholds.MountainHeight);
+
+        FLOAT* pEnd = m_aMoistureThresholds;
+        pEnd = std::copy(std::begin(thresholds.MountainMoisture), std::end(thresholds.MountainMoisture), pEnd);
+        pEnd = std::copy(std::begin(thresholds.HighlandMoisture), std::end(thresholds.HighlandMoisture), pEnd);
+        pEnd = std::copy(std::begin(thresholds.MidlandMoisture), std::end(thresholds.MidlandMoisture), pEnd);
+        pEnd = std::copy(std::begin(thresholds.LowlandMoisture), std::end(thresholds.LowlandMoisture), pEnd);
+        assert(pEnd == std::end(m_aMoistureThresholds));
+
+        std::sort(m_aMoistureThresholds, pEnd);
+        pEnd = std::unique(m_aMoistureThresholds, pEnd);
+        UINT uNumThresholds = static_cast<UINT>(pEnd - m_aMoistureThresholds);
+
+        // No finite moisture reaches the padding buckets
+        std::fill(pEnd, std::end(m_aMoistureThresholds), FLT_MAX);
+
+        // Any height of a band takes the same branches of ClassifyBiome
+        const FLOAT aBandHeights[NUM_HEIGHT_BANDS] =
+        {
+            -FLT_MAX,
+            thresholds.OceanHeight,
+            thresholds.SandHeight,
+            thresholds.HighlandHeight,
+            thresholds.MountainHeight,
+            FLT_MAX
+        };
+
+        for (UINT uBand = 0u; uBand < NUM_HEIGHT_BANDS; ++uBand)
+        {
+            for (UINT uBucket = 0u; uBucket < NUM_MOISTURE_BUCKETS; ++uBucket)
+            {
+                UINT uLowerBound = uBucket < uNumThresholds ? uBucket : uNumThresholds;
+                FLOAT moisture = uLowerBound == 0u ? -FLT_MAX : m_aMoistureThresholds[uLowerBound - 1u];
+
+                m_aBlockTypes[uBand][uBucket] = static_cast<CHAR>(TerrainGenerator::ClassifyBiome(aBandHeights[uBand], moisture, thresholds));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::Classify
+
+      Summary:  Returns the block type of a cell
+
+      Args:     FLOAT height
+                  Normalized height of the cell
+                FLOAT moisture
+                  Normalized moisture of the cell
+
+      Returns:  eBlockType
+                  Block type of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eBlockType BiomeTable::Classify(_In_ FLOAT height, _In_ FLOAT moisture) const
+    {
+        return static_cast<eBlockType>(m_aBlockTypes[getHeightBand(height)][getMoistureBucket(moisture)]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::ClassifyCells
+
+      Summary:  Writes the block types of an array of cells. The loop
+                body is comparisons, adds and one table load, which the
+                compiler can vectorize up to the load
+
+      Args:     const FLOAT* pHeights
+                  Normalized heights of the cells
+                const FLOAT* pMoistures
+                  Normalized moistures of the cells
+                size_t uNumCells
+                  Number of cells
+                CHAR* pBlockTypes
+                  Block types of the cells
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void BiomeTable::ClassifyCells(_In_reads_(uNumCells) const FLOAT* pHeights, _In_reads_(uNumCells) const FLOAT* pMoistures, _In_ size_t uNumCells, _Out_writes_(uNumCells) CHAR* pBlockTypes) const
+    {
+        for (size_t i = 0u; i < uNumCells; ++i)
+        {
+            pBlockTypes[i] = m_aBlockTypes[getHeightBand(pHeights[i])][getMoistureBucket(pMoistures[i])];
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::GetThresholds
+
+      Summary:  Returns the thresholds of the table
+
+      Returns:  const BiomeThresholds&
+                  Thresholds of the table
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const BiomeThresholds& BiomeTable::GetThresholds() const
+    {
+        return m_thresholds;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::LoadThresholds
+
+      Summary:  Reads thresholds from a text file of "Name value ..."
+                lines named after the BiomeThresholds fields. Lines
+                starting with # are comments, thresholds missing from
+                the file keep their value
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the thresholds file
+                BiomeThresholds& thresholds
+                  Thresholds overwritten by the file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT BiomeTable::LoadThresholds(_In_ const std::filesystem::path& filePath, _Inout_ BiomeThresholds& thresholds)
+    {
+        std::ifstream inputFile;
+        inputFile.open(filePath.string());
+        if (!inputFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        // Written back only once the whole file parsed
+        BiomeThresholds loadedThresholds = thresholds;
+
+        struct ThresholdField
+        {
+            PCSTR pszName;
+            FLOAT* pValues;
+            UINT uNumValues;
+        };
+
+        const ThresholdField aFields[] =
+        {
+            { "OceanHeight", &loadedThresholds.OceanHeight, 1u },
+            { "SandHeight", &loadedThresholds.SandHeight, 1u },
+            { "MountainHeight", &loadedThresholds.MountainHeight, 1u },
+            { "HighlandHeight", &loadedThresholds.HighlandHeight, 1u },
+            { "MidlandHeight", &loadedThresholds.MidlandHeight, 1u },
+            { "MountainMoisture", loadedThresholds.MountainMoisture, ARRAYSIZE(loadedThresholds.MountainMoisture) },
+            { "HighlandMoisture", loadedThresholds.HighlandMoisture, ARRAYSIZE(loadedThresholds.HighlandMoisture) },
+            { "MidlandMoisture", loadedThresholds.MidlandMoisture, ARRAYSIZE(loadedThresholds.MidlandMoisture) },
+            { "LowlandMoisture", loadedThresholds.LowlandMoisture, ARRAYSIZE(loadedThresholds.LowlandMoisture) },
+        };
+
+        std::string line;
+        while (std::getline(inputFile, line))
+        {
+            std::istringstream lineStream(line);
+
+            std::string name;
+            if (!(lineStream >> name) || name[0] == '#')
+            {
+                continue;
+            }
+
+            const ThresholdField* pField = std::find_if(std::begin(aFields), std::end(aFields),
+                [&name](const ThresholdField& field)
+                {
+                    return name == field.pszName;
+                }
+            );
+            if (pField == std::end(aFields))
+            {
+                return E_FAIL;
+            }
+
+            for (UINT i = 0u; i < pField->uNumValues; ++i)
+            {
+                if (!(lineStream >> pField->pValues[i]))
+                {
+                    return E_FAIL;
+                }
+            }
+        }
+
+        thresholds = loadedThresholds;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::getHeightBand
+
+      Summary:  Returns the height band of a normalized height: ocean,
+                sand, lowland, midland, highland or mountain
+
+      Args:     FLOAT height
+                  Normalized height
+
+      Returns:  UINT
+                  Height band
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BiomeTable::getHeightBand(_In_ FLOAT height) const
+    {
+        return static_cast<UINT>(height >= m_thresholds.OceanHeight)
+            + static_cast<UINT>(height >= m_thresholds.SandHeight)
+            + static_cast<UINT>(height > m_thresholds.MidlandHeight)
+            + static_cast<UINT>(height > m_thresholds.HighlandHeight)
+            + static_cast<UINT>(height > m_thresholds.MountainHeight);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BiomeTable::getMoistureBucket
+
+      Summary:  Returns the number of moisture thresholds at or below a
+                normalized moisture
+
+      Args:     FLOAT moisture
+                  Normalized moisture
+
+      Returns:  UINT
+                  Moisture bucket
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT BiomeTable::getMoistureBucket(_In_ FLOAT moisture) const
+    {
+        UINT uBucket = 0u;
+        for (UINT i = 0u; i < MAX_MOISTURE_THRESHOLDS; ++i)
+        {
+            uBucket += static_cast<UINT>(moisture >= m_aMoistureThresholds[i]);
+        }
+
+        return uBucket;
+    }
+}
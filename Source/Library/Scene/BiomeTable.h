@@ -0,0 +1,93 @@
+/*+===================================================================
+  File:      BIOMETABLE.H
+
+  Summary:   BiomeTable header file contains declarations of the
+             lookup table that classifies the height and moisture of
+             the voxel terrain cells into block types for the lab
+             samples of Game Graphics Programming course.
+
+  Classes: BiomeTable
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   BiomeThresholds
+
+      Summary:  Normalized height bands and the moisture thresholds that
+                split each band into biomes, in ascending order
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BiomeThresholds
+    {
+        FLOAT OceanHeight;
+        FLOAT SandHeight;
+        FLOAT MountainHeight;
+        FLOAT HighlandHeight;
+        FLOAT MidlandHeight;
+        FLOAT MountainMoisture[3];
+        FLOAT HighlandMoisture[2];
+        FLOAT MidlandMoisture[3];
+        FLOAT LowlandMoisture[3];
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BiomeTable
+
+      Summary:  Height band x moisture bucket table of block types. The
+                band and the bucket of a cell are sums of comparisons
+                against the sorted thresholds, so classifying an array
+                of cells has no data dependent branches and only reads
+                the 72 byte table besides the inputs. The table is
+                filled from TerrainGenerator::ClassifyBiome and matches
+                it for any ascending thresholds
+
+      Methods:  Classify
+                  Returns the block type of a cell
+                ClassifyCells
+                  Writes the block types of an array of cells
+                GetThresholds
+                  Returns the thresholds of the table
+                LoadThresholds
+                  Reads thresholds from a text file
+                BiomeTable
+                  Constructor.
+                ~BiomeTable
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BiomeTable final
+    {
+    public:
+        static constexpr const UINT NUM_HEIGHT_BANDS = 6u;
+        static constexpr const UINT MAX_MOISTURE_THRESHOLDS = 11u;
+        static constexpr const UINT NUM_MOISTURE_BUCKETS = MAX_MOISTURE_THRESHOLDS + 1u;
+
+    public:
+        BiomeTable(_In_ const BiomeThresholds& thresholds);
+        BiomeTable(const BiomeTable& other) = delete;
+        BiomeTable(BiomeTable&& other) = delete;
+        BiomeTable& operator=(const BiomeTable& other) = delete;
+        BiomeTable& operator=(BiomeTable&& other) = delete;
+        ~BiomeTable() = default;
+
+        eBlockType Classify(_In_ FLOAT height, _In_ FLOAT moisture) const;
+        void ClassifyCells(_In_reads_(uNumCells) const FLOAT* pHeights, _In_reads_(uNumCells) const FLOAT* pMoistures, _In_ size_t uNumCells, _Out_writes_(uNumCells) CHAR* pBlockTypes) const;
+
+        const BiomeThresholds& GetThresholds() const;
+
+        static HRESULT LoadThresholds(_In_ const std::filesystem::path& filePath, _Inout_ BiomeThresholds& thresholds);
+
+    private:
+        UINT getHeightBand(_In_ FLOAT height) const;
+        UINT getMoistureBucket(_In_ FLOAT moisture) const;
+
+    private:
+        BiomeThresholds m_thresholds;
+        FLOAT m_aMoistureThresholds[MAX_MOISTURE_THRESHOLDS];
+        CHAR m_aBlockTypes[NUM_HEIGHT_BANDS][NUM_MOISTURE_BUCKETS];
+    };
+}
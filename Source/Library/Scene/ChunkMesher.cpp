@@ -0,0 +1,343 @@
+#include "Scene/ChunkMesher.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ChunkMesher::MeshChunk
+
+      Summary:  Meshes the columns [uBeginX, uBeginX + CHUNK_SIZE) x
+                [uBeginZ, uBeginZ + CHUNK_SIZE) of the height map. Top
+                faces are merged per (block type, height) on the xz
+                plane, side faces are merged per block type on each
+                vertical slice. Positions use the voxel grid of the
+                instanced path: a cube at (x, y, z) spans 2 units
+                around 2 * (x, y, z)
+
+      Args:     const HeightMapCell* pCells
+                  Column records in row-major order
+                UINT uWidth
+                  Number of columns along the x-axis
+                UINT uDepth
+                  Number of columns along the z-axis
+                UINT uBeginX
+                  First column of the chunk along the x-axis
+                UINT uBeginZ
+                  First column of the chunk along the z-axis
+                std::vector<TerrainMeshData>& aMeshes
+                  Receives the meshes of the chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ChunkMesher::MeshChunk(
+        _In_reads_(uWidth * uDepth) const HeightMapCell* pCells,
+        _In_ UINT uWidth,
+        _In_ UINT uDepth,
+        _In_ UINT uBeginX,
+        _In_ UINT uBeginZ,
+        _Out_ std::vector<TerrainMeshData>& aMeshes
+        )
+    {
+        aMeshes.clear();
+
+        const UINT uEndX = uBeginX + CHUNK_SIZE < uWidth ? uBeginX + CHUNK_SIZE : uWidth;
+        const UINT uEndZ = uBeginZ + CHUNK_SIZE < uDepth ? uBeginZ + CHUNK_SIZE : uDepth;
+        if (uBeginX >= uEndX || uBeginZ >= uEndZ)
+        {
+            return;
+        }
+
+        const UINT uSizeX = uEndX - uBeginX;
+        const UINT uSizeZ = uEndZ - uBeginZ;
+
+        std::vector<size_t> aCurrentMeshIndices(static_cast<size_t>(eBlockType::COUNT) - static_cast<size_t>(eBlockType::GRASSLAND), SIZE_MAX);
+
+        UINT uMaxHeight = 0u;
+        for (UINT z = uBeginZ; z < uEndZ; ++z)
+        {
+            for (UINT x = uBeginX; x < uEndX; ++x)
+            {
+                const HeightMapCell& cell = pCells[static_cast<size_t>(z) * uWidth + x];
+                if (isMeshable(cell) && cell.ColumnHeight > uMaxHeight)
+                {
+                    uMaxHeight = cell.ColumnHeight;
+                }
+            }
+        }
+
+        // Top faces
+        {
+            std::vector<BYTE> aIsMerged(static_cast<size_t>(uSizeX) * uSizeZ, FALSE);
+            for (UINT uLocalZ = 0u; uLocalZ < uSizeZ; ++uLocalZ)
+            {
+                for (UINT uLocalX = 0u; uLocalX < uSizeX; ++uLocalX)
+                {
+                    const HeightMapCell& cell = pCells[static_cast<size_t>(uBeginZ + uLocalZ) * uWidth + uBeginX + uLocalX];
+                    if (aIsMerged[static_cast<size_t>(uLocalZ) * uSizeX + uLocalX] || !isMeshable(cell) || cell.ColumnHeight == 0u)
+                    {
+                        continue;
+                    }
+
+                    auto isSameFace = [&](UINT uOtherX, UINT uOtherZ)
+                    {
+                        const HeightMapCell& other = pCells[static_cast<size_t>(uBeginZ + uOtherZ) * uWidth + uBeginX + uOtherX];
+                        return !aIsMerged[static_cast<size_t>(uOtherZ) * uSizeX + uOtherX] && other.BlockType == cell.BlockType && other.ColumnHeight == cell.ColumnHeight;
+                    };
+
+                    UINT uQuadWidth = 1u;
+                    while (uLocalX + uQuadWidth < uSizeX && isSameFace(uLocalX + uQuadWidth, uLocalZ))
+                    {
+                        ++uQuadWidth;
+                    }
+
+                    UINT uQuadDepth = 1u;
+                    while (uLocalZ + uQuadDepth < uSizeZ)
+                    {
+                        BOOL bIsRowSame = TRUE;
+                        for (UINT i = 0u; i < uQuadWidth && bIsRowSame; ++i)
+                        {
+                            bIsRowSame = isSameFace(uLocalX + i, uLocalZ + uQuadDepth);
+                        }
+                        if (!bIsRowSame)
+                        {
+                            break;
+                        }
+                        ++uQuadDepth;
+                    }
+
+                    for (UINT j = 0u; j < uQuadDepth; ++j)
+                    {
+                        for (UINT i = 0u; i < uQuadWidth; ++i)
+                        {
+                            aIsMerged[static_cast<size_t>(uLocalZ + j) * uSizeX + uLocalX + i] = TRUE;
+                        }
+                    }
+
+                    appendQuad(
+                        aMeshes,
+                        aCurrentMeshIndices,
+                        cell.BlockType,
+                        XMFLOAT3(static_cast<FLOAT>(uBeginX + uLocalX), static_cast<FLOAT>(cell.ColumnHeight), static_cast<FLOAT>(uBeginZ + uLocalZ)),
+                        XMFLOAT3(static_cast<FLOAT>(uQuadWidth), 0.0f, 0.0f),
+                        XMFLOAT3(0.0f, 0.0f, static_cast<FLOAT>(uQuadDepth)),
+                        XMFLOAT3(0.0f, 1.0f, 0.0f)
+                    );
+                }
+            }
+        }
+
+        // Side faces. A slice is a row of columns facing the same neighbouring row
+        const INT aDirections[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        for (const INT* direction : aDirections)
+        {
+            const BOOL bIsAlongX = direction[0] != 0;
+            const UINT uNumSlices = bIsAlongX ? uSizeX : uSizeZ;
+            const UINT uSliceLength = bIsAlongX ? uSizeZ : uSizeX;
+
+            std::vector<CHAR> aMask(static_cast<size_t>(uSliceLength) * uMaxHeight);
+            for (UINT uSliceIdx = 0u; uSliceIdx < uNumSlices; ++uSliceIdx)
+            {
+                std::fill(aMask.begin(), aMask.end(), static_cast<CHAR>(0));
+
+                for (UINT a = 0u; a < uSliceLength; ++a)
+                {
+                    UINT x = uBeginX + (bIsAlongX ? uSliceIdx : a);
+                    UINT z = uBeginZ + (bIsAlongX ? a : uSliceIdx);
+                    const HeightMapCell& cell = pCells[static_cast<size_t>(z) * uWidth + x];
+                    if (!isMeshable(cell))
+                    {
+                        continue;
+                    }
+
+                    WORD neighbourHeight = getColumnHeight(pCells, uWidth, uDepth, static_cast<INT>(x) + direction[0], static_cast<INT>(z) + direction[1]);
+                    for (UINT y = neighbourHeight; y < cell.ColumnHeight; ++y)
+                    {
+                        aMask[static_cast<size_t>(y) * uSliceLength + a] = cell.BlockType;
+                    }
+                }
+
+                for (UINT y = 0u; y < uMaxHeight; ++y)
+                {
+                    for (UINT a = 0u; a < uSliceLength; ++a)
+                    {
+                        CHAR blockType = aMask[static_cast<size_t>(y) * uSliceLength + a];
+                        if (blockType == 0)
+                        {
+                            continue;
+                        }
+
+                        UINT uQuadLength = 1u;
+                        while (a + uQuadLength < uSliceLength && aMask[static_cast<size_t>(y) * uSliceLength + a + uQuadLength] == blockType)
+                        {
+                            ++uQuadLength;
+                        }
+
+                        UINT uQuadHeight = 1u;
+                        while (y + uQuadHeight < uMaxHeight)
+                        {
+                            BOOL bIsRowSame = TRUE;
+                            for (UINT i = 0u; i < uQuadLength && bIsRowSame; ++i)
+                            {
+                                bIsRowSame = aMask[static_cast<size_t>(y + uQuadHeight) * uSliceLength + a + i] == blockType;
+                            }
+                            if (!bIsRowSame)
+                            {
+                                break;
+                            }
+                            ++uQuadHeight;
+                        }
+
+                        for (UINT j = 0u; j < uQuadHeight; ++j)
+                        {
+                            for (UINT i = 0u; i < uQuadLength; ++i)
+                            {
+                                aMask[static_cast<size_t>(y + j) * uSliceLength + a + i] = 0;
+                            }
+                        }
+
+                        // Faces towards +x or +z lie on the far edge of the column
+                        FLOAT plane = static_cast<FLOAT>(uSliceIdx + (bIsAlongX ? uBeginX : uBeginZ) + (direction[0] + direction[1] > 0 ? 1u : 0u));
+                        FLOAT start = static_cast<FLOAT>(a + (bIsAlongX ? uBeginZ : uBeginX));
+                        appendQuad(
+                            aMeshes,
+                            aCurrentMeshIndices,
+                            blockType,
+                            bIsAlongX ? XMFLOAT3(plane, static_cast<FLOAT>(y), start) : XMFLOAT3(start, static_cast<FLOAT>(y), plane),
+                            bIsAlongX ? XMFLOAT3(0.0f, 0.0f, static_cast<FLOAT>(uQuadLength)) : XMFLOAT3(static_cast<FLOAT>(uQuadLength), 0.0f, 0.0f),
+                            XMFLOAT3(0.0f, static_cast<FLOAT>(uQuadHeight), 0.0f),
+                            XMFLOAT3(static_cast<FLOAT>(direction[0]), 0.0f, static_cast<FLOAT>(direction[1]))
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ChunkMesher::isMeshable
+
+      Summary:  Returns whether the column has a valid block type
+
+      Args:     const HeightMapCell& cell
+                  Column record
+
+      Returns:  BOOL
+                  TRUE if the column is meshed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ChunkMesher::isMeshable(_In_ const HeightMapCell& cell)
+    {
+        return static_cast<CHAR>(eBlockType::GRASSLAND) <= cell.BlockType && cell.BlockType < static_cast<CHAR>(eBlockType::COUNT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ChunkMesher::getColumnHeight
+
+      Summary:  Returns the height of a column, 0 outside of the map
+
+      Args:     const HeightMapCell* pCells
+                  Column records in row-major order
+                UINT uWidth
+                  Number of columns along the x-axis
+                UINT uDepth
+                  Number of columns along the z-axis
+                INT x
+                  Column along the x-axis
+                INT z
+                  Column along the z-axis
+
+      Returns:  WORD
+                  Number of cubes in the column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD ChunkMesher::getColumnHeight(_In_ const HeightMapCell* pCells, _In_ UINT uWidth, _In_ UINT uDepth, _In_ INT x, _In_ INT z)
+    {
+        if (x < 0 || z < 0 || static_cast<UINT>(x) >= uWidth || static_cast<UINT>(z) >= uDepth)
+        {
+            return 0u;
+        }
+
+        const HeightMapCell& cell = pCells[static_cast<size_t>(z) * uWidth + static_cast<size_t>(x)];
+        if (!isMeshable(cell))
+        {
+            return 0u;
+        }
+
+        return cell.ColumnHeight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ChunkMesher::appendQuad
+
+      Summary:  Appends a quad to the current mesh of the block type,
+                starting a new mesh once WORD indices would overflow.
+                Corners are given on the cube edge grid and the
+                triangles face the normal
+
+      Args:     std::vector<TerrainMeshData>& aMeshes
+                  Meshes of the chunk
+                std::vector<size_t>& aCurrentMeshIndices
+                  Mesh being filled for each block type
+                CHAR blockType
+                  Block type of the quad
+                const XMFLOAT3& origin
+                  Corner of the quad on the cube edge grid
+                const XMFLOAT3& u
+                  First side of the quad in cubes
+                const XMFLOAT3& v
+                  Second side of the quad in cubes
+                const XMFLOAT3& normal
+                  Outward normal of the quad
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ChunkMesher::appendQuad(
+        _Inout_ std::vector<TerrainMeshData>& aMeshes,
+        _Inout_ std::vector<size_t>& aCurrentMeshIndices,
+        _In_ CHAR blockType,
+        _In_ const XMFLOAT3& origin,
+        _In_ const XMFLOAT3& u,
+        _In_ const XMFLOAT3& v,
+        _In_ const XMFLOAT3& normal
+        )
+    {
+        size_t& uMeshIdx = aCurrentMeshIndices[static_cast<size_t>(blockType) - static_cast<size_t>(eBlockType::GRASSLAND)];
+        if (uMeshIdx == SIZE_MAX || aMeshes[uMeshIdx].aVertices.size() + 4u > MAX_NUM_VERTICES)
+        {
+            aMeshes.push_back(TerrainMeshData{ .BlockType = blockType });
+            uMeshIdx = aMeshes.size() - 1u;
+        }
+
+        TerrainMeshData& mesh = aMeshes[uMeshIdx];
+        WORD baseVertex = static_cast<WORD>(mesh.aVertices.size());
+
+        XMVECTOR o = XMLoadFloat3(&origin);
+        XMVECTOR uAxis = XMLoadFloat3(&u);
+        XMVECTOR vAxis = XMLoadFloat3(&v);
+        FLOAT uLength = XMVectorGetX(XMVector3Length(uAxis));
+        FLOAT vLength = XMVectorGetX(XMVector3Length(vAxis));
+
+        // Edge e of the grid lies at 2 * e - 1
+        XMVECTOR aCorners[4] = { o, o + uAxis, o + uAxis + vAxis, o + vAxis };
+        XMFLOAT2 aTexCoords[4] = { XMFLOAT2(0.0f, 0.0f), XMFLOAT2(uLength, 0.0f), XMFLOAT2(uLength, vLength), XMFLOAT2(0.0f, vLength) };
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            SimpleVertex vertex = { .TexCoord = aTexCoords[i], .Normal = normal };
+            XMStoreFloat3(&vertex.Position, 2.0f * aCorners[i] - XMVectorSplatOne());
+            mesh.aVertices.push_back(vertex);
+        }
+
+        // Front faces are the ones whose (b - a) x (c - a) points along the normal
+        if (XMVectorGetX(XMVector3Dot(XMVector3Cross(uAxis, vAxis), XMLoadFloat3(&normal))) > 0.0f)
+        {
+            mesh.aIndices.insert(mesh.aIndices.end(),
+                {
+                    baseVertex, static_cast<WORD>(baseVertex + 1u), static_cast<WORD>(baseVertex + 2u),
+                    baseVertex, static_cast<WORD>(baseVertex + 2u), static_cast<WORD>(baseVertex + 3u)
+                });
+        }
+        else
+        {
+            mesh.aIndices.insert(mesh.aIndices.end(),
+                {
+                    baseVertex, static_cast<WORD>(baseVertex + 2u), static_cast<WORD>(baseVertex + 1u),
+                    baseVertex, static_cast<WORD>(baseVertex + 3u), static_cast<WORD>(baseVertex + 2u)
+                });
+        }
+    }
+}
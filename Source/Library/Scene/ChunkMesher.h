@@ -0,0 +1,82 @@
+/*+===================================================================
+  File:      CHUNKMESHER.H
+
+  Summary:   ChunkMesher header file contains declarations of
+             ChunkMesher class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: ChunkMesher
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Scene/HeightMap.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TerrainMeshData
+
+      Summary:  Merged faces of a single block type in a chunk. A chunk
+                may emit several of these per block type so that every
+                mesh stays addressable by WORD indices
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainMeshData
+    {
+        CHAR BlockType;
+        std::vector<SimpleVertex> aVertices;
+        std::vector<WORD> aIndices;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ChunkMesher
+
+      Summary:  Greedy mesher that turns the column heights of a chunk
+                into merged quads of coplanar faces of the same block
+                type. Only exposed faces are emitted, the ground below
+                the map is treated as solid
+
+      Methods:  MeshChunk
+                  Meshes a single chunk of the height map
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ChunkMesher final
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = 16u;
+        static constexpr const size_t MAX_NUM_VERTICES = 65536u;
+
+    public:
+        ChunkMesher() = delete;
+        ChunkMesher(const ChunkMesher& other) = delete;
+        ChunkMesher(ChunkMesher&& other) = delete;
+        ChunkMesher& operator=(const ChunkMesher& other) = delete;
+        ChunkMesher& operator=(ChunkMesher&& other) = delete;
+        ~ChunkMesher() = delete;
+
+        static void MeshChunk(
+            _In_reads_(uWidth * uDepth) const HeightMapCell* pCells,
+            _In_ UINT uWidth,
+            _In_ UINT uDepth,
+            _In_ UINT uBeginX,
+            _In_ UINT uBeginZ,
+            _Out_ std::vector<TerrainMeshData>& aMeshes
+            );
+
+    private:
+        static BOOL isMeshable(_In_ const HeightMapCell& cell);
+        static WORD getColumnHeight(_In_ const HeightMapCell* pCells, _In_ UINT uWidth, _In_ UINT uDepth, _In_ INT x, _In_ INT z);
+        static void appendQuad(
+            _Inout_ std::vector<TerrainMeshData>& aMeshes,
+            _Inout_ std::vector<size_t>& aCurrentMeshIndices,
+            _In_ CHAR blockType,
+            _In_ const XMFLOAT3& origin,
+            _In_ const XMFLOAT3& u,
+            _In_ const XMFLOAT3& v,
+            _In_ const XMFLOAT3& normal
+            );
+    };
+}
@@ -0,0 +1,543 @@
+#include "Scene/HeightMap.h"
+
+#include <fstream>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::HeightMap
+
+      Summary:  Constructor
+
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_uNumColors, m_aColors,
+                 m_aCells, m_pColors, m_pCells, m_hFile, m_hFileMapping,
+                 m_pMappedView].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HeightMap::HeightMap()
+        : m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_uDepth(0u)
+        , m_uNumColors(0u)
+        , m_aColors()
+        , m_aCells()
+        , m_pColors(nullptr)
+        , m_pCells(nullptr)
+        , m_hFile(INVALID_HANDLE_VALUE)
+        , m_hFileMapping(nullptr)
+        , m_pMappedView(nullptr)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::~HeightMap
+
+      Summary:  Destructor. Unmaps the binary file if one is mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HeightMap::~HeightMap()
+    {
+        release();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::Load
+
+      Summary:  Loads the height map, memory-mapping it when the file is
+                in the binary format and parsing it as text otherwise
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::Load(_In_ const std::filesystem::path& filePath)
+    {
+        HRESULT hr = LoadBinary(filePath);
+        if (SUCCEEDED(hr))
+        {
+            return hr;
+        }
+
+        return LoadText(filePath);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::LoadBinary
+
+      Summary:  Memory-maps the binary height map. The palette and the
+                cells are read in place from the mapped view
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the binary height map file
+
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_uNumColors, m_pColors,
+                 m_pCells, m_hFile, m_hFileMapping, m_pMappedView].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::LoadBinary(_In_ const std::filesystem::path& filePath)
+    {
+        release();
+
+        m_hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_hFile, &fileSize))
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            release();
+            return hr;
+        }
+
+        if (fileSize.QuadPart < static_cast<LONGLONG>(sizeof(HeightMapHeader)))
+        {
+            release();
+            return E_FAIL;
+        }
+
+        m_hFileMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_hFileMapping)
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            release();
+            return hr;
+        }
+
+        m_pMappedView = static_cast<const BYTE*>(MapViewOfFile(m_hFileMapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_pMappedView)
+        {
+            HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
+            release();
+            return hr;
+        }
+
+        const HeightMapHeader* pHeader = reinterpret_cast<const HeightMapHeader*>(m_pMappedView);
+        if (pHeader->uMagic != MAGIC || pHeader->uVersion != VERSION)
+        {
+            release();
+            return E_FAIL;
+        }
+
+        if (!hasValidDimensions(pHeader->uWidth, pHeader->uHeight, pHeader->uDepth))
+        {
+            release();
+            return E_INVALIDARG;
+        }
+
+        ULONGLONG ullColorsSize = static_cast<ULONGLONG>(pHeader->uNumColors) * sizeof(XMFLOAT3);
+        ULONGLONG ullCellsSize = static_cast<ULONGLONG>(pHeader->uWidth) * static_cast<ULONGLONG>(pHeader->uDepth) * sizeof(HeightMapCell);
+        if (static_cast<ULONGLONG>(fileSize.QuadPart) < sizeof(HeightMapHeader) + ullColorsSize + ullCellsSize)
+        {
+            release();
+            return E_FAIL;
+        }
+
+        m_uWidth = pHeader->uWidth;
+        m_uHeight = pHeader->uHeight;
+        m_uDepth = pHeader->uDepth;
+        m_uNumColors = pHeader->uNumColors;
+        m_pColors = reinterpret_cast<const XMFLOAT3*>(m_pMappedView + sizeof(HeightMapHeader));
+        m_pCells = reinterpret_cast<const HeightMapCell*>(m_pMappedView + sizeof(HeightMapHeader) + ullColorsSize);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::LoadText
+
+      Summary:  Parses the text height map: width, height, depth and the
+                number of colors, followed by the palette and one
+                (block type, normalized height) pair per column.
+                Unreadable tokens are skipped
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the text height map file
+
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_uNumColors, m_aColors,
+                 m_aCells, m_pColors, m_pCells].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::LoadText(_In_ const std::filesystem::path& filePath)
+    {
+        release();
+
+        std::ifstream inputFile;
+        inputFile.open(filePath.string());
+        if (!inputFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        std::string trash;
+        UINT aDimension[4] = { 0u, };
+        UINT uDimensionIdx = 0u;
+        while (!inputFile.eof() && uDimensionIdx < ARRAYSIZE(aDimension))
+        {
+            inputFile >> aDimension[uDimensionIdx];
+
+            if (inputFile.fail())
+            {
+                if (inputFile.eof())
+                {
+                    break;
+                }
+                inputFile.clear();
+                inputFile >> trash;
+            }
+            else
+            {
+                ++uDimensionIdx;
+            }
+        }
+
+        if (!hasValidDimensions(aDimension[0], aDimension[1], aDimension[2]))
+        {
+            return E_INVALIDARG;
+        }
+
+        m_aColors.reserve(aDimension[3]);
+        XMFLOAT3 color;
+        while (!inputFile.eof() && m_aColors.size() < aDimension[3])
+        {
+            inputFile >> color.x >> color.y >> color.z;
+
+            if (inputFile.fail())
+            {
+                if (inputFile.eof())
+                {
+                    break;
+                }
+                inputFile.clear();
+                inputFile >> trash;
+            }
+            else
+            {
+                m_aColors.push_back(color);
+            }
+        }
+
+        size_t uNumCells = static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[2]);
+        m_aCells.resize(uNumCells, HeightMapCell{ .BlockType = 0, .Reserved = 0u, .ColumnHeight = 0u });
+
+        size_t uCellIdx = 0u;
+        CHAR voxelType;
+        FLOAT height;
+        while (!inputFile.eof() && uCellIdx < uNumCells)
+        {
+            inputFile >> voxelType >> height;
+
+            if (inputFile.fail())
+            {
+                if (inputFile.eof())
+                {
+                    break;
+                }
+                inputFile.clear();
+                inputFile >> trash;
+            }
+            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
+            {
+                m_aCells[uCellIdx].BlockType = voxelType;
+                m_aCells[uCellIdx].ColumnHeight = GetColumnHeight(aDimension[1], height);
+                ++uCellIdx;
+            }
+        }
+
+        inputFile.close();
+
+        m_uWidth = aDimension[0];
+        m_uHeight = aDimension[1];
+        m_uDepth = aDimension[2];
+        m_uNumColors = static_cast<UINT>(m_aColors.size());
+        m_pColors = m_aColors.data();
+        m_pCells = m_aCells.data();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::Create
+
+      Summary:  Takes ownership of a height map built in memory, e.g. by
+                TerrainGenerator, without going through a file
+
+      Args:     UINT uWidth
+                  Number of columns along the x-axis
+                UINT uHeight
+                  Maximum height of the map
+                UINT uDepth
+                  Number of columns along the z-axis
+                std::vector<XMFLOAT3>&& aColors
+                  Palette
+                std::vector<HeightMapCell>&& aCells
+                  uWidth * uDepth column records in row-major order
+
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_uNumColors,
+                 m_aColors, m_aCells, m_pColors, m_pCells].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::Create(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ std::vector<XMFLOAT3>&& aColors, _In_ std::vector<HeightMapCell>&& aCells)
+    {
+        if (!hasValidDimensions(uWidth, uHeight, uDepth) || aCells.size() != static_cast<size_t>(uWidth) * static_cast<size_t>(uDepth))
+        {
+            return E_INVALIDARG;
+        }
+
+        release();
+
+        m_aColors = std::move(aColors);
+        m_aCells = std::move(aCells);
+
+        m_uWidth = uWidth;
+        m_uHeight = uHeight;
+        m_uDepth = uDepth;
+        m_uNumColors = static_cast<UINT>(m_aColors.size());
+        m_pColors = m_aColors.data();
+        m_pCells = m_aCells.data();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetColumnHeight
+
+      Summary:  Converts a normalized height to the number of voxels in
+                a column, clamped to the range of WORD
+
+      Args:     UINT uHeight
+                  Maximum height of the map
+                FLOAT height
+                  Normalized height of the column
+
+      Returns:  WORD
+                  Number of voxels in the column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD HeightMap::GetColumnHeight(_In_ UINT uHeight, _In_ FLOAT height)
+    {
+        FLOAT columnHeight = static_cast<FLOAT>(uHeight) * height;
+        if (columnHeight < 0.0f)
+        {
+            columnHeight = 0.0f;
+        }
+        else if (columnHeight > static_cast<FLOAT>(MAXWORD))
+        {
+            columnHeight = static_cast<FLOAT>(MAXWORD);
+        }
+
+        return static_cast<WORD>(columnHeight);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::SaveBinary
+
+      Summary:  Writes the loaded height map in the binary format
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the binary height map file
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::SaveBinary(_In_ const std::filesystem::path& filePath) const
+    {
+        std::ofstream outputFile(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!outputFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        HeightMapHeader header =
+        {
+            .uMagic = MAGIC,
+            .uVersion = VERSION,
+            .uWidth = m_uWidth,
+            .uHeight = m_uHeight,
+            .uDepth = m_uDepth,
+            .uNumColors = m_uNumColors
+        };
+
+        outputFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outputFile.write(reinterpret_cast<const char*>(m_pColors), static_cast<std::streamsize>(m_uNumColors) * sizeof(XMFLOAT3));
+        outputFile.write(reinterpret_cast<const char*>(m_pCells), static_cast<std::streamsize>(m_uWidth) * static_cast<std::streamsize>(m_uDepth) * sizeof(HeightMapCell));
+
+        if (outputFile.fail())
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::ConvertTextToBinary
+
+      Summary:  Converts a text height map to the binary format
+
+      Args:     const std::filesystem::path& textFilePath
+                  Path to the text height map file
+                const std::filesystem::path& binaryFilePath
+                  Path to the binary height map file to write
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::ConvertTextToBinary(_In_ const std::filesystem::path& textFilePath, _In_ const std::filesystem::path& binaryFilePath)
+    {
+        HeightMap heightMap;
+
+        HRESULT hr = heightMap.LoadText(textFilePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return heightMap.SaveBinary(binaryFilePath);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetWidth
+
+      Summary:  Returns the number of columns along the x-axis
+
+      Returns:  UINT
+                  Width of the height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightMap::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetHeight
+
+      Summary:  Returns the maximum height of the map
+
+      Returns:  UINT
+                  Height of the height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightMap::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetDepth
+
+      Summary:  Returns the number of columns along the z-axis
+
+      Returns:  UINT
+                  Depth of the height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightMap::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetNumColors
+
+      Summary:  Returns the number of palette entries
+
+      Returns:  UINT
+                  Number of colors
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightMap::GetNumColors() const
+    {
+        return m_uNumColors;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetColors
+
+      Summary:  Returns the palette
+
+      Returns:  const XMFLOAT3*
+                  Palette of GetNumColors() entries
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT3* HeightMap::GetColors() const
+    {
+        return m_pColors;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetCells
+
+      Summary:  Returns the column records in row-major order
+
+      Returns:  const HeightMapCell*
+                  GetWidth() * GetDepth() column records
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const HeightMapCell* HeightMap::GetCells() const
+    {
+        return m_pCells;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::hasValidDimensions
+
+      Summary:  Checks that every grid coordinate of the map fits the
+                INT16 coordinates of the voxel instances
+
+      Args:     UINT uWidth
+                  Number of columns along the x-axis
+                UINT uHeight
+                  Maximum height of the map
+                UINT uDepth
+                  Number of columns along the z-axis
+
+      Returns:  BOOL
+                  TRUE if no dimension exceeds MAX_DIMENSION
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL HeightMap::hasValidDimensions(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth)
+    {
+        return uWidth <= MAX_DIMENSION && uHeight <= MAX_DIMENSION && uDepth <= MAX_DIMENSION;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::release
+
+      Summary:  Unmaps the binary file and clears the owned arrays
+
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_uNumColors, m_aColors,
+                 m_aCells, m_pColors, m_pCells, m_hFile, m_hFileMapping,
+                 m_pMappedView].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightMap::release()
+    {
+        if (m_pMappedView)
+        {
+            UnmapViewOfFile(m_pMappedView);
+            m_pMappedView = nullptr;
+        }
+
+        if (m_hFileMapping)
+        {
+            CloseHandle(m_hFileMapping);
+            m_hFileMapping = nullptr;
+        }
+
+        if (m_hFile != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_hFile);
+            m_hFile = INVALID_HANDLE_VALUE;
+        }
+
+        m_aColors.clear();
+        m_aCells.clear();
+        m_pColors = nullptr;
+        m_pCells = nullptr;
+        m_uWidth = 0u;
+        m_uHeight = 0u;
+        m_uDepth = 0u;
+        m_uNumColors = 0u;
+    }
+}
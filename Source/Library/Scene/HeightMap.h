@@ -0,0 +1,140 @@
+/*+===================================================================
+  File:      HEIGHTMAP.H
+
+  Summary:   HeightMap header file contains declarations of HeightMap
+             class used for the lab samples of Game Graphics
+             Programming course.
+
+  Classes: HeightMap
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightMapCell
+
+      Summary:  Packed column record of the height map. ColumnHeight is
+                the number of voxels stacked in the column
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightMapCell
+    {
+        CHAR BlockType;
+        BYTE Reserved;
+        WORD ColumnHeight;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   HeightMapHeader
+
+      Summary:  Header of the binary height map file. The header is
+                followed by uNumColors XMFLOAT3 palette entries and
+                uWidth * uDepth HeightMapCell records in row-major
+                order (x fastest)
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightMapHeader
+    {
+        UINT32 uMagic;
+        UINT32 uVersion;
+        UINT32 uWidth;
+        UINT32 uHeight;
+        UINT32 uDepth;
+        UINT32 uNumColors;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    HeightMap
+
+      Summary:  Column height map of the voxel terrain. Binary files are
+                memory-mapped and read in place, text files are parsed
+                into owned arrays. Voxel instances store their grid
+                coordinates as INT16, so maps larger than MAX_DIMENSION
+                along any axis are rejected
+
+      Methods:  Load
+                  Loads either a binary or a text height map
+                LoadBinary
+                  Memory-maps a binary height map
+                LoadText
+                  Parses a text height map
+                Create
+                  Takes ownership of a height map built in memory
+                SaveBinary
+                  Writes the height map in the binary format
+                ConvertTextToBinary
+                  Converts a text height map to the binary format
+                GetColumnHeight
+                  Converts a normalized height to a column height
+                GetWidth
+                  Returns the number of columns along the x-axis
+                GetHeight
+                  Returns the maximum height of the map
+                GetDepth
+                  Returns the number of columns along the z-axis
+                GetNumColors
+                  Returns the number of palette entries
+                GetColors
+                  Returns the palette
+                GetCells
+                  Returns the column records
+                HeightMap
+                  Constructor.
+                ~HeightMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class HeightMap final
+    {
+    public:
+        static constexpr const UINT32 MAGIC = 0x50414D48u;   // "HMAP"
+        static constexpr const UINT32 VERSION = 1u;
+        static constexpr const UINT MAX_DIMENSION = SHRT_MAX;
+
+    public:
+        HeightMap();
+        HeightMap(const HeightMap& other) = delete;
+        HeightMap(HeightMap&& other) = delete;
+        HeightMap& operator=(const HeightMap& other) = delete;
+        HeightMap& operator=(HeightMap&& other) = delete;
+        ~HeightMap();
+
+        HRESULT Load(_In_ const std::filesystem::path& filePath);
+        HRESULT LoadBinary(_In_ const std::filesystem::path& filePath);
+        HRESULT LoadText(_In_ const std::filesystem::path& filePath);
+        HRESULT Create(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ std::vector<XMFLOAT3>&& aColors, _In_ std::vector<HeightMapCell>&& aCells);
+        HRESULT SaveBinary(_In_ const std::filesystem::path& filePath) const;
+
+        static HRESULT ConvertTextToBinary(_In_ const std::filesystem::path& textFilePath, _In_ const std::filesystem::path& binaryFilePath);
+
+        static WORD GetColumnHeight(_In_ UINT uHeight, _In_ FLOAT height);
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        UINT GetNumColors() const;
+        const XMFLOAT3* GetColors() const;
+        const HeightMapCell* GetCells() const;
+
+    private:
+        static BOOL hasValidDimensions(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth);
+        void release();
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        UINT m_uNumColors;
+
+        std::vector<XMFLOAT3> m_aColors;
+        std::vector<HeightMapCell> m_aCells;
+        const XMFLOAT3* m_pColors;
+        const HeightMapCell* m_pCells;
+
+        HANDLE m_hFile;
+        HANDLE m_hFileMapping;
+        const BYTE* m_pMappedView;
+    };
+}
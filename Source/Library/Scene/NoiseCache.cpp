@@ -0,0 +1,181 @@
+#include "Scene/NoiseCache.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::NoiseCache
+
+      Summary:  Constructor
+
+      Modifies: [m_mutex, m_tiles, m_uNumHits, m_uNumMisses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NoiseCache::NoiseCache()
+        : m_mutex()
+        , m_tiles()
+        , m_uNumHits(0u)
+        , m_uNumMisses(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::GetOctaveTile
+
+      Summary:  Returns the octave tile from the cache, computing and
+                inserting it on a miss. The noise is evaluated outside
+                the lock, if two threads miss the same tile the first
+                inserted field is kept
+
+      Args:     const PerlinNoise& noise
+                  Seeded noise of the field
+                UINT uOctave
+                  Octave of the field, its frequency is 2^uOctave
+                UINT uTileX
+                  x index of the tile
+                UINT uTileZ
+                  z index of the tile
+
+      Modifies: [m_tiles, m_uNumHits, m_uNumMisses].
+
+      Returns:  std::shared_ptr<const std::vector<FLOAT>>
+                  TILE_SIZE x TILE_SIZE noise samples, row by row
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<const std::vector<FLOAT>> NoiseCache::GetOctaveTile(_In_ const PerlinNoise& noise, _In_ UINT uOctave, _In_ UINT uTileX, _In_ UINT uTileZ)
+    {
+        UINT64 uKey = getKey(noise.GetSeed(), uOctave, uTileX, uTileZ);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_tiles.find(uKey);
+            if (it != m_tiles.end())
+            {
+                ++m_uNumHits;
+                return it->second;
+            }
+        }
+
+        ++m_uNumMisses;
+        std::shared_ptr<const std::vector<FLOAT>> tile = ComputeOctaveTile(noise, uOctave, uTileX, uTileZ);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tiles.try_emplace(uKey, std::move(tile)).first->second;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::ComputeOctaveTile
+
+      Summary:  Computes an octave tile one batched row at a time. The
+                samples are the ones the whole map generation evaluates,
+                so cached and uncached terrains are identical
+
+      Args:     const PerlinNoise& noise
+                  Seeded noise of the field
+                UINT uOctave
+                  Octave of the field, its frequency is 2^uOctave
+                UINT uTileX
+                  x index of the tile
+                UINT uTileZ
+                  z index of the tile
+
+      Returns:  std::shared_ptr<const std::vector<FLOAT>>
+                  TILE_SIZE x TILE_SIZE noise samples, row by row
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<const std::vector<FLOAT>> NoiseCache::ComputeOctaveTile(_In_ const PerlinNoise& noise, _In_ UINT uOctave, _In_ UINT uTileX, _In_ UINT uTileZ)
+    {
+        std::shared_ptr<std::vector<FLOAT>> tile = std::make_shared<std::vector<FLOAT>>(static_cast<size_t>(TILE_SIZE) * TILE_SIZE);
+
+        FLOAT frequency = static_cast<FLOAT>(1u << uOctave);
+        FLOAT x = frequency * static_cast<FLOAT>(uTileX * TILE_SIZE);
+        for (UINT uRow = 0u; uRow < TILE_SIZE; ++uRow)
+        {
+            FLOAT z = static_cast<FLOAT>(uTileZ * TILE_SIZE + uRow);
+            noise.GetPerlin2dRow(x, frequency, frequency * z, BASE_FREQUENCY, NOISE_DEPTH, TILE_SIZE, tile->data() + static_cast<size_t>(uRow) * TILE_SIZE);
+        }
+
+        return tile;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::Clear
+
+      Summary:  Releases every cached tile and resets the counters.
+                Tiles still held by a generation stay alive until it
+                releases them
+
+      Modifies: [m_tiles, m_uNumHits, m_uNumMisses].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NoiseCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_tiles.clear();
+        m_uNumHits = 0u;
+        m_uNumMisses = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::GetNumTiles
+
+      Summary:  Returns the number of cached tiles
+
+      Returns:  size_t
+                  Number of cached tiles
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t NoiseCache::GetNumTiles()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_tiles.size();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::GetNumHits
+
+      Summary:  Returns the number of tiles found in the cache
+
+      Returns:  UINT64
+                  Number of hits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 NoiseCache::GetNumHits() const
+    {
+        return m_uNumHits;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::GetNumMisses
+
+      Summary:  Returns the number of tiles computed by the cache
+
+      Returns:  UINT64
+                  Number of misses
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 NoiseCache::GetNumMisses() const
+    {
+        return m_uNumMisses;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NoiseCache::getKey
+
+      Summary:  Packs the seed, octave and tile indices into a key
+
+      Args:     UINT uSeed
+                  Seed of the noise
+                UINT uOctave
+                  Octave of the field
+                UINT uTileX
+                  x index of the tile
+                UINT uTileZ
+                  z index of the tile
+
+      Returns:  UINT64
+                  Key of the tile
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 NoiseCache::getKey(_In_ UINT uSeed, _In_ UINT uOctave, _In_ UINT uTileX, _In_ UINT uTileZ)
+    {
+        assert(uOctave < MAX_OCTAVES);
+        assert(uTileX < MAX_TILES_PER_AXIS && uTileZ < MAX_TILES_PER_AXIS);
+
+        return (static_cast<UINT64>(uSeed) << 32u) | (static_cast<UINT64>(uOctave) << 24u) | (static_cast<UINT64>(uTileZ) << 12u) | static_cast<UINT64>(uTileX);
+    }
+}
@@ -0,0 +1,86 @@
+/*+===================================================================
+  File:      NOISECACHE.H
+
+  Summary:   NoiseCache header file contains declarations of the tile
+             cache of octave noise fields shared by the terrain
+             generations of the lab samples of Game Graphics
+             Programming course.
+
+  Classes: NoiseCache
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <mutex>
+
+#include "Scene/PerlinNoise.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    NoiseCache
+
+      Summary:  Keeps the computed octave fields of the terrain noise,
+                keyed by seed, octave and TILE_SIZE x TILE_SIZE tile, so
+                a regeneration that only changes the biome thresholds or
+                one of the seeds does not evaluate the unchanged fields
+                again. Tiles are immutable once inserted and may be read
+                by several generator threads at once
+
+      Methods:  GetOctaveTile
+                  Returns a cached or newly computed octave tile
+                ComputeOctaveTile
+                  Computes an octave tile without caching it
+                Clear
+                  Releases every cached tile
+                GetNumTiles
+                  Returns the number of cached tiles
+                GetNumHits
+                  Returns the number of tiles found in the cache
+                GetNumMisses
+                  Returns the number of tiles computed by the cache
+                NoiseCache
+                  Constructor.
+                ~NoiseCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class NoiseCache final
+    {
+    public:
+        static constexpr const UINT TILE_SIZE = 64u;
+        static constexpr const UINT MAX_TILES_PER_AXIS = 1u << 12u;
+        static constexpr const UINT MAX_OCTAVES = 1u << 8u;
+        static constexpr const FLOAT BASE_FREQUENCY = 0.1f;
+        static constexpr const UINT NOISE_DEPTH = 4u;
+
+    public:
+        NoiseCache();
+        NoiseCache(const NoiseCache& other) = delete;
+        NoiseCache(NoiseCache&& other) = delete;
+        NoiseCache& operator=(const NoiseCache& other) = delete;
+        NoiseCache& operator=(NoiseCache&& other) = delete;
+        ~NoiseCache() = default;
+
+        std::shared_ptr<const std::vector<FLOAT>> GetOctaveTile(_In_ const PerlinNoise& noise, _In_ UINT uOctave, _In_ UINT uTileX, _In_ UINT uTileZ);
+        static std::shared_ptr<const std::vector<FLOAT>> ComputeOctaveTile(_In_ const PerlinNoise& noise, _In_ UINT uOctave, _In_ UINT uTileX, _In_ UINT uTileZ);
+
+        void Clear();
+
+        size_t GetNumTiles();
+        UINT64 GetNumHits() const;
+        UINT64 GetNumMisses() const;
+
+    private:
+        static UINT64 getKey(_In_ UINT uSeed, _In_ UINT uOctave, _In_ UINT uTileX, _In_ UINT uTileZ);
+
+    private:
+        std::mutex m_mutex;
+        std::unordered_map<UINT64, std::shared_ptr<const std::vector<FLOAT>>> m_tiles;
+        std::atomic<UINT64> m_uNumHits;
+        std::atomic<UINT64> m_uNumMisses;
+    };
+}
@@ -0,0 +1,226 @@
+#include "Scene/PerlinNoise.h"
+
+#include <random>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::PerlinNoise
+
+      Summary:  Constructor. Builds the hash table of the seed
+
+      Args:     UINT uSeed
+                  Seed of the table
+
+      Modifies: [m_uSeed, m_aPermutation].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PerlinNoise::PerlinNoise(_In_ UINT uSeed)
+        : m_uSeed(uSeed)
+        , m_aPermutation()
+    {
+        if (uSeed == DEFAULT_SEED)
+        {
+            std::copy(std::begin(ms_aDefaultHashes), std::end(ms_aDefaultHashes), m_aPermutation);
+            return;
+        }
+
+        for (UINT i = 0u; i < TABLE_SIZE; ++i)
+        {
+            m_aPermutation[i] = i;
+        }
+
+        // std::shuffle is implementation defined, the engine output is not
+        std::mt19937 engine(uSeed);
+        for (UINT i = TABLE_SIZE - 1u; i > 0u; --i)
+        {
+            UINT j = static_cast<UINT>(engine() % (i + 1u));
+            UINT temp = m_aPermutation[i];
+            m_aPermutation[i] = m_aPermutation[j];
+            m_aPermutation[j] = temp;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::GetPerlin2d
+
+      Summary:  Returns the fractal noise of a sample in [0, 1)
+
+      Args:     FLOAT x
+                  x coordinate of the sample
+                FLOAT y
+                  y coordinate of the sample
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+
+      Returns:  FLOAT
+                  Noise of the sample
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PerlinNoise::GetPerlin2d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth) const
+    {
+        FLOAT xa = x * frequency;
+        FLOAT ya = y * frequency;
+        FLOAT amp = 1.0f;
+        FLOAT fin = 0.0f;
+        FLOAT div = 0.0f;
+
+        for (UINT i = 0; i < uDepth; ++i)
+        {
+            div += 256.0f * amp;
+            fin += getNoise2d(xa, ya) * amp;
+            amp /= 2.0f;
+            xa *= 2.0f;
+            ya *= 2.0f;
+        }
+
+        return fin / div;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::GetPerlin2dRow
+
+      Summary:  Batched GetPerlin2d over a row of samples. Four samples
+                are evaluated per XMVECTOR and every octave runs the
+                same operations as the scalar function, so the results
+                match GetPerlin2d within BATCH_TOLERANCE. Only the
+                hash table lookups stay scalar
+
+      Args:     FLOAT x
+                  x coordinate of the first sample
+                FLOAT xStep
+                  Distance along x between two samples
+                FLOAT y
+                  y coordinate of every sample
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uDepth
+                  Number of octaves
+                UINT uNumSamples
+                  Number of samples
+                FLOAT* pNoise
+                  Noise of sample i at (x + xStep * i, y)
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PerlinNoise::GetPerlin2dRow(_In_ FLOAT x, _In_ FLOAT xStep, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ UINT uNumSamples, _Out_writes_(uNumSamples) FLOAT* pNoise) const
+    {
+        FLOAT amp = 1.0f;
+        FLOAT div = 0.0f;
+        for (UINT i = 0; i < uDepth; ++i)
+        {
+            div += 256.0f * amp;
+            amp /= 2.0f;
+        }
+
+        const XMVECTOR laneOffsets = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+        const XMVECTOR ya = XMVectorReplicate(y * frequency);
+
+        for (UINT uSampleIdx = 0u; uSampleIdx < uNumSamples; uSampleIdx += 4u)
+        {
+            XMVECTOR sampleIndices = XMVectorAdd(XMVectorReplicate(static_cast<FLOAT>(uSampleIdx)), laneOffsets);
+            XMVECTOR xa = XMVectorScale(XMVectorAdd(XMVectorReplicate(x), XMVectorMultiply(XMVectorReplicate(xStep), sampleIndices)), frequency);
+            XMVECTOR yOctave = ya;
+            XMVECTOR ampOctave = XMVectorSplatOne();
+            XMVECTOR fin = XMVectorZero();
+
+            for (UINT i = 0; i < uDepth; ++i)
+            {
+                fin = XMVectorAdd(fin, XMVectorMultiply(getNoise2d(xa, yOctave), ampOctave));
+                ampOctave = XMVectorScale(ampOctave, 0.5f);
+                xa = XMVectorScale(xa, 2.0f);
+                yOctave = XMVectorScale(yOctave, 2.0f);
+            }
+
+            XMFLOAT4 noise;
+            XMStoreFloat4(&noise, XMVectorDivide(fin, XMVectorReplicate(div)));
+
+            const FLOAT aNoise[] = { noise.x, noise.y, noise.z, noise.w };
+            for (UINT uLaneIdx = 0u; uLaneIdx < 4u && uSampleIdx + uLaneIdx < uNumSamples; ++uLaneIdx)
+            {
+                pNoise[uSampleIdx + uLaneIdx] = aNoise[uLaneIdx];
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::GetSeed
+
+      Summary:  Returns the seed of the hash table
+
+      Returns:  UINT
+                  Seed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT PerlinNoise::GetSeed() const
+    {
+        return m_uSeed;
+    }
+
+    FLOAT PerlinNoise::getNoise2(UINT x, UINT y) const
+    {
+        UINT temp = m_aPermutation[y % 256u];
+
+        return static_cast<FLOAT>(m_aPermutation[(temp + x) % 256u]);
+    }
+
+    FLOAT PerlinNoise::getNoise2d(FLOAT x, FLOAT y) const
+    {
+        UINT uX = static_cast<UINT>(x);
+        UINT uY = static_cast<UINT>(y);
+        FLOAT xFrac = x - static_cast<FLOAT>(uX);
+        FLOAT yFrac = y - static_cast<FLOAT>(uY);
+
+        UINT s = static_cast<UINT>(getNoise2(uX, uY));
+        UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
+        UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
+        UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+
+        FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
+        FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+
+        return smoothLerp(low, high, yFrac);
+    }
+
+    FLOAT PerlinNoise::lerp(FLOAT x, FLOAT y, FLOAT s)
+    {
+        return x + s * (y - x);
+    }
+
+    FLOAT PerlinNoise::smoothLerp(FLOAT x, FLOAT y, FLOAT s)
+    {
+        return lerp(x, y, s * s * (3.0f - 2.0f * s));
+    }
+
+    XMVECTOR PerlinNoise::getNoise2d(FXMVECTOR x, FXMVECTOR y) const
+    {
+        XMVECTORU32 uX;
+        XMVECTORU32 uY;
+        uX.v = XMConvertVectorFloatToUInt(x, 0u);
+        uY.v = XMConvertVectorFloatToUInt(y, 0u);
+        XMVECTOR xFrac = XMVectorSubtract(x, XMConvertVectorUIntToFloat(uX.v, 0u));
+        XMVECTOR yFrac = XMVectorSubtract(y, XMConvertVectorUIntToFloat(uY.v, 0u));
+
+        XMVECTORU32 s;
+        XMVECTORU32 t;
+        XMVECTORU32 u;
+        XMVECTORU32 v;
+        for (UINT uLaneIdx = 0u; uLaneIdx < 4u; ++uLaneIdx)
+        {
+            s.u[uLaneIdx] = static_cast<UINT>(getNoise2(uX.u[uLaneIdx], uY.u[uLaneIdx]));
+            t.u[uLaneIdx] = static_cast<UINT>(getNoise2(uX.u[uLaneIdx] + 1u, uY.u[uLaneIdx]));
+            u.u[uLaneIdx] = static_cast<UINT>(getNoise2(uX.u[uLaneIdx], uY.u[uLaneIdx] + 1u));
+            v.u[uLaneIdx] = static_cast<UINT>(getNoise2(uX.u[uLaneIdx] + 1u, uY.u[uLaneIdx] + 1u));
+        }
+
+        XMVECTOR low = smoothLerp(XMConvertVectorUIntToFloat(s.v, 0u), XMConvertVectorUIntToFloat(t.v, 0u), xFrac);
+        XMVECTOR high = smoothLerp(XMConvertVectorUIntToFloat(u.v, 0u), XMConvertVectorUIntToFloat(v.v, 0u), xFrac);
+
+        return smoothLerp(low, high, yFrac);
+    }
+
+    XMVECTOR PerlinNoise::smoothLerp(FXMVECTOR x, FXMVECTOR y, FXMVECTOR s)
+    {
+        // s * s * (3 - 2 * s) with the scalar evaluation order
+        XMVECTOR weight = XMVectorMultiply(XMVectorMultiply(s, s), XMVectorSubtract(XMVectorReplicate(3.0f), XMVectorScale(s, 2.0f)));
+
+        return XMVectorAdd(x, XMVectorMultiply(weight, XMVectorSubtract(y, x)));
+    }
+}
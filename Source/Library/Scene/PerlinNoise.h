@@ -0,0 +1,89 @@
+/*+===================================================================
+  File:      PERLINNOISE.H
+
+  Summary:   PerlinNoise header file contains declarations of the
+             seeded fractal value noise used to generate the voxel
+             terrain for the lab samples of Game Graphics Programming
+             course.
+
+  Classes: PerlinNoise
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PerlinNoise
+
+      Summary:  Fractal 2d noise hashed through a 256 entry table built
+                once per seed. DEFAULT_SEED keeps the hash table the
+                terrain has always used, other seeds shuffle 0-255 with
+                a Fisher-Yates pass over std::mt19937, so a seed gives
+                the same field on every platform
+
+      Methods:  GetPerlin2d
+                  Returns the noise of a sample
+                GetPerlin2dRow
+                  Fills the noise of a row of samples
+                GetSeed
+                  Returns the seed of the table
+                PerlinNoise
+                  Constructor.
+                ~PerlinNoise
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PerlinNoise final
+    {
+    public:
+        static constexpr const UINT DEFAULT_SEED = 0u;
+        static constexpr const UINT TABLE_SIZE = 256u;
+        static constexpr const FLOAT BATCH_TOLERANCE = 1.0e-6f;
+
+    public:
+        PerlinNoise(_In_ UINT uSeed);
+        PerlinNoise(const PerlinNoise& other) = delete;
+        PerlinNoise(PerlinNoise&& other) = delete;
+        PerlinNoise& operator=(const PerlinNoise& other) = delete;
+        PerlinNoise& operator=(PerlinNoise&& other) = delete;
+        ~PerlinNoise() = default;
+
+        FLOAT GetPerlin2d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth) const;
+        void GetPerlin2dRow(_In_ FLOAT x, _In_ FLOAT xStep, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ UINT uNumSamples, _Out_writes_(uNumSamples) FLOAT* pNoise) const;
+
+        UINT GetSeed() const;
+
+    private:
+        FLOAT getNoise2(UINT x, UINT y) const;
+        FLOAT getNoise2d(FLOAT x, FLOAT y) const;
+        static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
+        static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s);
+
+        XMVECTOR getNoise2d(FXMVECTOR x, FXMVECTOR y) const;
+        static XMVECTOR smoothLerp(FXMVECTOR x, FXMVECTOR y, FXMVECTOR s);
+
+    private:
+        static constexpr const UINT ms_aDefaultHashes[] =
+        {
+            208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
+            185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
+            9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
+            70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
+            203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
+            164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
+            228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
+            232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
+            193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
+            101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
+            135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
+            114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
+        };
+
+    private:
+        UINT m_uSeed;
+        UINT m_aPermutation[TABLE_SIZE];
+    };
+}
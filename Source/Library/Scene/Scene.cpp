@@ -1,161 +1,116 @@
 #include "Scene/Scene.h"
 
+#include <algorithm>
+#include <execution>
+#include <numeric>
+
 #include "Shader/SkyMapVertexShader.h"
 
 namespace library
 {
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetPerlin2d
+
+      Summary:  Fractal Perlin noise of the default seed, see
+                PerlinNoise::GetPerlin2d
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     FLOAT Scene::GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
     {
-        FLOAT xa = x * frequency;
-        FLOAT ya = y * frequency;
-        FLOAT amp = 1.0f;
-        FLOAT fin = 0.0f;
-        FLOAT div = 0.0f;
+        return getDefaultNoise().GetPerlin2d(x, y, frequency, uDepth);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetPerlin2dRow
+
+      Summary:  Batched fractal Perlin noise of the default seed, see
+                PerlinNoise::GetPerlin2dRow
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::GetPerlin2dRow(_In_ FLOAT x, _In_ FLOAT xStep, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ UINT uNumSamples, _Out_writes_(uNumSamples) FLOAT* pNoise)
+    {
+        getDefaultNoise().GetPerlin2dRow(x, xStep, y, frequency, uDepth, uNumSamples, pNoise);
+    }
+
+    Scene::Scene(const std::filesystem::path& filePath, eTerrainMeshing terrainMeshing, const TerrainStreamingDesc& streamingDesc)
+        : Scene(std::unique_ptr<HeightMap>(), terrainMeshing, streamingDesc)
+    {
+        m_filePath = filePath;
 
-        for (UINT i = 0; i < uDepth; ++i)
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        std::unique_ptr<HeightMap> heightMap = std::make_unique<HeightMap>();
+        HRESULT hr = heightMap->Load(m_filePath);
+        if (FAILED(hr))
         {
-            div += 256.0f * amp;
-            fin += getNoise2d(xa, ya) * amp;
-            amp /= 2.0f;
-            xa *= 2.0f;
-            ya *= 2.0f;
+            WCHAR szDebugMessage[256];
+            swprintf_s(szDebugMessage, L"Scene: can't load %s (0x%08X)\n", GetFileName(), static_cast<UINT>(hr));
+            OutputDebugString(szDebugMessage);
+            return;
         }
 
-        return fin / div;
+        createTerrain(std::move(heightMap), terrainMeshing, streamingDesc);
+
+        LARGE_INTEGER endTime;
+        QueryPerformanceCounter(&endTime);
+
+        WCHAR szDebugMessage[256];
+        swprintf_s(szDebugMessage, L"Scene: loaded %s in %.3f ms\n", GetFileName(),
+            static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart));
+        OutputDebugString(szDebugMessage);
     }
 
-    Scene::Scene(const std::filesystem::path& filePath)
-        : m_filePath(filePath)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Scene
+
+      Summary:  Constructor that builds the terrain from a height map
+                made in memory, e.g. by TerrainGenerator
+
+      Args:     std::unique_ptr<HeightMap>&& heightMap
+                  Height map of the terrain, may be nullptr
+                eTerrainMeshing terrainMeshing
+                  How the terrain is turned into geometry
+                const TerrainStreamingDesc& streamingDesc
+                  Residency settings of STREAMED_CHUNKS
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::Scene(std::unique_ptr<HeightMap>&& heightMap, eTerrainMeshing terrainMeshing, const TerrainStreamingDesc& streamingDesc)
+        : m_filePath()
         , m_voxels()
+        , m_terrainChunks()
+        , m_streamedVoxels()
+        , m_streamedHeightMap()
+        , m_terrainStreamer()
         , m_renderables()
         , m_models()
+        , m_aModelsToUpdate()
+        , m_aModelsToPose()
+        , m_animationLod(AnimationLod::DEFAULT_DESC)
         , m_aPointLights{ nullptr }
         , m_vertexShaders()
         , m_pixelShaders()
         , m_materials()
         , m_skyBox()
     {
-        std::ifstream inputFile;
-        inputFile.open(m_filePath.string());
-
-        std::string trash;
-        UINT aDimension[4] = { 0u, };
-        UINT uDimensionIdx = 0u;
-        while (!inputFile.eof() && uDimensionIdx < ARRAYSIZE(aDimension))
+        if (heightMap == nullptr)
         {
-            inputFile >> aDimension[uDimensionIdx];
-
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else
-            {
-                ++uDimensionIdx;
-            }
+            return;
         }
 
-        UINT uColorIdx = 0u;
-        XMFLOAT4 color;
-        while (!inputFile.eof() && uColorIdx < aDimension[3])
-        {
-            inputFile >> color.x >> color.y >> color.z;
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
 
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else
-            {
-                color.w = 1.0f;
-                m_voxels.push_back(std::make_shared<Voxel>(color));
-                ++uColorIdx;
-            }
-        }
+        createTerrain(std::move(heightMap), terrainMeshing, streamingDesc);
 
-        std::vector<std::vector<InstanceData>> aInstanceData;
-        aInstanceData.reserve(m_voxels.size());
-        for (UINT renderableIdx = 0u; renderableIdx < m_voxels.size(); ++renderableIdx)
-        {
-            aInstanceData.push_back(std::vector<InstanceData>());
-            aInstanceData.back().reserve(
-                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
-            );
-        }
+        LARGE_INTEGER endTime;
+        QueryPerformanceCounter(&endTime);
 
-        UINT uDepthIdx = 0u;
-        UINT uWidthIdx = 0u;
-        CHAR voxelType;
-        FLOAT height;
-        while (!inputFile.eof())
-        {
-            inputFile >> voxelType >> height;
-
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
-            {
-                for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
-                {
-                    aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
-                        InstanceData
-                        {
-                            .Transformation = XMMatrixTranslation(
-                                2.0f * (static_cast<FLOAT>(uWidthIdx) - static_cast<FLOAT>(aDimension[0]) / 2.0f),
-                                2.0f * (static_cast<FLOAT>(heightIdx) - static_cast<FLOAT>(aDimension[1])) + (static_cast<FLOAT>(aDimension[1]) * 0.75f),
-                                2.0f * (static_cast<FLOAT>(uDepthIdx) - static_cast<FLOAT>(aDimension[2]) / 2.0f)
-                                )
-                        }
-                    );
-                }
-                ++uWidthIdx;
-                if (uWidthIdx >= aDimension[0])
-                {
-                    uWidthIdx -= aDimension[0];
-                    ++uDepthIdx;
-
-                    if (uDepthIdx >= aDimension[2])
-                    {
-                        uDepthIdx -= aDimension[2];
-                    }
-                }
-            }
-        }
-
-        inputFile.close();
-
-        UINT uVoxelIdx = 0u;
-        auto it = m_voxels.begin();
-        while (it != m_voxels.end())
-        {
-            if (aInstanceData[uVoxelIdx].size() <= 0)
-            {
-                it = m_voxels.erase(it);
-            }
-            else
-            {
-                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
-                ++it;
-            }
-            ++uVoxelIdx;
-        }
+        WCHAR szDebugMessage[256];
+        swprintf_s(szDebugMessage, L"Scene: built terrain from memory in %.3f ms\n",
+            static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart));
+        OutputDebugString(szDebugMessage);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -299,7 +254,7 @@ namespace library
                 const std::shared_ptr<Model>& model
                   Shared pointer to the model object
 
-      Modifies: [m_models].
+      Modifies: [m_models, m_aModelsToUpdate].
 
       Returns:  HRESULT
                   Status code.
@@ -313,6 +268,12 @@ namespace library
 
         m_models[pszModelName] = pModel;
 
+        // A model added under several names is still updated once, so no two workers share it
+        if (std::find(m_aModelsToUpdate.begin(), m_aModelsToUpdate.end(), pModel.get()) == m_aModelsToUpdate.end())
+        {
+            m_aModelsToUpdate.push_back(pModel.get());
+        }
+
         return S_OK;
     }
 
@@ -438,7 +399,8 @@ namespace library
       Method:   Scene::Update
 
       Summary:  Update the renderables, models, point lights, skybox
-                each frame
+                each frame. Models only advance their animation time
+                here, UpdateAnimations poses their skeletons
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
@@ -453,9 +415,9 @@ namespace library
             it->second->Update(deltaTime);
         }
 
-        for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        for (Model* pModel : m_aModelsToUpdate)
         {
-            it->second->Update(deltaTime);
+            pModel->Advance(deltaTime);
         }
 
         for (UINT lightIdx = 0; lightIdx < NUM_LIGHTS; ++lightIdx)
@@ -464,6 +426,84 @@ namespace library
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::UpdateAnimations
+
+      Summary:  Poses the skeletons the animation level of detail picks
+                for this frame, ahead by their update interval so the
+                frames until the next pose are interpolated. Models only
+                write their own skeleton and transforms, so they are
+                posed on the parallel execution policy
+
+      Args:     const XMVECTOR& eye
+                  World position of the camera
+
+      Modifies: [m_aModelsToPose, m_animationLod].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::UpdateAnimations(_In_ const XMVECTOR& eye)
+    {
+        m_animationLod.Schedule(eye, m_aModelsToUpdate, m_aModelsToPose);
+
+        std::for_each(std::execution::par, m_aModelsToPose.begin(), m_aModelsToPose.end(),
+            [](const AnimationLodPose& pose)
+            {
+                pose.pModel->PoseSkeleton(pose.uUpdateInterval);
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::UpdateTerrainStreaming
+
+      Summary:  Moves the streamed chunks with the eye and uploads the
+                changed part of each streamed voxel's instance buffer.
+                Does nothing unless the scene streams its terrain
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to grow the instance buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the instances
+                const XMVECTOR& eye
+                  World position of the camera
+
+      Modifies: [m_terrainStreamer, m_streamedVoxels].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::UpdateTerrainStreaming(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const XMVECTOR& eye)
+    {
+        if (m_terrainStreamer == nullptr)
+        {
+            return S_OK;
+        }
+
+        // Cubes are 2 units wide, see VSPackedVoxel
+        XMFLOAT3 gridEye;
+        XMStoreFloat3(&gridEye, XMVectorScale(XMVectorSubtract(eye, getMapOrigin(*m_streamedHeightMap)), 0.5f));
+
+        m_terrainStreamer->Update(gridEye);
+
+        for (UINT uVoxelIdx = 0u; uVoxelIdx < m_terrainStreamer->GetNumBlockTypes(); ++uVoxelIdx)
+        {
+            const std::vector<InstanceRange>& aDirtyRanges = m_terrainStreamer->GetDirtyRanges(uVoxelIdx);
+            if (aDirtyRanges.empty() && m_streamedVoxels[uVoxelIdx]->GetNumInstances() == static_cast<UINT>(m_terrainStreamer->GetInstanceData(uVoxelIdx).size()))
+            {
+                continue;
+            }
+
+            HRESULT hr = m_streamedVoxels[uVoxelIdx]->UpdatePackedInstanceData(pDevice, pImmediateContext, m_terrainStreamer->GetInstanceData(uVoxelIdx), aDirtyRanges);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        m_terrainStreamer->ClearDirtyRanges();
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVoxels
 
@@ -490,6 +530,47 @@ namespace library
         return m_renderables;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetTerrainChunks
+
+      Summary:  Returns the vector of greedy-meshed terrain chunks. The
+                chunks are also registered as renderables
+
+      Returns:  std::vector<std::shared_ptr<TerrainChunk>>&
+                  Terrain chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<std::shared_ptr<TerrainChunk>>& Scene::GetTerrainChunks()
+    {
+        return m_terrainChunks;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetTerrainStreamer
+
+      Summary:  Returns the terrain streamer
+
+      Returns:  const TerrainStreamer*
+                  Terrain streamer, nullptr unless the scene was created
+                  with eTerrainMeshing::STREAMED_CHUNKS
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TerrainStreamer* Scene::GetTerrainStreamer() const
+    {
+        return m_terrainStreamer.get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetAnimationLod
+
+      Summary:  Returns the animation level of detail of the models
+
+      Returns:  AnimationLod&
+                  Animation level of detail, see AnimationLod::SetDesc
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    AnimationLod& Scene::GetAnimationLod()
+    {
+        return m_animationLod;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetModels
 
@@ -774,38 +855,418 @@ namespace library
         return S_OK;
     }
 
-    FLOAT Scene::getNoise2(UINT x, UINT y)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetVertexShaderOfTerrainChunk
+
+      Summary:  Sets the vertex shader for the terrain chunks in a scene
+
+      Args:     PCWSTR pszVertexShaderName
+                  Key of the vertex shader
+
+      Modifies: [m_terrainChunks].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetVertexShaderOfTerrainChunk(_In_ PCWSTR pszVertexShaderName)
+    {
+        if (!m_vertexShaders.contains(pszVertexShaderName))
+        {
+            return E_FAIL;
+        }
+
+        for (std::shared_ptr<TerrainChunk>& terrainChunk : m_terrainChunks)
+        {
+            terrainChunk->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetPixelShaderOfTerrainChunk
+
+      Summary:  Sets the pixel shader for the terrain chunks in a scene
+
+      Args:     PCWSTR pszPixelShaderName
+                  Key of the pixel shader
+
+      Modifies: [m_terrainChunks].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetPixelShaderOfTerrainChunk(_In_ PCWSTR pszPixelShaderName)
     {
-        UINT temp = ms_aHashes[y % 256u];
+        if (!m_pixelShaders.contains(pszPixelShaderName))
+        {
+            return E_FAIL;
+        }
 
-        return static_cast<FLOAT>(ms_aHashes[(temp + x) % 256u]);
+        for (std::shared_ptr<TerrainChunk>& terrainChunk : m_terrainChunks)
+        {
+            terrainChunk->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        }
+
+        return S_OK;
     }
 
-    FLOAT Scene::getNoise2d(FLOAT x, FLOAT y)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::createTerrain
+
+      Summary:  Turns the height map into geometry with the requested
+                meshing
+
+      Args:     std::unique_ptr<HeightMap>&& heightMap
+                  Loaded height map, kept only by STREAMED_CHUNKS
+                eTerrainMeshing terrainMeshing
+                  How the terrain is turned into geometry
+                const TerrainStreamingDesc& streamingDesc
+                  Residency settings of STREAMED_CHUNKS
+
+      Modifies: [m_voxels, m_terrainChunks, m_renderables,
+                 m_streamedVoxels, m_streamedHeightMap,
+                 m_terrainStreamer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::createTerrain(_In_ std::unique_ptr<HeightMap>&& heightMap, _In_ eTerrainMeshing terrainMeshing, _In_ const TerrainStreamingDesc& streamingDesc)
     {
-        UINT uX = static_cast<UINT>(x);
-        UINT uY = static_cast<UINT>(y);
-        FLOAT xFrac = x - static_cast<FLOAT>(uX);
-        FLOAT yFrac = y - static_cast<FLOAT>(uY);
+        switch (terrainMeshing)
+        {
+        case eTerrainMeshing::GREEDY_CHUNKS:
+            createTerrainChunks(*heightMap);
+            break;
+        case eTerrainMeshing::STREAMED_CHUNKS:
+            createTerrainStreamer(std::move(heightMap), streamingDesc);
+            break;
+        case eTerrainMeshing::INSTANCED_VOXELS:
+        default:
+            createVoxels(*heightMap);
+            break;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::createVoxels
+
+      Summary:  Creates one voxel per palette color and fills its
+                packed instance data from the columns of the height
+                map. Buried cubes are dropped by CullHiddenVoxels. Rows
+                are expanded in chunks on the parallel execution policy
+                and concatenated in chunk order, so the instance order
+                matches a serial pass
 
-        UINT s = static_cast<UINT>(getNoise2(uX, uY));
-        UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
-        UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
-        UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+      Args:     const HeightMap& heightMap
+                  Loaded height map
 
-        FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
-        FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+      Modifies: [m_voxels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::createVoxels(_In_ const HeightMap& heightMap)
+    {
+        const XMFLOAT3* pColors = heightMap.GetColors();
 
-        return smoothLerp(low, high, yFrac);
+        // HeightMap rejects maps whose coordinates do not fit
+        assert(heightMap.GetWidth() <= HeightMap::MAX_DIMENSION && heightMap.GetHeight() <= HeightMap::MAX_DIMENSION && heightMap.GetDepth() <= HeightMap::MAX_DIMENSION);
+
+        m_voxels.reserve(m_voxels.size() + heightMap.GetNumColors());
+        for (UINT uColorIdx = 0u; uColorIdx < heightMap.GetNumColors(); ++uColorIdx)
+        {
+            m_voxels.push_back(std::make_shared<Voxel>(XMFLOAT4(pColors[uColorIdx].x, pColors[uColorIdx].y, pColors[uColorIdx].z, 1.0f)));
+        }
+
+        std::vector<WORD> aFirstVisibleHeights(static_cast<size_t>(heightMap.GetWidth()) * static_cast<size_t>(heightMap.GetDepth()));
+        VoxelCullingStats cullingStats = CullHiddenVoxels(heightMap.GetCells(), heightMap.GetWidth(), heightMap.GetDepth(), aFirstVisibleHeights.data());
+
+        WCHAR szDebugMessage[256];
+        swprintf_s(szDebugMessage, L"Scene: %llu cubes in, %llu cubes out after hidden voxel culling\n", cullingStats.uNumCubesIn, cullingStats.uNumCubesOut);
+        OutputDebugString(szDebugMessage);
+
+        const UINT uNumChunks = (heightMap.GetDepth() + ROWS_PER_CHUNK - 1u) / ROWS_PER_CHUNK;
+
+        std::vector<UINT> aChunkIndices(uNumChunks);
+        std::iota(aChunkIndices.begin(), aChunkIndices.end(), 0u);
+
+        std::vector<std::vector<std::vector<PackedInstanceData>>> aChunkInstanceData(uNumChunks, std::vector<std::vector<PackedInstanceData>>(m_voxels.size()));
+        std::for_each(std::execution::par, aChunkIndices.begin(), aChunkIndices.end(),
+            [&heightMap, &aFirstVisibleHeights, &aChunkInstanceData](UINT uChunkIdx)
+            {
+                UINT uBeginDepth = uChunkIdx * ROWS_PER_CHUNK;
+                UINT uEndDepth = uBeginDepth + ROWS_PER_CHUNK;
+                if (uEndDepth > heightMap.GetDepth())
+                {
+                    uEndDepth = heightMap.GetDepth();
+                }
+
+                fillInstanceData(heightMap, aFirstVisibleHeights.data(), uBeginDepth, uEndDepth, aChunkInstanceData[uChunkIdx]);
+            }
+        );
+
+        std::vector<size_t> aVoxelIndices(m_voxels.size());
+        std::iota(aVoxelIndices.begin(), aVoxelIndices.end(), 0u);
+
+        std::vector<std::vector<PackedInstanceData>> aInstanceData(m_voxels.size());
+        std::for_each(std::execution::par, aVoxelIndices.begin(), aVoxelIndices.end(),
+            [&aChunkInstanceData, &aInstanceData](size_t uVoxelIdx)
+            {
+                size_t uNumInstances = 0u;
+                for (const std::vector<std::vector<PackedInstanceData>>& aChunk : aChunkInstanceData)
+                {
+                    uNumInstances += aChunk[uVoxelIdx].size();
+                }
+
+                aInstanceData[uVoxelIdx].reserve(uNumInstances);
+                for (std::vector<std::vector<PackedInstanceData>>& aChunk : aChunkInstanceData)
+                {
+                    aInstanceData[uVoxelIdx].insert(aInstanceData[uVoxelIdx].end(), aChunk[uVoxelIdx].begin(), aChunk[uVoxelIdx].end());
+                    aChunk[uVoxelIdx].clear();
+                    aChunk[uVoxelIdx].shrink_to_fit();
+                }
+            }
+        );
+
+        // Instances hold grid coordinates, so the map is centered through the world matrix
+        XMVECTOR mapOrigin = getMapOrigin(heightMap);
+
+        UINT uVoxelIdx = 0u;
+        auto it = m_voxels.begin();
+        while (it != m_voxels.end())
+        {
+            if (aInstanceData[uVoxelIdx].size() <= 0)
+            {
+                it = m_voxels.erase(it);
+            }
+            else
+            {
+                (*it)->SetPackedInstanceData(std::move(aInstanceData[uVoxelIdx]));
+                (*it)->Translate(mapOrigin);
+                ++it;
+            }
+            ++uVoxelIdx;
+        }
     }
 
-    FLOAT Scene::lerp(FLOAT x, FLOAT y, FLOAT s)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::createTerrainChunks
+
+      Summary:  Greedy-meshes the height map in CHUNK_SIZE x CHUNK_SIZE
+                chunks on the parallel execution policy and registers
+                one renderable per chunk and block type
+
+      Args:     const HeightMap& heightMap
+                  Loaded height map
+
+      Modifies: [m_terrainChunks, m_renderables].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::createTerrainChunks(_In_ const HeightMap& heightMap)
+    {
+        const UINT uNumChunksX = (heightMap.GetWidth() + ChunkMesher::CHUNK_SIZE - 1u) / ChunkMesher::CHUNK_SIZE;
+        const UINT uNumChunksZ = (heightMap.GetDepth() + ChunkMesher::CHUNK_SIZE - 1u) / ChunkMesher::CHUNK_SIZE;
+
+        std::vector<UINT> aChunkIndices(uNumChunksX * uNumChunksZ);
+        std::iota(aChunkIndices.begin(), aChunkIndices.end(), 0u);
+
+        std::vector<std::vector<TerrainMeshData>> aChunkMeshes(aChunkIndices.size());
+        std::for_each(std::execution::par, aChunkIndices.begin(), aChunkIndices.end(),
+            [&heightMap, &aChunkMeshes, uNumChunksX](UINT uChunkIdx)
+            {
+                ChunkMesher::MeshChunk(
+                    heightMap.GetCells(),
+                    heightMap.GetWidth(),
+                    heightMap.GetDepth(),
+                    (uChunkIdx % uNumChunksX) * ChunkMesher::CHUNK_SIZE,
+                    (uChunkIdx / uNumChunksX) * ChunkMesher::CHUNK_SIZE,
+                    aChunkMeshes[uChunkIdx]
+                );
+            }
+        );
+
+        UINT64 uNumCubes = 0u;
+        for (size_t uCellIdx = 0u; uCellIdx < static_cast<size_t>(heightMap.GetWidth()) * heightMap.GetDepth(); ++uCellIdx)
+        {
+            uNumCubes += heightMap.GetCells()[uCellIdx].ColumnHeight;
+        }
+
+        const XMFLOAT3* pColors = heightMap.GetColors();
+        XMVECTOR mapOrigin = getMapOrigin(heightMap);
+        UINT64 uNumTriangles = 0u;
+
+        for (std::vector<TerrainMeshData>& aMeshes : aChunkMeshes)
+        {
+            for (TerrainMeshData& mesh : aMeshes)
+            {
+                UINT uColorIdx = static_cast<UINT>(mesh.BlockType - static_cast<CHAR>(eBlockType::GRASSLAND));
+                if (uColorIdx >= heightMap.GetNumColors() || mesh.aIndices.empty())
+                {
+                    continue;
+                }
+
+                uNumTriangles += mesh.aIndices.size() / 3u;
+
+                std::shared_ptr<TerrainChunk> terrainChunk = std::make_shared<TerrainChunk>(
+                    std::move(mesh.aVertices),
+                    std::move(mesh.aIndices),
+                    XMFLOAT4(pColors[uColorIdx].x, pColors[uColorIdx].y, pColors[uColorIdx].z, 1.0f)
+                );
+                terrainChunk->Translate(mapOrigin);
+
+                WCHAR szRenderableName[32];
+                swprintf_s(szRenderableName, L"TerrainChunk%zu", m_terrainChunks.size());
+                AddRenderable(szRenderableName, terrainChunk);
+                m_terrainChunks.push_back(terrainChunk);
+            }
+        }
+
+        WCHAR szDebugMessage[256];
+        swprintf_s(szDebugMessage, L"Scene: %llu triangles in %zu terrain chunks, %llu triangles as instanced cubes\n",
+            uNumTriangles, m_terrainChunks.size(), uNumCubes * 12u);
+        OutputDebugString(szDebugMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::createTerrainStreamer
+
+      Summary:  Creates one empty voxel per palette color and a terrain
+                streamer that fills them around the eye, see
+                UpdateTerrainStreaming. The height map stays loaded, a
+                binary map is only paged in where chunks are read
+
+      Args:     std::unique_ptr<HeightMap>&& heightMap
+                  Loaded height map
+                const TerrainStreamingDesc& streamingDesc
+                  Residency settings
+
+      Modifies: [m_voxels, m_streamedVoxels, m_streamedHeightMap,
+                 m_terrainStreamer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::createTerrainStreamer(_In_ std::unique_ptr<HeightMap>&& heightMap, _In_ const TerrainStreamingDesc& streamingDesc)
+    {
+        const XMFLOAT3* pColors = heightMap->GetColors();
+
+        assert(heightMap->GetWidth() <= HeightMap::MAX_DIMENSION && heightMap->GetHeight() <= HeightMap::MAX_DIMENSION && heightMap->GetDepth() <= HeightMap::MAX_DIMENSION);
+
+        XMVECTOR mapOrigin = getMapOrigin(*heightMap);
+
+        m_streamedVoxels.reserve(heightMap->GetNumColors());
+        for (UINT uColorIdx = 0u; uColorIdx < heightMap->GetNumColors(); ++uColorIdx)
+        {
+            std::shared_ptr<Voxel> voxel = std::make_shared<Voxel>(XMFLOAT4(pColors[uColorIdx].x, pColors[uColorIdx].y, pColors[uColorIdx].z, 1.0f));
+            voxel->SetPackedInstanceData(std::vector<PackedInstanceData>());
+            voxel->Translate(mapOrigin);
+
+            m_voxels.push_back(voxel);
+            m_streamedVoxels.push_back(voxel);
+        }
+
+        m_streamedHeightMap = std::move(heightMap);
+        m_terrainStreamer = std::make_unique<TerrainStreamer>(*m_streamedHeightMap, streamingDesc);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::getMapOrigin
+
+      Summary:  Returns the translation that centers the grid of the
+                height map around the world origin
+
+      Args:     const HeightMap& heightMap
+                  Loaded height map
+
+      Returns:  XMVECTOR
+                  World position of the grid origin
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMVECTOR Scene::getMapOrigin(_In_ const HeightMap& heightMap)
     {
-        return x + s * (y - x);
+        return XMVectorSet(
+            -static_cast<FLOAT>(heightMap.GetWidth()),
+            static_cast<FLOAT>(heightMap.GetHeight()) * 0.75f - 2.0f * static_cast<FLOAT>(heightMap.GetHeight()),
+            -static_cast<FLOAT>(heightMap.GetDepth()),
+            0.0f
+        );
     }
 
-    FLOAT Scene::smoothLerp(FLOAT x, FLOAT y, FLOAT s)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::fillInstanceData
+
+      Summary:  Appends the grid coordinates of the visible cubes in
+                the rows [uBeginDepth, uEndDepth) of the height map to
+                the per-block-type instance arrays
+
+      Args:     const HeightMap& heightMap
+                  Loaded height map
+                const WORD* pFirstVisibleHeights
+                  Lowest exposed cube of each column, see
+                  CullHiddenVoxels
+                UINT uBeginDepth
+                  First row to expand
+                UINT uEndDepth
+                  One past the last row to expand
+                std::vector<std::vector<PackedInstanceData>>& aInstanceData
+                  Instance arrays indexed by block type
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::fillInstanceData(_In_ const HeightMap& heightMap, _In_ const WORD* pFirstVisibleHeights, _In_ UINT uBeginDepth, _In_ UINT uEndDepth, _Inout_ std::vector<std::vector<PackedInstanceData>>& aInstanceData)
     {
-        return lerp(x, y, s * s * (3.0f - 2.0f * s));
+        const UINT uWidth = heightMap.GetWidth();
+        const HeightMapCell* pCells = heightMap.GetCells();
+
+        std::vector<size_t> aNumInstances(aInstanceData.size(), 0u);
+        for (size_t uCellIdx = static_cast<size_t>(uBeginDepth) * uWidth; uCellIdx < static_cast<size_t>(uEndDepth) * uWidth; ++uCellIdx)
+        {
+            size_t uVoxelIdx = static_cast<size_t>(pCells[uCellIdx].BlockType) - static_cast<size_t>(eBlockType::GRASSLAND);
+            if (static_cast<CHAR>(eBlockType::GRASSLAND) <= pCells[uCellIdx].BlockType && uVoxelIdx < aNumInstances.size())
+            {
+                aNumInstances[uVoxelIdx] += pCells[uCellIdx].ColumnHeight - pFirstVisibleHeights[uCellIdx];
+            }
+        }
+
+        for (size_t uVoxelIdx = 0u; uVoxelIdx < aInstanceData.size(); ++uVoxelIdx)
+        {
+            aInstanceData[uVoxelIdx].reserve(aInstanceData[uVoxelIdx].size() + aNumInstances[uVoxelIdx]);
+        }
+
+        for (UINT uDepthIdx = uBeginDepth; uDepthIdx < uEndDepth; ++uDepthIdx)
+        {
+            for (UINT uWidthIdx = 0u; uWidthIdx < uWidth; ++uWidthIdx)
+            {
+                size_t uCellIdx = static_cast<size_t>(uDepthIdx) * uWidth + uWidthIdx;
+                const HeightMapCell& cell = pCells[uCellIdx];
+                if (cell.BlockType < static_cast<CHAR>(eBlockType::GRASSLAND) || static_cast<CHAR>(eBlockType::COUNT) <= cell.BlockType)
+                {
+                    continue;
+                }
+
+                size_t uVoxelIdx = static_cast<size_t>(cell.BlockType) - static_cast<size_t>(eBlockType::GRASSLAND);
+                if (uVoxelIdx >= aInstanceData.size())
+                {
+                    continue;
+                }
+
+                for (UINT heightIdx = pFirstVisibleHeights[uCellIdx]; heightIdx < cell.ColumnHeight; ++heightIdx)
+                {
+                    aInstanceData[uVoxelIdx].push_back(
+                        PackedInstanceData
+                        {
+                            .X = static_cast<INT16>(uWidthIdx),
+                            .Y = static_cast<INT16>(heightIdx),
+                            .Z = static_cast<INT16>(uDepthIdx),
+                            .BlockType = static_cast<INT16>(cell.BlockType)
+                        }
+                    );
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::getDefaultNoise
+
+      Summary:  Returns the noise of PerlinNoise::DEFAULT_SEED, whose
+                table is the hash table the scene always used
+
+      Returns:  const PerlinNoise&
+                  Noise of the default seed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const PerlinNoise& Scene::getDefaultNoise()
+    {
+        static const PerlinNoise s_defaultNoise(PerlinNoise::DEFAULT_SEED);
+
+        return s_defaultNoise;
     }
 }
\ No newline at end of file
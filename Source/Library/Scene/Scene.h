@@ -13,23 +13,45 @@
 
 #include "Common.h"
 
-#include <fstream>
-
+#include "Model/AnimationLod.h"
 #include "Model/Model.h"
 #include "Light/PointLight.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/Skybox.h"
+#include "Scene/ChunkMesher.h"
+#include "Scene/HeightMap.h"
+#include "Scene/PerlinNoise.h"
+#include "Scene/TerrainChunk.h"
+#include "Scene/TerrainStreamer.h"
 #include "Scene/Voxel.h"
+#include "Scene/VoxelCulling.h"
 
 namespace library
 {
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eTerrainMeshing
+
+        Summary:  How the height map is turned into geometry. Instanced
+                  voxels draw one cube per visible voxel, greedy chunks
+                  draw merged quads of the exposed surface, streamed
+                  chunks keep only the voxels around the eye resident
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eTerrainMeshing
+    {
+        INSTANCED_VOXELS,
+        GREEDY_CHUNKS,
+        STREAMED_CHUNKS,
+    };
+
     class Scene
     {
     public:
         static FLOAT GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth);
+        static void GetPerlin2dRow(_In_ FLOAT x, _In_ FLOAT xStep, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uDepth, _In_ UINT uNumSamples, _Out_writes_(uNumSamples) FLOAT* pNoise);
 
         Scene() = delete;
-        Scene(const std::filesystem::path& filePath);
+        Scene(const std::filesystem::path& filePath, eTerrainMeshing terrainMeshing = eTerrainMeshing::INSTANCED_VOXELS, const TerrainStreamingDesc& streamingDesc = TerrainStreamer::DEFAULT_DESC);
+        Scene(std::unique_ptr<HeightMap>&& heightMap, eTerrainMeshing terrainMeshing = eTerrainMeshing::INSTANCED_VOXELS, const TerrainStreamingDesc& streamingDesc = TerrainStreamer::DEFAULT_DESC);
         Scene(const Scene& other) = delete;
         Scene(Scene&& other) = delete;
         Scene& operator=(const Scene& other) = delete;
@@ -48,8 +70,13 @@ namespace library
         HRESULT AddSkyBox(_In_ const std::shared_ptr<Skybox>& skybox);
 
         void Update(_In_ FLOAT deltaTime);
+        void UpdateAnimations(_In_ const XMVECTOR& eye);
+        HRESULT UpdateTerrainStreaming(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const XMVECTOR& eye);
 
         std::vector<std::shared_ptr<Voxel>>& GetVoxels();
+        std::vector<std::shared_ptr<TerrainChunk>>& GetTerrainChunks();
+        const TerrainStreamer* GetTerrainStreamer() const;
+        AnimationLod& GetAnimationLod();
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& GetRenderables();
         std::unordered_map<std::wstring, std::shared_ptr<Model>>& GetModels();
         std::shared_ptr<PointLight>& GetPointLight(_In_ size_t index);
@@ -71,35 +98,37 @@ namespace library
         HRESULT SetPixelShaderOfVoxel(_In_ PCWSTR pszPixelShaderName);
         HRESULT SetMaterialOfVoxel(_In_ PCWSTR pszMaterialName);
 
+        HRESULT SetVertexShaderOfTerrainChunk(_In_ PCWSTR pszVertexShaderName);
+        HRESULT SetPixelShaderOfTerrainChunk(_In_ PCWSTR pszPixelShaderName);
+
 
     private:
-        static FLOAT getNoise2(UINT x, UINT y);
-        static FLOAT getNoise2d(FLOAT x, FLOAT y);
-        static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
-        static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s);
+        void createTerrain(_In_ std::unique_ptr<HeightMap>&& heightMap, _In_ eTerrainMeshing terrainMeshing, _In_ const TerrainStreamingDesc& streamingDesc);
+        void createVoxels(_In_ const HeightMap& heightMap);
+        void createTerrainChunks(_In_ const HeightMap& heightMap);
+        void createTerrainStreamer(_In_ std::unique_ptr<HeightMap>&& heightMap, _In_ const TerrainStreamingDesc& streamingDesc);
+
+        static XMVECTOR getMapOrigin(_In_ const HeightMap& heightMap);
+
+        static void fillInstanceData(_In_ const HeightMap& heightMap, _In_ const WORD* pFirstVisibleHeights, _In_ UINT uBeginDepth, _In_ UINT uEndDepth, _Inout_ std::vector<std::vector<PackedInstanceData>>& aInstanceData);
+
+        static const PerlinNoise& getDefaultNoise();
 
     private:
-        static constexpr const UINT ms_aHashes[] =
-        {
-            208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
-            185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
-            9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
-            70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
-            203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
-            164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
-            228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
-            232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
-            193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
-            101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
-            135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
-            114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
-        };
+        static constexpr const UINT ROWS_PER_CHUNK = 16u;
 
     private:
         std::filesystem::path m_filePath;
         std::vector<std::shared_ptr<Voxel>> m_voxels;
+        std::vector<std::shared_ptr<TerrainChunk>> m_terrainChunks;
+        std::vector<std::shared_ptr<Voxel>> m_streamedVoxels;
+        std::unique_ptr<HeightMap> m_streamedHeightMap;
+        std::unique_ptr<TerrainStreamer> m_terrainStreamer;
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>> m_renderables;
         std::unordered_map<std::wstring, std::shared_ptr<Model>> m_models;
+        std::vector<Model*> m_aModelsToUpdate;
+        std::vector<AnimationLodPose> m_aModelsToPose;
+        AnimationLod m_animationLod;
         std::shared_ptr<PointLight> m_aPointLights[NUM_LIGHTS];
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>> m_vertexShaders;
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>> m_pixelShaders;
@@ -0,0 +1,115 @@
+#include "Scene/TerrainChunk.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::TerrainChunk
+
+      Summary:  Constructor
+
+      Args:     std::vector<SimpleVertex>&& aVertices
+                  Vertices of the merged faces
+                std::vector<WORD>&& aIndices
+                  Indices of the merged faces
+                const XMFLOAT4& outputColor
+                  Color of the block type
+
+      Modifies: [m_aVertices, m_aIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainChunk::TerrainChunk(_In_ std::vector<SimpleVertex>&& aVertices, _In_ std::vector<WORD>&& aIndices, _In_ const XMFLOAT4& outputColor)
+        : Renderable(outputColor)
+        , m_aVertices(std::move(aVertices))
+        , m_aIndices(std::move(aIndices))
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::Initialize
+
+      Summary:  Initializes the buffers of the chunk
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_aMeshes].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainChunk::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    {
+        BasicMeshEntry basicMeshEntry;
+        basicMeshEntry.uNumIndices = GetNumIndices();
+
+        m_aMeshes.push_back(basicMeshEntry);
+
+        return initialize(pDevice, pImmediateContext);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::Update
+
+      Summary:  Does nothing, the chunk is static
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainChunk::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::GetNumVertices
+
+      Summary:  Returns the number of vertices
+
+      Returns:  UINT
+                  Number of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainChunk::GetNumVertices() const
+    {
+        return static_cast<UINT>(m_aVertices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::GetNumIndices
+
+      Summary:  Returns the number of indices
+
+      Returns:  UINT
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainChunk::GetNumIndices() const
+    {
+        return static_cast<UINT>(m_aIndices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::getVertices
+
+      Summary:  Returns the pointer to the vertices data
+
+      Returns:  const SimpleVertex*
+                  Pointer to the vertices data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SimpleVertex* TerrainChunk::getVertices() const
+    {
+        return m_aVertices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainChunk::getIndices
+
+      Summary:  Returns the pointer to the indices data
+
+      Returns:  const WORD*
+                  Pointer to the indices data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const WORD* TerrainChunk::getIndices() const
+    {
+        return m_aIndices.data();
+    }
+}
@@ -0,0 +1,64 @@
+/*+===================================================================
+  File:      TERRAINCHUNK.H
+
+  Summary:   TerrainChunk header file contains declarations of
+             TerrainChunk class used for the lab samples of Game
+             Graphics Programming course.
+
+  Classes: TerrainChunk
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainChunk
+
+      Summary:  Renderable holding the greedy-meshed faces of a single
+                block type in a terrain chunk
+
+      Methods:  Initialize
+                  Initializes the buffers of the chunk
+                Update
+                  Does nothing, the chunk is static
+                GetNumVertices
+                  Returns the number of vertices
+                GetNumIndices
+                  Returns the number of indices
+                TerrainChunk
+                  Constructor.
+                ~TerrainChunk
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainChunk : public Renderable
+    {
+    public:
+        TerrainChunk(_In_ std::vector<SimpleVertex>&& aVertices, _In_ std::vector<WORD>&& aIndices, _In_ const XMFLOAT4& outputColor);
+        TerrainChunk(const TerrainChunk& other) = delete;
+        TerrainChunk(TerrainChunk&& other) = delete;
+        TerrainChunk& operator=(const TerrainChunk& other) = delete;
+        TerrainChunk& operator=(TerrainChunk&& other) = delete;
+        ~TerrainChunk() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        UINT GetNumVertices() const override;
+        UINT GetNumIndices() const override;
+
+    protected:
+        const SimpleVertex* getVertices() const override;
+        const WORD* getIndices() const override;
+
+    private:
+        std::vector<SimpleVertex> m_aVertices;
+        std::vector<WORD> m_aIndices;
+    };
+}
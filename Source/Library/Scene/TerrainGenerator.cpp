@@ -0,0 +1,301 @@
+#include "Scene/TerrainGenerator.h"
+
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::Generate
+
+      Summary:  Generates the block type and column height of every
+                cell, NoiseCache tiles in parallel, and hands the grid to
+                the height map without formatting or parsing any text
+
+      Args:     const TerrainGeneratorDesc& desc
+                  Dimensions and seeds of the terrain
+                HeightMap& heightMap
+                  Generated height map
+                const BiomeThresholds& thresholds
+                  Thresholds of the biomes
+                NoiseCache* pNoiseCache
+                  Cache of the octave fields, nullptr to evaluate every
+                  field
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainGenerator::Generate(_In_ const TerrainGeneratorDesc& desc, _Out_ HeightMap& heightMap, _In_ const BiomeThresholds& thresholds, _In_opt_ NoiseCache* pNoiseCache)
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        UINT64 uNumHits = pNoiseCache ? pNoiseCache->GetNumHits() : 0u;
+        UINT64 uNumMisses = pNoiseCache ? pNoiseCache->GetNumMisses() : 0u;
+
+        BiomeTable biomeTable(thresholds);
+        PerlinNoise heightNoise(desc.uHeightSeed);
+        PerlinNoise moistureNoise(desc.uMoistureSeed);
+
+        std::vector<HeightMapCell> aCells(static_cast<size_t>(desc.uWidth) * static_cast<size_t>(desc.uDepth));
+
+        UINT uNumTilesX = (desc.uWidth + NoiseCache::TILE_SIZE - 1u) / NoiseCache::TILE_SIZE;
+        UINT uNumTilesZ = (desc.uDepth + NoiseCache::TILE_SIZE - 1u) / NoiseCache::TILE_SIZE;
+
+        std::vector<UINT> aTileIndices(static_cast<size_t>(uNumTilesX) * uNumTilesZ);
+        std::iota(aTileIndices.begin(), aTileIndices.end(), 0u);
+
+        std::for_each(std::execution::par, aTileIndices.begin(), aTileIndices.end(),
+            [&](UINT uTileIdx)
+            {
+                generateTile(desc, biomeTable, heightNoise, moistureNoise, pNoiseCache, uTileIdx % uNumTilesX, uTileIdx / uNumTilesX, aCells);
+            }
+        );
+
+        HRESULT hr = heightMap.Create(desc.uWidth, desc.uHeight, desc.uDepth, std::vector<XMFLOAT3>(std::begin(ms_aColors), std::end(ms_aColors)), std::move(aCells));
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        LARGE_INTEGER endTime;
+        QueryPerformanceCounter(&endTime);
+
+        if (pNoiseCache)
+        {
+            uNumHits = pNoiseCache->GetNumHits() - uNumHits;
+            uNumMisses = pNoiseCache->GetNumMisses() - uNumMisses;
+        }
+
+        WCHAR szDebugMessage[256];
+        swprintf_s(szDebugMessage, L"TerrainGenerator: generated %ux%u cells in %.3f ms, noise tiles %llu cached %llu computed\n", desc.uWidth, desc.uDepth,
+            static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart), uNumHits, uNumMisses);
+        OutputDebugString(szDebugMessage);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::ClassifyBiome
+
+      Summary:  Returns the block type of a cell from its normalized
+                height and moisture. This is the reference the
+                BiomeTable is filled from, whole grids go through the
+                table
+
+      Args:     FLOAT height
+                  Normalized height of the cell
+                FLOAT moisture
+                  Normalized moisture of the cell
+                const BiomeThresholds& thresholds
+                  Thresholds of the biomes
+
+      Returns:  eBlockType
+                  Block type of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eBlockType TerrainGenerator::ClassifyBiome(_In_ FLOAT height, _In_ FLOAT moisture, _In_ const BiomeThresholds& thresholds)
+    {
+        if (height < thresholds.OceanHeight)
+        {
+            return eBlockType::OCEAN;
+        }
+
+        if (height < thresholds.SandHeight)
+        {
+            return eBlockType::SAND;
+        }
+
+        if (height > thresholds.MountainHeight)
+        {
+            if (moisture < thresholds.MountainMoisture[0])
+            {
+                return eBlockType::SCORCHED;
+            }
+            if (moisture < thresholds.MountainMoisture[1])
+            {
+                return eBlockType::BARE;
+            }
+            if (moisture < thresholds.MountainMoisture[2])
+            {
+                return eBlockType::TUNDRA;
+            }
+            return eBlockType::SNOW;
+        }
+
+        if (height > thresholds.HighlandHeight)
+        {
+            if (moisture < thresholds.HighlandMoisture[0])
+            {
+                return eBlockType::TEMPERATE_DESERT;
+            }
+            if (moisture < thresholds.HighlandMoisture[1])
+            {
+                return eBlockType::SHRUBLAND;
+            }
+            return eBlockType::TAIGA;
+        }
+
+        if (height > thresholds.MidlandHeight)
+        {
+            if (moisture < thresholds.MidlandMoisture[0])
+            {
+                return eBlockType::TEMPERATE_DESERT;
+            }
+            if (moisture < thresholds.MidlandMoisture[1])
+            {
+                return eBlockType::GRASSLAND;
+            }
+            if (moisture < thresholds.MidlandMoisture[2])
+            {
+                return eBlockType::TEMPERATE_DECIDUOUS_FOREST;
+            }
+            return eBlockType::TEMPERATE_RAIN_FOREST;
+        }
+
+        if (moisture < thresholds.LowlandMoisture[0])
+        {
+            return eBlockType::SUBTROPICAL_DESERT;
+        }
+        if (moisture < thresholds.LowlandMoisture[1])
+        {
+            return eBlockType::GRASSLAND;
+        }
+        if (moisture < thresholds.LowlandMoisture[2])
+        {
+            return eBlockType::TROPICAL_SEASONAL_FOREST;
+        }
+        return eBlockType::TROPICAL_RAIN_FOREST;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::generateTile
+
+      Summary:  Generates the cells of a tile from its height and
+                moisture octave fields, classifying a tile row at a time
+
+      Args:     const TerrainGeneratorDesc& desc
+                  Dimensions of the terrain
+                const BiomeTable& biomeTable
+                  Block types of the biomes
+                const PerlinNoise& heightNoise
+                  Noise of the height
+                const PerlinNoise& moistureNoise
+                  Noise of the moisture
+                NoiseCache* pNoiseCache
+                  Cache of the octave fields, may be nullptr
+                UINT uTileX
+                  x index of the tile
+                UINT uTileZ
+                  z index of the tile
+                std::vector<HeightMapCell>& aCells
+                  Cells of the terrain, only the tile is written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::generateTile(_In_ const TerrainGeneratorDesc& desc, _In_ const BiomeTable& biomeTable, _In_ const PerlinNoise& heightNoise, _In_ const PerlinNoise& moistureNoise, _In_opt_ NoiseCache* pNoiseCache, _In_ UINT uTileX, _In_ UINT uTileZ, _Inout_ std::vector<HeightMapCell>& aCells)
+    {
+        OctaveTiles heightTiles;
+        getOctaveTiles(heightNoise, pNoiseCache, uTileX, uTileZ, heightTiles);
+
+        OctaveTiles moistureTiles;
+        if (moistureNoise.GetSeed() == heightNoise.GetSeed())
+        {
+            moistureTiles = heightTiles;
+        }
+        else
+        {
+            getOctaveTiles(moistureNoise, pNoiseCache, uTileX, uTileZ, moistureTiles);
+        }
+
+        UINT uBeginX = uTileX * NoiseCache::TILE_SIZE;
+        UINT uBeginZ = uTileZ * NoiseCache::TILE_SIZE;
+        UINT uEndX = uBeginX + NoiseCache::TILE_SIZE < desc.uWidth ? uBeginX + NoiseCache::TILE_SIZE : desc.uWidth;
+        UINT uEndZ = uBeginZ + NoiseCache::TILE_SIZE < desc.uDepth ? uBeginZ + NoiseCache::TILE_SIZE : desc.uDepth;
+
+        FLOAT aHeights[NoiseCache::TILE_SIZE];
+        FLOAT aMoistures[NoiseCache::TILE_SIZE];
+        CHAR aBlockTypes[NoiseCache::TILE_SIZE];
+        UINT uNumColumns = uEndX - uBeginX;
+
+        for (UINT z = uBeginZ; z < uEndZ; ++z)
+        {
+            size_t uRowIdx = static_cast<size_t>(z - uBeginZ) * NoiseCache::TILE_SIZE;
+            for (UINT i = 0u; i < uNumColumns; ++i)
+            {
+                aHeights[i] = sumOctaves(heightTiles, uRowIdx + i);
+                aMoistures[i] = sumOctaves(moistureTiles, uRowIdx + i);
+            }
+
+            biomeTable.ClassifyCells(aHeights, aMoistures, uNumColumns, aBlockTypes);
+
+            HeightMapCell* pCells = aCells.data() + static_cast<size_t>(z) * desc.uWidth + uBeginX;
+            for (UINT i = 0u; i < uNumColumns; ++i)
+            {
+                pCells[i] = HeightMapCell
+                {
+                    .BlockType = aBlockTypes[i],
+                    .Reserved = 0u,
+                    .ColumnHeight = HeightMap::GetColumnHeight(desc.uHeight, aHeights[i])
+                };
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::getOctaveTiles
+
+      Summary:  Gets the octave fields of a tile from the cache, or
+                computes them when there is no cache
+
+      Args:     const PerlinNoise& noise
+                  Seeded noise of the fields
+                NoiseCache* pNoiseCache
+                  Cache of the octave fields, may be nullptr
+                UINT uTileX
+                  x index of the tile
+                UINT uTileZ
+                  z index of the tile
+                OctaveTiles& octaveTiles
+                  Octave fields of the tile
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::getOctaveTiles(_In_ const PerlinNoise& noise, _In_opt_ NoiseCache* pNoiseCache, _In_ UINT uTileX, _In_ UINT uTileZ, _Out_ OctaveTiles& octaveTiles)
+    {
+        for (UINT i = 0u; i < NUM_OCTAVES; ++i)
+        {
+            octaveTiles.aTiles[i] = pNoiseCache ? pNoiseCache->GetOctaveTile(noise, i, uTileX, uTileZ) : NoiseCache::ComputeOctaveTile(noise, i, uTileX, uTileZ);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::sumOctaves
+
+      Summary:  Returns the normalized fractal value of a sample, the
+                octaves weighted by the inverse of their frequency
+
+      Args:     const OctaveTiles& octaveTiles
+                  Octave fields of the tile
+                size_t uSampleIdx
+                  Index of the sample in the tile
+
+      Returns:  FLOAT
+                  Normalized value of the sample
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainGenerator::sumOctaves(_In_ const OctaveTiles& octaveTiles, _In_ size_t uSampleIdx)
+    {
+        FLOAT value = 0.0f;
+
+        FLOAT frequencySum = 0.0f;
+        for (UINT i = 0u; i < NUM_OCTAVES; ++i)
+        {
+            FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
+            frequencySum += 1.0f / frequency;
+            value += (*octaveTiles.aTiles[i])[uSampleIdx] / frequency;
+        }
+        value /= frequencySum;
+        value = pow(value * 1.2f, 1.25f);
+
+        assert(value >= 0.0f);
+
+        return value;
+    }
+}
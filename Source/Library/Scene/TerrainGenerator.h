@@ -0,0 +1,112 @@
+/*+===================================================================
+  File:      TERRAINGENERATOR.H
+
+  Summary:   TerrainGenerator header file contains declarations of
+             TerrainGenerator class that builds the block type and
+             height grid of the voxel terrain in memory used for the
+             lab samples of Game Graphics Programming course.
+
+  Classes: TerrainGenerator
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/BiomeTable.h"
+#include "Scene/HeightMap.h"
+#include "Scene/NoiseCache.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TerrainGeneratorDesc
+
+      Summary:  Dimensions and seeds of the generated terrain. uHeight
+                is the number of voxels of a column of normalized height
+                1. Equal seeds make the moisture follow the height, as
+                the terrain always did with the default seeds
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainGeneratorDesc
+    {
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        UINT uHeightSeed;
+        UINT uMoistureSeed;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainGenerator
+
+      Summary:  Generates the height map of the voxel terrain from
+                fractal Perlin noise, NoiseCache tiles in parallel,
+                straight into a HeightMap. With a cache, regenerating
+                with new thresholds or one new seed only evaluates the
+                noise fields that changed
+
+      Methods:  Generate
+                  Generates a height map
+                ClassifyBiome
+                  Returns the block type of a height and moisture
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainGenerator final
+    {
+    public:
+        static constexpr const UINT NUM_OCTAVES = 4u;
+        static constexpr const BiomeThresholds DEFAULT_BIOME_THRESHOLDS =
+        {
+            .OceanHeight = 0.1f,
+            .SandHeight = 0.12f,
+            .MountainHeight = 0.8f,
+            .HighlandHeight = 0.6f,
+            .MidlandHeight = 0.3f,
+            .MountainMoisture = { 0.1f, 0.2f, 0.5f },
+            .HighlandMoisture = { 0.33f, 0.66f },
+            .MidlandMoisture = { 0.16f, 0.5f, 0.83f },
+            .LowlandMoisture = { 0.16f, 0.33f, 0.66f }
+        };
+
+    public:
+        TerrainGenerator() = delete;
+        TerrainGenerator(const TerrainGenerator& other) = delete;
+        TerrainGenerator(TerrainGenerator&& other) = delete;
+        TerrainGenerator& operator=(const TerrainGenerator& other) = delete;
+        TerrainGenerator& operator=(TerrainGenerator&& other) = delete;
+        ~TerrainGenerator() = delete;
+
+        static HRESULT Generate(_In_ const TerrainGeneratorDesc& desc, _Out_ HeightMap& heightMap, _In_ const BiomeThresholds& thresholds = DEFAULT_BIOME_THRESHOLDS, _In_opt_ NoiseCache* pNoiseCache = nullptr);
+        static eBlockType ClassifyBiome(_In_ FLOAT height, _In_ FLOAT moisture, _In_ const BiomeThresholds& thresholds = DEFAULT_BIOME_THRESHOLDS);
+
+    private:
+        struct OctaveTiles
+        {
+            std::shared_ptr<const std::vector<FLOAT>> aTiles[NUM_OCTAVES];
+        };
+
+        static void generateTile(_In_ const TerrainGeneratorDesc& desc, _In_ const BiomeTable& biomeTable, _In_ const PerlinNoise& heightNoise, _In_ const PerlinNoise& moistureNoise, _In_opt_ NoiseCache* pNoiseCache, _In_ UINT uTileX, _In_ UINT uTileZ, _Inout_ std::vector<HeightMapCell>& aCells);
+        static void getOctaveTiles(_In_ const PerlinNoise& noise, _In_opt_ NoiseCache* pNoiseCache, _In_ UINT uTileX, _In_ UINT uTileZ, _Out_ OctaveTiles& octaveTiles);
+        static FLOAT sumOctaves(_In_ const OctaveTiles& octaveTiles, _In_ size_t uSampleIdx);
+
+    private:
+        static constexpr const XMFLOAT3 ms_aColors[] =
+        {
+            XMFLOAT3(0.0f,      0.666f, 0.0f),      // GRASSLAND
+            XMFLOAT3(1.0f,      1.0f,   1.0f),      // SNOW
+            XMFLOAT3(0.0f,      0.0f,   0.666f),    // OCEAN
+            XMFLOAT3(1.0f,      0.666f, 0.0f),      // SAND
+            XMFLOAT3(0.666f,    0.0f,   0.0f),      // SCORCHED
+            XMFLOAT3(0.956f,    0.643f, 0.376f),    // BARE
+            XMFLOAT3(0.941f,    0.0f,   1.0f),      // TUNDRA
+            XMFLOAT3(0.803f,    0.521f, 0.247f),    // TEMPERATE_DESERT
+            XMFLOAT3(0.42f,     0.556f, 0.137f),    // SHRUBLAND
+            XMFLOAT3(0.0f,      0.392f, 0.0f),      // TAIGA
+            XMFLOAT3(1.0f,      0.55f,  0.0f),      // TEMPERATE_DECIDUOUS_FOREST
+            XMFLOAT3(0.0f,      0.5f,   0.0f),      // TEMPERATE_RAIN_FOREST
+            XMFLOAT3(0.956f,    0.643f, 0.376f),    // SUBTROPICAL_DESERT
+            XMFLOAT3(0.133f,    0.545f, 0.133f),    // TROPICAL_SEASONAL_FOREST
+            XMFLOAT3(0.15f,     0.372f, 0.15f),     // TROPICAL_RAIN_FOREST
+        };
+    };
+}
@@ -0,0 +1,745 @@
+#include "Scene/TerrainStreamer.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::TerrainStreamer
+
+      Summary:  Constructor. Starts the loader thread
+
+      Args:     const HeightMap& heightMap
+                  Loaded height map, must outlive the streamer
+                const TerrainStreamingDesc& desc
+                  Residency settings
+
+      Modifies: [m_heightMap, m_desc, m_uNumChunksX, m_uNumChunksZ,
+                 m_eyeChunkX, m_eyeChunkZ, m_aInstanceData,
+                 m_aDirtyRanges, m_residentChunks,
+                 m_requestedChunks, m_rejectedChunks, m_stats, m_mutex,
+                 m_loadCondition, m_idleCondition, m_aPendingLoads,
+                 m_aCompletedLoads, m_uNumLoadsInFlight, m_bIsRunning,
+                 m_loaderThread].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainStreamer::TerrainStreamer(_In_ const HeightMap& heightMap, _In_ const TerrainStreamingDesc& desc)
+        : m_heightMap(heightMap)
+        , m_desc(desc)
+        , m_uNumChunksX((heightMap.GetWidth() + desc.uChunkSize - 1u) / desc.uChunkSize)
+        , m_uNumChunksZ((heightMap.GetDepth() + desc.uChunkSize - 1u) / desc.uChunkSize)
+        , m_eyeChunkX(INT_MIN)
+        , m_eyeChunkZ(INT_MIN)
+        , m_aInstanceData(heightMap.GetNumColors())
+        , m_aDirtyRanges(heightMap.GetNumColors())
+        , m_residentChunks()
+        , m_requestedChunks()
+        , m_rejectedChunks()
+        , m_stats()
+        , m_mutex()
+        , m_loadCondition()
+        , m_idleCondition()
+        , m_aPendingLoads()
+        , m_aCompletedLoads()
+        , m_uNumLoadsInFlight(0u)
+        , m_bIsRunning(TRUE)
+        , m_loaderThread(&TerrainStreamer::runLoader, this)
+    {
+        assert(desc.uChunkSize > 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::~TerrainStreamer
+
+      Summary:  Destructor. Stops and joins the loader thread
+
+      Modifies: [m_bIsRunning, m_loaderThread].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainStreamer::~TerrainStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bIsRunning = FALSE;
+        }
+        m_loadCondition.notify_all();
+
+        if (m_loaderThread.joinable())
+        {
+            m_loaderThread.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::Update
+
+      Summary:  Evicts the chunks that left the load radius, merges the
+                chunks finished by the loader thread nearest first, and
+                requests the missing chunks around the eye. Merging
+                evicts farther chunks when the memory budget is reached
+
+      Args:     const XMFLOAT3& gridEye
+                  Eye position in height map grid coordinates
+
+      Modifies: [m_eyeChunkX, m_eyeChunkZ, m_aInstanceData,
+                 m_aDirtyRanges, m_residentChunks,
+                 m_requestedChunks, m_rejectedChunks, m_stats,
+                 m_aPendingLoads, m_aCompletedLoads].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::Update(_In_ const XMFLOAT3& gridEye)
+    {
+        const INT radius = static_cast<INT>(m_desc.uLoadRadius);
+        const FLOAT chunkSize = static_cast<FLOAT>(m_desc.uChunkSize);
+
+        // Clamp the eye so that distances in chunks cannot overflow
+        FLOAT eyeChunkX = floorf(gridEye.x / chunkSize);
+        FLOAT eyeChunkZ = floorf(gridEye.z / chunkSize);
+        eyeChunkX = eyeChunkX < static_cast<FLOAT>(-radius - 1) ? static_cast<FLOAT>(-radius - 1) : eyeChunkX;
+        eyeChunkX = eyeChunkX > static_cast<FLOAT>(m_uNumChunksX + m_desc.uLoadRadius) ? static_cast<FLOAT>(m_uNumChunksX + m_desc.uLoadRadius) : eyeChunkX;
+        eyeChunkZ = eyeChunkZ < static_cast<FLOAT>(-radius - 1) ? static_cast<FLOAT>(-radius - 1) : eyeChunkZ;
+        eyeChunkZ = eyeChunkZ > static_cast<FLOAT>(m_uNumChunksZ + m_desc.uLoadRadius) ? static_cast<FLOAT>(m_uNumChunksZ + m_desc.uLoadRadius) : eyeChunkZ;
+
+        if (static_cast<INT>(eyeChunkX) != m_eyeChunkX || static_cast<INT>(eyeChunkZ) != m_eyeChunkZ)
+        {
+            m_eyeChunkX = static_cast<INT>(eyeChunkX);
+            m_eyeChunkZ = static_cast<INT>(eyeChunkZ);
+
+            // Chunks that did not fit may fit around the new eye
+            m_rejectedChunks.clear();
+        }
+
+        const UINT uLoadDistanceSquared = static_cast<UINT>(radius * radius);
+        const UINT uEvictDistanceSquared = static_cast<UINT>((radius + 1) * (radius + 1));
+
+        std::vector<UINT> aEvictedChunks;
+        for (const auto& [uChunkIdx, residentChunk] : m_residentChunks)
+        {
+            if (getDistanceSquared(uChunkIdx) > uEvictDistanceSquared)
+            {
+                aEvictedChunks.push_back(uChunkIdx);
+            }
+        }
+
+        for (UINT uChunkIdx : aEvictedChunks)
+        {
+            evictChunk(uChunkIdx);
+        }
+
+        std::vector<LoadedChunk> aCompletedLoads;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            aCompletedLoads.swap(m_aCompletedLoads);
+
+            for (auto it = m_aPendingLoads.begin(); it != m_aPendingLoads.end();)
+            {
+                if (getDistanceSquared(*it) > uLoadDistanceSquared)
+                {
+                    m_requestedChunks.erase(*it);
+                    it = m_aPendingLoads.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        std::sort(aCompletedLoads.begin(), aCompletedLoads.end(),
+            [this](const LoadedChunk& a, const LoadedChunk& b)
+            {
+                return getDistanceSquared(a.uChunkIdx) < getDistanceSquared(b.uChunkIdx);
+            }
+        );
+
+        for (LoadedChunk& loadedChunk : aCompletedLoads)
+        {
+            m_requestedChunks.erase(loadedChunk.uChunkIdx);
+
+            UINT uDistanceSquared = getDistanceSquared(loadedChunk.uChunkIdx);
+            if (uDistanceSquared > uLoadDistanceSquared)
+            {
+                ++m_stats.uNumDiscardedLoads;
+                continue;
+            }
+
+            if (!makeRoom(loadedChunk.uNumBytes, uDistanceSquared))
+            {
+                ++m_stats.uNumDiscardedLoads;
+                m_rejectedChunks.insert(loadedChunk.uChunkIdx);
+                continue;
+            }
+
+            insertChunk(loadedChunk);
+        }
+
+        std::vector<UINT> aRequests;
+        for (INT dz = -radius; dz <= radius; ++dz)
+        {
+            for (INT dx = -radius; dx <= radius; ++dx)
+            {
+                INT chunkX = m_eyeChunkX + dx;
+                INT chunkZ = m_eyeChunkZ + dz;
+                if (chunkX < 0 || chunkZ < 0 || chunkX >= static_cast<INT>(m_uNumChunksX) || chunkZ >= static_cast<INT>(m_uNumChunksZ) ||
+                    static_cast<UINT>(dx * dx + dz * dz) > uLoadDistanceSquared)
+                {
+                    continue;
+                }
+
+                UINT uChunkIdx = static_cast<UINT>(chunkZ) * m_uNumChunksX + static_cast<UINT>(chunkX);
+                if (!m_residentChunks.contains(uChunkIdx) && !m_requestedChunks.contains(uChunkIdx) && !m_rejectedChunks.contains(uChunkIdx))
+                {
+                    aRequests.push_back(uChunkIdx);
+                }
+            }
+        }
+
+        if (!aRequests.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (UINT uChunkIdx : aRequests)
+                {
+                    m_aPendingLoads.push_back(uChunkIdx);
+                    m_requestedChunks.insert(uChunkIdx);
+                }
+
+                std::sort(m_aPendingLoads.begin(), m_aPendingLoads.end(),
+                    [this](UINT a, UINT b)
+                    {
+                        return getDistanceSquared(a) < getDistanceSquared(b);
+                    }
+                );
+            }
+            m_loadCondition.notify_all();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::WaitForIdle
+
+      Summary:  Blocks until every requested chunk has been loaded. The
+                loads are merged by the next Update
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::WaitForIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idleCondition.wait(lock,
+            [this]()
+            {
+                return m_aPendingLoads.empty() && m_uNumLoadsInFlight == 0u;
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::GetNumBlockTypes
+
+      Summary:  Returns the number of instance arrays
+
+      Returns:  UINT
+                  Number of palette entries of the height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainStreamer::GetNumBlockTypes() const
+    {
+        return static_cast<UINT>(m_aInstanceData.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::GetInstanceData
+
+      Summary:  Returns the resident instances of a block type
+
+      Args:     UINT uBlockTypeIdx
+                  Index of the block type, relative to GRASSLAND
+
+      Returns:  const std::vector<PackedInstanceData>&
+                  Resident instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<PackedInstanceData>& TerrainStreamer::GetInstanceData(_In_ UINT uBlockTypeIdx) const
+    {
+        assert(uBlockTypeIdx < m_aInstanceData.size());
+
+        return m_aInstanceData[uBlockTypeIdx];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::GetDirtyRanges
+
+      Summary:  Returns the ranges of instances of a block type changed
+                since the last ClearDirtyRanges. Instances past the end
+                of the array were removed and need no upload
+
+      Args:     UINT uBlockTypeIdx
+                  Index of the block type, relative to GRASSLAND
+
+      Returns:  const std::vector<InstanceRange>&
+                  Changed ranges, empty if the array did not change
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<InstanceRange>& TerrainStreamer::GetDirtyRanges(_In_ UINT uBlockTypeIdx) const
+    {
+        assert(uBlockTypeIdx < m_aDirtyRanges.size());
+
+        return m_aDirtyRanges[uBlockTypeIdx];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::ClearDirtyRanges
+
+      Summary:  Marks every instance array as uploaded
+
+      Modifies: [m_aDirtyRanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::ClearDirtyRanges()
+    {
+        for (std::vector<InstanceRange>& aDirtyRanges : m_aDirtyRanges)
+        {
+            aDirtyRanges.clear();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::GetStats
+
+      Summary:  Returns the load and eviction counters
+
+      Returns:  const TerrainStreamingStats&
+                  Counters since construction
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TerrainStreamingStats& TerrainStreamer::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::runLoader
+
+      Summary:  Loader thread. Expands the pending chunks nearest first
+                until the streamer is destroyed
+
+      Modifies: [m_aPendingLoads, m_aCompletedLoads,
+                 m_uNumLoadsInFlight].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::runLoader()
+    {
+        for (;;)
+        {
+            UINT uChunkIdx = 0u;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_loadCondition.wait(lock,
+                    [this]()
+                    {
+                        return !m_bIsRunning || !m_aPendingLoads.empty();
+                    }
+                );
+
+                if (!m_bIsRunning)
+                {
+                    return;
+                }
+
+                uChunkIdx = m_aPendingLoads.front();
+                m_aPendingLoads.pop_front();
+                ++m_uNumLoadsInFlight;
+            }
+
+            LoadedChunk loadedChunk;
+            loadChunk(uChunkIdx, loadedChunk);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_aCompletedLoads.push_back(std::move(loadedChunk));
+                --m_uNumLoadsInFlight;
+            }
+            m_idleCondition.notify_all();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::loadChunk
+
+      Summary:  Expands the visible cubes of a chunk into packed
+                instances. The chunk is culled with a one column border
+                copied from its neighbours so that the result matches
+                culling the whole map
+
+      Args:     UINT uChunkIdx
+                  Index of the chunk, row-major
+                LoadedChunk& loadedChunk
+                  Expanded chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::loadChunk(_In_ UINT uChunkIdx, _Out_ LoadedChunk& loadedChunk) const
+    {
+        const UINT uWidth = m_heightMap.GetWidth();
+        const UINT uDepth = m_heightMap.GetDepth();
+        const HeightMapCell* pCells = m_heightMap.GetCells();
+
+        const UINT uBeginX = (uChunkIdx % m_uNumChunksX) * m_desc.uChunkSize;
+        const UINT uBeginZ = (uChunkIdx / m_uNumChunksX) * m_desc.uChunkSize;
+        const UINT uChunkWidth = uBeginX + m_desc.uChunkSize > uWidth ? uWidth - uBeginX : m_desc.uChunkSize;
+        const UINT uChunkDepth = uBeginZ + m_desc.uChunkSize > uDepth ? uDepth - uBeginZ : m_desc.uChunkSize;
+
+        // Columns outside the map are left empty, as CullHiddenVoxels expects
+        const UINT uPaddedWidth = uChunkWidth + 2u;
+        const UINT uPaddedDepth = uChunkDepth + 2u;
+        std::vector<HeightMapCell> aPaddedCells(static_cast<size_t>(uPaddedWidth) * uPaddedDepth, HeightMapCell{});
+        for (UINT uPaddedZ = 0u; uPaddedZ < uPaddedDepth; ++uPaddedZ)
+        {
+            INT z = static_cast<INT>(uBeginZ + uPaddedZ) - 1;
+            if (z < 0 || z >= static_cast<INT>(uDepth))
+            {
+                continue;
+            }
+
+            for (UINT uPaddedX = 0u; uPaddedX < uPaddedWidth; ++uPaddedX)
+            {
+                INT x = static_cast<INT>(uBeginX + uPaddedX) - 1;
+                if (x < 0 || x >= static_cast<INT>(uWidth))
+                {
+                    continue;
+                }
+
+                aPaddedCells[static_cast<size_t>(uPaddedZ) * uPaddedWidth + uPaddedX] = pCells[static_cast<size_t>(z) * uWidth + static_cast<size_t>(x)];
+            }
+        }
+
+        std::vector<WORD> aFirstVisibleHeights(aPaddedCells.size());
+        CullHiddenVoxels(aPaddedCells.data(), uPaddedWidth, uPaddedDepth, aFirstVisibleHeights.data());
+
+        loadedChunk.uChunkIdx = uChunkIdx;
+        loadedChunk.uNumBytes = 0u;
+        loadedChunk.aInstanceData.assign(m_aInstanceData.size(), std::vector<PackedInstanceData>());
+
+        for (UINT uPaddedZ = 1u; uPaddedZ <= uChunkDepth; ++uPaddedZ)
+        {
+            for (UINT uPaddedX = 1u; uPaddedX <= uChunkWidth; ++uPaddedX)
+            {
+                size_t uPaddedIdx = static_cast<size_t>(uPaddedZ) * uPaddedWidth + uPaddedX;
+                const HeightMapCell& cell = aPaddedCells[uPaddedIdx];
+                if (cell.BlockType < static_cast<CHAR>(eBlockType::GRASSLAND) || static_cast<CHAR>(eBlockType::COUNT) <= cell.BlockType)
+                {
+                    continue;
+                }
+
+                size_t uVoxelIdx = static_cast<size_t>(cell.BlockType) - static_cast<size_t>(eBlockType::GRASSLAND);
+                if (uVoxelIdx >= loadedChunk.aInstanceData.size())
+                {
+                    continue;
+                }
+
+                for (UINT heightIdx = aFirstVisibleHeights[uPaddedIdx]; heightIdx < cell.ColumnHeight; ++heightIdx)
+                {
+                    loadedChunk.aInstanceData[uVoxelIdx].push_back(
+                        PackedInstanceData
+                        {
+                            .X = static_cast<INT16>(uBeginX + uPaddedX - 1u),
+                            .Y = static_cast<INT16>(heightIdx),
+                            .Z = static_cast<INT16>(uBeginZ + uPaddedZ - 1u),
+                            .BlockType = static_cast<INT16>(cell.BlockType)
+                        }
+                    );
+                }
+            }
+        }
+
+        for (const std::vector<PackedInstanceData>& aInstanceData : loadedChunk.aInstanceData)
+        {
+            loadedChunk.uNumBytes += aInstanceData.size() * sizeof(PackedInstanceData);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::makeRoom
+
+      Summary:  Evicts resident chunks farther than the given distance,
+                farthest first, until the given number of bytes fits in
+                the memory budget
+
+      Args:     UINT64 uNumBytes
+                  Size of the chunk to insert
+                UINT uDistanceSquared
+                  Squared distance in chunks of the chunk to insert
+
+      Modifies: [m_aInstanceData, m_aDirtyRanges, m_residentChunks,
+                 m_stats].
+
+      Returns:  BOOL
+                  TRUE if the chunk fits
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL TerrainStreamer::makeRoom(_In_ UINT64 uNumBytes, _In_ UINT uDistanceSquared)
+    {
+        if (uNumBytes > m_desc.uMemoryBudget)
+        {
+            return FALSE;
+        }
+
+        while (m_stats.uResidentBytes + uNumBytes > m_desc.uMemoryBudget)
+        {
+            UINT uFarthestChunkIdx = 0u;
+            UINT uFarthestDistanceSquared = 0u;
+            BOOL bHasFarthestChunk = FALSE;
+            for (const auto& [uChunkIdx, residentChunk] : m_residentChunks)
+            {
+                UINT uResidentDistanceSquared = getDistanceSquared(uChunkIdx);
+                if (!bHasFarthestChunk || uResidentDistanceSquared > uFarthestDistanceSquared)
+                {
+                    uFarthestChunkIdx = uChunkIdx;
+                    uFarthestDistanceSquared = uResidentDistanceSquared;
+                    bHasFarthestChunk = TRUE;
+                }
+            }
+
+            if (!bHasFarthestChunk || uFarthestDistanceSquared <= uDistanceSquared)
+            {
+                return FALSE;
+            }
+
+            evictChunk(uFarthestChunkIdx);
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::insertChunk
+
+      Summary:  Appends the instances of a loaded chunk to the instance
+                arrays
+
+      Args:     LoadedChunk& loadedChunk
+                  Loaded chunk, its instances are consumed
+
+      Modifies: [m_aInstanceData, m_aDirtyRanges, m_residentChunks,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::insertChunk(_Inout_ LoadedChunk& loadedChunk)
+    {
+        ResidentChunk residentChunk =
+        {
+            .uNumBytes = loadedChunk.uNumBytes,
+            .aRanges = std::vector<std::vector<InstanceRange>>(m_aInstanceData.size())
+        };
+
+        for (UINT uVoxelIdx = 0u; uVoxelIdx < static_cast<UINT>(m_aInstanceData.size()); ++uVoxelIdx)
+        {
+            std::vector<PackedInstanceData>& aChunkInstanceData = loadedChunk.aInstanceData[uVoxelIdx];
+            if (aChunkInstanceData.empty())
+            {
+                continue;
+            }
+
+            InstanceRange range =
+            {
+                .uOffset = static_cast<UINT>(m_aInstanceData[uVoxelIdx].size()),
+                .uCount = static_cast<UINT>(aChunkInstanceData.size())
+            };
+            m_aInstanceData[uVoxelIdx].insert(m_aInstanceData[uVoxelIdx].end(), aChunkInstanceData.begin(), aChunkInstanceData.end());
+            residentChunk.aRanges[uVoxelIdx].push_back(range);
+            addDirtyRange(uVoxelIdx, range);
+        }
+
+        m_residentChunks.emplace(loadedChunk.uChunkIdx, std::move(residentChunk));
+
+        m_stats.uResidentBytes += loadedChunk.uNumBytes;
+        if (m_stats.uResidentBytes > m_stats.uPeakResidentBytes)
+        {
+            m_stats.uPeakResidentBytes = m_stats.uResidentBytes;
+        }
+        ++m_stats.uNumLoads;
+        m_stats.uNumResidentChunks = static_cast<UINT>(m_residentChunks.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::evictChunk
+
+      Summary:  Removes the instances of a resident chunk. The holes
+                are filled with the instances at the end of each array
+                instead of moving every later chunk down
+
+      Args:     UINT uChunkIdx
+                  Index of the resident chunk
+
+      Modifies: [m_aInstanceData, m_aDirtyRanges, m_residentChunks,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::evictChunk(_In_ UINT uChunkIdx)
+    {
+        auto evicted = m_residentChunks.find(uChunkIdx);
+        if (evicted == m_residentChunks.end())
+        {
+            return;
+        }
+
+        ResidentChunk evictedChunk = std::move(evicted->second);
+        m_residentChunks.erase(evicted);
+
+        for (UINT uVoxelIdx = 0u; uVoxelIdx < static_cast<UINT>(m_aInstanceData.size()); ++uVoxelIdx)
+        {
+            // Highest first, so that the instances moved into a hole never come from a range still to be removed
+            std::vector<InstanceRange>& aRanges = evictedChunk.aRanges[uVoxelIdx];
+            std::sort(aRanges.begin(), aRanges.end(),
+                [](const InstanceRange& a, const InstanceRange& b)
+                {
+                    return a.uOffset > b.uOffset;
+                }
+            );
+
+            for (const InstanceRange& range : aRanges)
+            {
+                removeRange(uVoxelIdx, range);
+            }
+        }
+
+        m_stats.uResidentBytes -= evictedChunk.uNumBytes;
+        ++m_stats.uNumEvictions;
+        m_stats.uNumResidentChunks = static_cast<UINT>(m_residentChunks.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::removeRange
+
+      Summary:  Removes a range of instances that no resident chunk
+                owns by moving the instances at the end of the array
+                into it. The moved instances stay with their chunk as
+                a new range of that chunk
+
+      Args:     UINT uBlockTypeIdx
+                  Index of the block type, relative to GRASSLAND
+                const InstanceRange& removedRange
+                  Range to remove
+
+      Modifies: [m_aInstanceData, m_aDirtyRanges, m_residentChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::removeRange(_In_ UINT uBlockTypeIdx, _In_ const InstanceRange& removedRange)
+    {
+        std::vector<PackedInstanceData>& aInstanceData = m_aInstanceData[uBlockTypeIdx];
+        InstanceRange hole = removedRange;
+        while (hole.uCount > 0u)
+        {
+            UINT uNumInstances = static_cast<UINT>(aInstanceData.size());
+            if (hole.uOffset + hole.uCount == uNumInstances)
+            {
+                aInstanceData.resize(hole.uOffset);
+                break;
+            }
+
+            // Find the range at the end of the array
+            std::vector<InstanceRange>* pLastRanges = nullptr;
+            InstanceRange* pLastRange = nullptr;
+            for (auto& [uResidentChunkIdx, residentChunk] : m_residentChunks)
+            {
+                for (InstanceRange& range : residentChunk.aRanges[uBlockTypeIdx])
+                {
+                    if (range.uOffset + range.uCount == uNumInstances)
+                    {
+                        pLastRanges = &residentChunk.aRanges[uBlockTypeIdx];
+                        pLastRange = &range;
+                        break;
+                    }
+                }
+
+                if (pLastRange)
+                {
+                    break;
+                }
+            }
+            assert(pLastRange != nullptr);
+
+            UINT uNumMoved = pLastRange->uCount < hole.uCount ? pLastRange->uCount : hole.uCount;
+            std::copy(aInstanceData.end() - uNumMoved, aInstanceData.end(), aInstanceData.begin() + hole.uOffset);
+            aInstanceData.resize(uNumInstances - uNumMoved);
+
+            InstanceRange movedRange =
+            {
+                .uOffset = hole.uOffset,
+                .uCount = uNumMoved
+            };
+            addDirtyRange(uBlockTypeIdx, movedRange);
+
+            pLastRange->uCount -= uNumMoved;
+            if (pLastRange->uCount == 0u)
+            {
+                pLastRanges->erase(pLastRanges->begin() + (pLastRange - pLastRanges->data()));
+            }
+
+            auto adjacent = std::find_if(pLastRanges->begin(), pLastRanges->end(),
+                [&movedRange](const InstanceRange& range)
+                {
+                    return range.uOffset + range.uCount == movedRange.uOffset;
+                }
+            );
+            if (adjacent != pLastRanges->end())
+            {
+                adjacent->uCount += movedRange.uCount;
+            }
+            else
+            {
+                pLastRanges->push_back(movedRange);
+            }
+
+            hole.uOffset += uNumMoved;
+            hole.uCount -= uNumMoved;
+        }
+
+        // Ranges past the new end were removed
+        UINT uNumInstances = static_cast<UINT>(aInstanceData.size());
+        std::vector<InstanceRange>& aDirtyRanges = m_aDirtyRanges[uBlockTypeIdx];
+        for (auto it = aDirtyRanges.begin(); it != aDirtyRanges.end();)
+        {
+            if (it->uOffset >= uNumInstances)
+            {
+                it = aDirtyRanges.erase(it);
+                continue;
+            }
+
+            if (it->uOffset + it->uCount > uNumInstances)
+            {
+                it->uCount = uNumInstances - it->uOffset;
+            }
+            ++it;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::addDirtyRange
+
+      Summary:  Records a range of instances to upload, merged with the
+                last recorded range when they touch
+
+      Args:     UINT uBlockTypeIdx
+                  Index of the block type, relative to GRASSLAND
+                const InstanceRange& dirtyRange
+                  Changed range
+
+      Modifies: [m_aDirtyRanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainStreamer::addDirtyRange(_In_ UINT uBlockTypeIdx, _In_ const InstanceRange& dirtyRange)
+    {
+        std::vector<InstanceRange>& aDirtyRanges = m_aDirtyRanges[uBlockTypeIdx];
+        if (!aDirtyRanges.empty() && aDirtyRanges.back().uOffset + aDirtyRanges.back().uCount == dirtyRange.uOffset)
+        {
+            aDirtyRanges.back().uCount += dirtyRange.uCount;
+            return;
+        }
+
+        aDirtyRanges.push_back(dirtyRange);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainStreamer::getDistanceSquared
+
+      Summary:  Returns the squared distance in chunks between a chunk
+                and the chunk of the eye
+
+      Args:     UINT uChunkIdx
+                  Index of the chunk, row-major
+
+      Returns:  UINT
+                  Squared distance in chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainStreamer::getDistanceSquared(_In_ UINT uChunkIdx) const
+    {
+        INT dx = static_cast<INT>(uChunkIdx % m_uNumChunksX) - m_eyeChunkX;
+        INT dz = static_cast<INT>(uChunkIdx / m_uNumChunksX) - m_eyeChunkZ;
+
+        return static_cast<UINT>(dx * dx + dz * dz);
+    }
+}
@@ -0,0 +1,166 @@
+/*+===================================================================
+  File:      TERRAINSTREAMER.H
+
+  Summary:   TerrainStreamer header file contains declarations of the
+             chunk residency manager that streams the voxel instances
+             of a height map around the camera used for the lab
+             samples of Game Graphics Programming course.
+
+  Classes: TerrainStreamer
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Renderer/DataTypes.h"
+#include "Scene/HeightMap.h"
+#include "Scene/VoxelCulling.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TerrainStreamingDesc
+
+      Summary:  Residency settings of the terrain streamer. The load
+                radius is in chunks, the memory budget in bytes of
+                resident instance data
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainStreamingDesc
+    {
+        UINT uChunkSize;
+        UINT uLoadRadius;
+        UINT64 uMemoryBudget;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   TerrainStreamingStats
+
+      Summary:  Load and eviction counters of the terrain streamer.
+                Discarded loads finished after their chunk left the
+                load radius or did not fit in the memory budget
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainStreamingStats
+    {
+        UINT64 uNumLoads;
+        UINT64 uNumEvictions;
+        UINT64 uNumDiscardedLoads;
+        UINT64 uResidentBytes;
+        UINT64 uPeakResidentBytes;
+        UINT uNumResidentChunks;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainStreamer
+
+      Summary:  Keeps the chunks around the eye resident under a memory
+                budget. Chunks are expanded into culled packed instances
+                on a background loader thread and merged into per block
+                type instance arrays on the calling thread. The streamer
+                does not touch Direct3D, the owner uploads the dirty
+                ranges of each array. An evicted chunk is filled with
+                the instances at the end of its array, so an eviction
+                only dirties as many instances as it removes
+
+      Methods:  Update
+                  Evicts, merges and requests chunks around the eye
+                WaitForIdle
+                  Blocks until the loader thread has no work
+                GetNumBlockTypes
+                  Returns the number of instance arrays
+                GetInstanceData
+                  Returns the instance array of a block type
+                GetDirtyRanges
+                  Returns the ranges of instances changed since the
+                  last ClearDirtyRanges
+                ClearDirtyRanges
+                  Marks every instance array as uploaded
+                GetStats
+                  Returns the load and eviction counters
+                TerrainStreamer
+                  Constructor.
+                ~TerrainStreamer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainStreamer final
+    {
+    public:
+        static constexpr const TerrainStreamingDesc DEFAULT_DESC =
+        {
+            .uChunkSize = 16u,
+            .uLoadRadius = 8u,
+            .uMemoryBudget = 64ull * 1024ull * 1024ull
+        };
+
+    public:
+        TerrainStreamer(_In_ const HeightMap& heightMap, _In_ const TerrainStreamingDesc& desc);
+        TerrainStreamer(const TerrainStreamer& other) = delete;
+        TerrainStreamer(TerrainStreamer&& other) = delete;
+        TerrainStreamer& operator=(const TerrainStreamer& other) = delete;
+        TerrainStreamer& operator=(TerrainStreamer&& other) = delete;
+        ~TerrainStreamer();
+
+        void Update(_In_ const XMFLOAT3& gridEye);
+        void WaitForIdle();
+
+        UINT GetNumBlockTypes() const;
+        const std::vector<PackedInstanceData>& GetInstanceData(_In_ UINT uBlockTypeIdx) const;
+        const std::vector<InstanceRange>& GetDirtyRanges(_In_ UINT uBlockTypeIdx) const;
+        void ClearDirtyRanges();
+
+        const TerrainStreamingStats& GetStats() const;
+
+    private:
+        struct LoadedChunk
+        {
+            UINT uChunkIdx;
+            UINT64 uNumBytes;
+            std::vector<std::vector<PackedInstanceData>> aInstanceData;
+        };
+
+        struct ResidentChunk
+        {
+            UINT64 uNumBytes;
+            std::vector<std::vector<InstanceRange>> aRanges;
+        };
+
+        void runLoader();
+        void loadChunk(_In_ UINT uChunkIdx, _Out_ LoadedChunk& loadedChunk) const;
+        BOOL makeRoom(_In_ UINT64 uNumBytes, _In_ UINT uDistanceSquared);
+        void insertChunk(_Inout_ LoadedChunk& loadedChunk);
+        void evictChunk(_In_ UINT uChunkIdx);
+        void removeRange(_In_ UINT uBlockTypeIdx, _In_ const InstanceRange& removedRange);
+        void addDirtyRange(_In_ UINT uBlockTypeIdx, _In_ const InstanceRange& dirtyRange);
+        UINT getDistanceSquared(_In_ UINT uChunkIdx) const;
+
+    private:
+        const HeightMap& m_heightMap;
+        TerrainStreamingDesc m_desc;
+        UINT m_uNumChunksX;
+        UINT m_uNumChunksZ;
+        INT m_eyeChunkX;
+        INT m_eyeChunkZ;
+
+        std::vector<std::vector<PackedInstanceData>> m_aInstanceData;
+        std::vector<std::vector<InstanceRange>> m_aDirtyRanges;
+        std::unordered_map<UINT, ResidentChunk> m_residentChunks;
+        std::unordered_set<UINT> m_requestedChunks;
+        std::unordered_set<UINT> m_rejectedChunks;
+        TerrainStreamingStats m_stats;
+
+        std::mutex m_mutex;
+        std::condition_variable m_loadCondition;
+        std::condition_variable m_idleCondition;
+        std::deque<UINT> m_aPendingLoads;
+        std::vector<LoadedChunk> m_aCompletedLoads;
+        UINT m_uNumLoadsInFlight;
+        BOOL m_bIsRunning;
+        std::thread m_loaderThread;
+    };
+}
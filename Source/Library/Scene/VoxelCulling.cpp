@@ -0,0 +1,80 @@
+#include "Scene/VoxelCulling.h"
+
+namespace library
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: CullHiddenVoxels
+
+      Summary:  Finds the cubes of each column that have at least one
+                exposed face. A column of height n holds the cubes
+                [0, n), so a cube at height h is buried when the cube
+                above it and the four side neighbours are solid, that
+                is when h + 1 < n and every neighbouring column is
+                higher than h. Columns outside of the map are empty
+                and the ground below the map is solid. The exposed
+                cubes of a column are therefore [first visible, n)
+
+      Args:     const HeightMapCell* pCells
+                  Column records in row-major order
+                UINT uWidth
+                  Number of columns along the x-axis
+                UINT uDepth
+                  Number of columns along the z-axis
+                WORD* pFirstVisibleHeights
+                  Receives the height of the lowest exposed cube of
+                  each column. Equals the column height for empty
+                  columns
+
+      Returns:  VoxelCullingStats
+                  Number of cubes before and after culling
+    -----------------------------------------------------------------F-F*/
+    VoxelCullingStats CullHiddenVoxels(
+        _In_reads_(uWidth * uDepth) const HeightMapCell* pCells,
+        _In_ UINT uWidth,
+        _In_ UINT uDepth,
+        _Out_writes_(uWidth * uDepth) WORD* pFirstVisibleHeights
+        )
+    {
+        VoxelCullingStats stats = { .uNumCubesIn = 0u, .uNumCubesOut = 0u };
+
+        for (UINT uDepthIdx = 0u; uDepthIdx < uDepth; ++uDepthIdx)
+        {
+            for (UINT uWidthIdx = 0u; uWidthIdx < uWidth; ++uWidthIdx)
+            {
+                size_t uCellIdx = static_cast<size_t>(uDepthIdx) * uWidth + uWidthIdx;
+                WORD columnHeight = pCells[uCellIdx].ColumnHeight;
+
+                WORD lowestNeighbour = 0u;
+                if (0u < uWidthIdx && uWidthIdx + 1u < uWidth && 0u < uDepthIdx && uDepthIdx + 1u < uDepth)
+                {
+                    lowestNeighbour = pCells[uCellIdx - 1u].ColumnHeight;
+                    if (pCells[uCellIdx + 1u].ColumnHeight < lowestNeighbour)
+                    {
+                        lowestNeighbour = pCells[uCellIdx + 1u].ColumnHeight;
+                    }
+                    if (pCells[uCellIdx - uWidth].ColumnHeight < lowestNeighbour)
+                    {
+                        lowestNeighbour = pCells[uCellIdx - uWidth].ColumnHeight;
+                    }
+                    if (pCells[uCellIdx + uWidth].ColumnHeight < lowestNeighbour)
+                    {
+                        lowestNeighbour = pCells[uCellIdx + uWidth].ColumnHeight;
+                    }
+                }
+
+                WORD firstVisibleHeight = columnHeight;
+                if (columnHeight > 0u)
+                {
+                    // The top cube is always exposed
+                    firstVisibleHeight = lowestNeighbour < columnHeight - 1u ? lowestNeighbour : static_cast<WORD>(columnHeight - 1u);
+                }
+
+                pFirstVisibleHeights[uCellIdx] = firstVisibleHeight;
+                stats.uNumCubesIn += columnHeight;
+                stats.uNumCubesOut += static_cast<UINT64>(columnHeight) - firstVisibleHeight;
+            }
+        }
+
+        return stats;
+    }
+}
@@ -0,0 +1,38 @@
+/*+===================================================================
+  File:      VOXELCULLING.H
+
+  Summary:   VoxelCulling header file contains declarations of the
+             hidden voxel culling pass over the column heights of a
+             height map used for the lab samples of Game Graphics
+             Programming course.
+
+  Functions: CullHiddenVoxels
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/HeightMap.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VoxelCullingStats
+
+      Summary:  Number of cubes before and after hidden voxel culling
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelCullingStats
+    {
+        UINT64 uNumCubesIn;
+        UINT64 uNumCubesOut;
+    };
+
+    VoxelCullingStats CullHiddenVoxels(
+        _In_reads_(uWidth * uDepth) const HeightMapCell* pCells,
+        _In_ UINT uWidth,
+        _In_ UINT uDepth,
+        _Out_writes_(uWidth * uDepth) WORD* pFirstVisibleHeights
+        );
+}
@@ -52,7 +52,26 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Shader::compile(_Outptr_ ID3DBlob** ppOutBlob)
     {
-        if (!m_pszFileName || !m_pszEntryPoint || !m_pszShaderModel || !ppOutBlob)
+        return compile(m_pszEntryPoint, ppOutBlob);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Shader::compile
+
+      Summary:  Compiles another entry point of the given shader file
+
+      Args:     PCSTR pszEntryPoint
+                  Name of the entry point to compile
+                ID3DBlob** ppOutBlob
+                  Receives a pointer to the ID3DBlob interface that you
+                  can use to access the compiled code
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Shader::compile(_In_ PCSTR pszEntryPoint, _Outptr_ ID3DBlob** ppOutBlob)
+    {
+        if (!m_pszFileName || !pszEntryPoint || !m_pszShaderModel || !ppOutBlob)
             return E_INVALIDARG;
 
         *ppOutBlob = nullptr;
@@ -69,7 +88,7 @@ namespace library
 
         ComPtr<ID3DBlob> errorBlob = nullptr;
         HRESULT hr = D3DCompileFromFile(m_pszFileName, defines, D3D_COMPILE_STANDARD_FILE_INCLUDE,
-            m_pszEntryPoint, m_pszShaderModel, flags, 0, ppOutBlob, errorBlob.GetAddressOf());
+            pszEntryPoint, m_pszShaderModel, flags, 0, ppOutBlob, errorBlob.GetAddressOf());
         if (FAILED(hr))
         {
             if (errorBlob)
@@ -47,6 +47,7 @@ namespace library
 
     protected:
         HRESULT compile(_Outptr_ ID3DBlob** ppOutBlob);
+        HRESULT compile(_In_ PCSTR pszEntryPoint, _Outptr_ ID3DBlob** ppOutBlob);
 
         PCWSTR m_pszFileName;
         PCSTR m_pszEntryPoint;
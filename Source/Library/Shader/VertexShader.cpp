@@ -16,23 +16,60 @@ namespace library
                   Specifies the shader target or set of shader features
                   to compile against
 
-      Modifies: [m_vertexShader].
+      Modifies: [m_pszBatchEntryPoint, m_vertexShader, m_vertexLayout,
+                 m_batchVertexShader, m_batchVertexLayout].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     VertexShader::VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel)
+        : VertexShader(pszFileName, pszEntryPoint, nullptr, pszShaderModel)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexShader::VertexShader
+
+      Summary:  Constructor of a vertex shader with an instanced batch
+                variant
+
+      Args:     PCWSTR pszFileName
+                  Name of the file that contains the shader code
+                PCSTR pszEntryPoint
+                  Name of the shader entry point functino where shader
+                  execution begins
+                PCSTR pszBatchEntryPoint
+                  Name of the entry point of the batch variant, nullptr
+                  if the shader has none
+                PCSTR pszShaderModel
+                  Specifies the shader target or set of shader features
+                  to compile against
+
+      Modifies: [m_pszBatchEntryPoint, m_vertexShader, m_vertexLayout,
+                 m_batchVertexShader, m_batchVertexLayout].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VertexShader::VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_opt_ PCSTR pszBatchEntryPoint, _In_ PCSTR pszShaderModel)
         : Shader(pszFileName, pszEntryPoint, pszShaderModel)
+        , m_pszBatchEntryPoint(pszBatchEntryPoint)
         , m_vertexShader(nullptr)
         , m_vertexLayout(nullptr)
+        , m_batchVertexShader(nullptr)
+        , m_batchVertexLayout(nullptr)
     {
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   VertexShader::Initialize
 
-      Summary:  Initializes the vertex shader and the input layout
+      Summary:  Initializes the vertex shader and the input layout.
+                When the shader was given a batch entry point, it is
+                compiled as the instanced batch variant, which reads
+                the world matrix and color of each renderable from
+                BatchInstanceData in slot 2
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the vertex shader
 
+      Modifies: [m_vertexShader, m_vertexLayout, m_batchVertexShader,
+                 m_batchVertexLayout].
+
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
@@ -92,6 +129,53 @@ namespace library
             m_vertexLayout.GetAddressOf()
         );
 
+        if (FAILED(hr))
+            return hr;
+
+        // The batch variant is optional, without it every renderable of the shader is drawn on its own
+        if (m_pszBatchEntryPoint == nullptr)
+            return hr;
+
+        ComPtr<ID3DBlob> pBatchVSBlob = nullptr;
+        hr = compile(m_pszBatchEntryPoint, pBatchVSBlob.GetAddressOf());
+        if (FAILED(hr))
+        {
+            MessageBox(nullptr, L"The batch VS shader cannot be compiled.", L"Error", MB_OK);
+            return hr;
+        }
+
+        hr = pDevice->CreateVertexShader(
+            pBatchVSBlob->GetBufferPointer(),
+            pBatchVSBlob->GetBufferSize(),
+            nullptr,
+            m_batchVertexShader.GetAddressOf());
+        if (FAILED(hr))
+            return hr;
+
+        D3D11_INPUT_ELEMENT_DESC aBatchLayouts[] =
+        {
+            {"POSITION",       0u, DXGI_FORMAT_R32G32B32_FLOAT,    0u,  0u, D3D11_INPUT_PER_VERTEX_DATA,   0u},
+            {"TEXCOORD",       0u, DXGI_FORMAT_R32G32_FLOAT,       0u, 12u, D3D11_INPUT_PER_VERTEX_DATA,   0u},
+            {"NORMAL",         0u, DXGI_FORMAT_R32G32B32_FLOAT,    0u, 20u, D3D11_INPUT_PER_VERTEX_DATA,   0u},
+
+            {"TANGENT",        0u, DXGI_FORMAT_R32G32B32_FLOAT,    1u,  0u, D3D11_INPUT_PER_VERTEX_DATA,   0u},
+            {"BITANGENT",      0u, DXGI_FORMAT_R32G32B32_FLOAT,    1u, 12u, D3D11_INPUT_PER_VERTEX_DATA,   0u},
+
+            {"INSTANCE_WORLD", 0u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u,  0u, D3D11_INPUT_PER_INSTANCE_DATA, 1u},
+            {"INSTANCE_WORLD", 1u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 16u, D3D11_INPUT_PER_INSTANCE_DATA, 1u},
+            {"INSTANCE_WORLD", 2u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 32u, D3D11_INPUT_PER_INSTANCE_DATA, 1u},
+            {"INSTANCE_WORLD", 3u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 48u, D3D11_INPUT_PER_INSTANCE_DATA, 1u},
+            {"INSTANCE_COLOR", 0u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 64u, D3D11_INPUT_PER_INSTANCE_DATA, 1u},
+        };
+
+        hr = pDevice->CreateInputLayout(
+            aBatchLayouts,
+            ARRAYSIZE(aBatchLayouts),
+            pBatchVSBlob->GetBufferPointer(),
+            pBatchVSBlob->GetBufferSize(),
+            m_batchVertexLayout.GetAddressOf()
+        );
+
         if (FAILED(hr))
             return hr;
 
@@ -123,4 +207,30 @@ namespace library
     {
         return m_vertexLayout;
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexShader::GetBatchVertexShader
+
+      Summary:  Returns the instanced batch variant of the shader
+
+      Returns:  ComPtr<ID3D11VertexShader>&
+                  Batch vertex shader. Could be a nullptr
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11VertexShader>& VertexShader::GetBatchVertexShader()
+    {
+        return m_batchVertexShader;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexShader::GetBatchVertexLayout
+
+      Summary:  Returns the input layout of the batch variant
+
+      Returns:  ComPtr<ID3D11InputLayout>&
+                  Batch vertex input layout. Could be a nullptr
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11InputLayout>& VertexShader::GetBatchVertexLayout()
+    {
+        return m_batchVertexLayout;
+    }
 }
\ No newline at end of file
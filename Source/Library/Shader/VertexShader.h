@@ -28,6 +28,10 @@ namespace library
                   Returns the vertex shader
                 GetVertexLayout
                   Returns the vertex input layout
+                GetBatchVertexShader
+                  Returns the instanced batch variant of the shader
+                GetBatchVertexLayout
+                  Returns the input layout of the batch variant
                 Game
                   Constructor.
                 ~Game
@@ -38,6 +42,7 @@ namespace library
     public:
         VertexShader() = delete;
         VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        VertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_opt_ PCSTR pszBatchEntryPoint, _In_ PCSTR pszShaderModel);
         VertexShader(const VertexShader& other) = delete;
         VertexShader(VertexShader&& other) = delete;
         VertexShader& operator=(const VertexShader& other) = delete;
@@ -48,9 +53,14 @@ namespace library
 
         ComPtr<ID3D11VertexShader>& GetVertexShader();
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
+        ComPtr<ID3D11VertexShader>& GetBatchVertexShader();
+        ComPtr<ID3D11InputLayout>& GetBatchVertexLayout();
 
     protected:
+        PCSTR m_pszBatchEntryPoint;
         ComPtr<ID3D11VertexShader> m_vertexShader;
         ComPtr<ID3D11InputLayout> m_vertexLayout;
+        ComPtr<ID3D11VertexShader> m_batchVertexShader;
+        ComPtr<ID3D11InputLayout> m_batchVertexLayout;
     };
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*+===================================================================
+  File:      VOXELVERTEXSHADER.H
+
+  Summary:   VoxelVertexShader header file contains declarations of
+             VoxelVertexShader class used for the lab samples of
+             Game Graphics Programming course.
+
+  Classes: VoxelVertexShader
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelVertexShader
+
+      Summary:  Vertex shader of voxels whose instance buffer holds
+                PackedInstanceData instead of transformation matrices
+
+      Methods:  Initialize
+                  Initializes the vertex shader and the input layout
+                VoxelVertexShader
+                  Constructor.
+                ~VoxelVertexShader
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelVertexShader : public VertexShader
+    {
+    public:
+        VoxelVertexShader() = delete;
+        VoxelVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        VoxelVertexShader(const VoxelVertexShader& other) = delete;
+        VoxelVertexShader(VoxelVertexShader&& other) = delete;
+        VoxelVertexShader& operator=(const VoxelVertexShader& other) = delete;
+        VoxelVertexShader& operator=(VoxelVertexShader&& other) = delete;
+        virtual ~VoxelVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+    };
+}
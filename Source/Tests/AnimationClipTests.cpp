@@ -0,0 +1,336 @@
+#include "Tests.h"
+
+#include <cmath>
+#include <random>
+
+#include "assimp/anim.h"
+
+#include "Model/AnimationClip.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: createTimes
+
+          Summary:  Creates the sorted times of a track, a random number
+                    of ticks apart. Some keys share their time with the
+                    previous key when bDuplicates is TRUE
+
+          Args:     UINT uNumKeys
+                      Number of keys
+                    BOOL bDuplicates
+                      Whether keys may share a time
+                    std::mt19937& generator
+                      Random number generator
+
+          Returns:  std::vector<FLOAT>
+                      Times of the keys
+        -----------------------------------------------------------------F-F*/
+        std::vector<FLOAT> createTimes(_In_ UINT uNumKeys, _In_ BOOL bDuplicates, _Inout_ std::mt19937& generator)
+        {
+            std::uniform_real_distribution<FLOAT> stepDistribution(0.1f, 2.0f);
+            std::uniform_int_distribution<UINT> duplicateDistribution(0u, 7u);
+
+            std::vector<FLOAT> aTimes;
+            aTimes.reserve(uNumKeys);
+
+            FLOAT time = stepDistribution(generator);
+            for (UINT i = 0u; i < uNumKeys; ++i)
+            {
+                if (i != 0u && !(bDuplicates && duplicateDistribution(generator) == 0u))
+                {
+                    time += stepDistribution(generator);
+                }
+
+                aTimes.push_back(time);
+            }
+
+            return aTimes;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: findKeyLinear
+
+          Summary:  Finds the key of a track at an animation time by
+                    scanning every key from the first, as the key lookup
+                    did before the cursor
+
+          Args:     FLOAT animationTimeTicks
+                      Animation time
+                    const std::vector<FLOAT>& aTimes
+                      Times of the keys
+
+          Returns:  UINT
+                      First key whose next key is later than the time,
+                      or 0 past the last key
+        -----------------------------------------------------------------F-F*/
+        UINT findKeyLinear(_In_ FLOAT animationTimeTicks, _In_ const std::vector<FLOAT>& aTimes)
+        {
+            for (size_t i = 0u; i + 1u < aTimes.size(); ++i)
+            {
+                if (animationTimeTicks < aTimes[i + 1u])
+                {
+                    return static_cast<UINT>(i);
+                }
+            }
+
+            return 0u;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: countMismatches
+
+          Summary:  Looks up every query with one cursor, as a playing
+                    channel does, and compares the keys with the linear
+                    scan
+
+          Args:     const std::vector<FLOAT>& aTimes
+                      Times of the keys
+                    const std::vector<FLOAT>& aQueries
+                      Animation times, in the order they are looked up
+
+          Returns:  UINT
+                      Number of queries answered differently
+        -----------------------------------------------------------------F-F*/
+        UINT countMismatches(_In_ const std::vector<FLOAT>& aTimes, _In_ const std::vector<FLOAT>& aQueries)
+        {
+            UINT uNumMismatches = 0u;
+            UINT uKeyCursor = 0u;
+            for (FLOAT query : aQueries)
+            {
+                UINT uKey = AnimationClip::FindKey(query, aTimes.data(), static_cast<UINT>(aTimes.size()), uKeyCursor);
+                if (uKey != findKeyLinear(query, aTimes))
+                {
+                    ++uNumMismatches;
+                }
+            }
+
+            return uNumMismatches;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestAnimationClipFindKeyMatchesLinearScan
+
+      Summary:  On tracks from 0 to 10000 keys, with and without keys
+                sharing a time, the cursor lookup finds the same key as
+                the linear scan for monotonic playback, random seeks
+                and looping playback, including times before the first
+                and after the last key
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationClipFindKeyMatchesLinearScan()
+    {
+        constexpr const UINT NUM_KEYS[] = { 0u, 1u, 2u, 3u, 5u, 64u, 10000u };
+        constexpr const UINT NUM_QUERIES = 20000u;
+        constexpr const UINT NUM_LOOPS = 3u;
+
+        std::mt19937 generator(12u);
+        UINT uNumQueries = 0u;
+
+        for (UINT uNumKeys : NUM_KEYS)
+        {
+            for (BOOL bDuplicates : { FALSE, TRUE })
+            {
+                std::vector<FLOAT> aTimes = createTimes(uNumKeys, bDuplicates, generator);
+                FLOAT start = aTimes.empty() ? 0.0f : aTimes.front() - 1.0f;
+                FLOAT end = aTimes.empty() ? 1.0f : aTimes.back() + 1.0f;
+
+                // Monotonic playback from before the first to after the last key
+                std::vector<FLOAT> aMonotonic;
+                aMonotonic.reserve(NUM_QUERIES);
+                for (UINT i = 0u; i < NUM_QUERIES; ++i)
+                {
+                    aMonotonic.push_back(start + (end - start) * static_cast<FLOAT>(i) / static_cast<FLOAT>(NUM_QUERIES - 1u));
+                }
+
+                // Random seeks, half of them on the time of a key
+                std::uniform_real_distribution<FLOAT> timeDistribution(start, end);
+                std::vector<FLOAT> aSeeks;
+                aSeeks.reserve(NUM_QUERIES);
+                for (UINT i = 0u; i < NUM_QUERIES; ++i)
+                {
+                    if (!aTimes.empty() && (i & 1u))
+                    {
+                        aSeeks.push_back(aTimes[generator() % aTimes.size()]);
+                    }
+                    else
+                    {
+                        aSeeks.push_back(timeDistribution(generator));
+                    }
+                }
+
+                // Looping playback wrapping to the start after the end
+                std::vector<FLOAT> aLoops;
+                aLoops.reserve(NUM_QUERIES);
+                FLOAT duration = end - start;
+                FLOAT step = duration * static_cast<FLOAT>(NUM_LOOPS) / static_cast<FLOAT>(NUM_QUERIES);
+                for (UINT i = 0u; i < NUM_QUERIES; ++i)
+                {
+                    aLoops.push_back(start + fmodf(step * static_cast<FLOAT>(i), duration));
+                }
+
+                UINT uMonotonicMismatches = countMismatches(aTimes, aMonotonic);
+                UINT uSeekMismatches = countMismatches(aTimes, aSeeks);
+                UINT uLoopMismatches = countMismatches(aTimes, aLoops);
+                uNumQueries += 3u * NUM_QUERIES;
+
+                if (uMonotonicMismatches != 0u || uSeekMismatches != 0u || uLoopMismatches != 0u)
+                {
+                    printf("  %u keys%s: %u monotonic, %u seek, %u loop mismatches\n", uNumKeys, bDuplicates ? " with duplicates" : "", uMonotonicMismatches, uSeekMismatches, uLoopMismatches);
+                }
+
+                TEST_CHECK(uMonotonicMismatches == 0u);
+                TEST_CHECK(uSeekMismatches == 0u);
+                TEST_CHECK(uLoopMismatches == 0u);
+            }
+        }
+
+        printf("  %u queries\n", uNumQueries);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestAnimationClipFindKeyTime
+
+      Summary:  Plays a 10000 key track through a few loops and prints
+                the time of the cursor lookup against the linear scan.
+                The keys found must be the same, the times are only
+                reported
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationClipFindKeyTime()
+    {
+        constexpr const UINT NUM_KEYS = 10000u;
+        constexpr const UINT NUM_LOOPS = 4u;
+        constexpr const FLOAT STEP = 0.5f;
+
+        std::vector<FLOAT> aTimes(NUM_KEYS);
+        for (UINT i = 0u; i < NUM_KEYS; ++i)
+        {
+            aTimes[i] = static_cast<FLOAT>(i);
+        }
+
+        FLOAT duration = aTimes.back();
+        UINT uNumQueries = static_cast<UINT>(duration / STEP) * NUM_LOOPS;
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        QueryPerformanceCounter(&startTime);
+        UINT64 uCursorSum = 0u;
+        UINT uKeyCursor = 0u;
+        for (UINT i = 0u; i < uNumQueries; ++i)
+        {
+            uCursorSum += AnimationClip::FindKey(fmodf(STEP * static_cast<FLOAT>(i), duration), aTimes.data(), NUM_KEYS, uKeyCursor);
+        }
+        QueryPerformanceCounter(&endTime);
+        DOUBLE cursorMilliseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+
+        QueryPerformanceCounter(&startTime);
+        UINT64 uLinearSum = 0u;
+        for (UINT i = 0u; i < uNumQueries; ++i)
+        {
+            uLinearSum += findKeyLinear(fmodf(STEP * static_cast<FLOAT>(i), duration), aTimes);
+        }
+        QueryPerformanceCounter(&endTime);
+        DOUBLE linearMilliseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+
+        printf("  %u keys, %u queries: cursor %.2f ms, linear scan %.2f ms\n", NUM_KEYS, uNumQueries, cursorMilliseconds, linearMilliseconds);
+
+        TEST_CHECK(uCursorSum == uLinearSum);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestAnimationClipQuantizedRotationsMatchFloat
+
+      Summary:  Imports a channel of random rotation keys with float
+                and with quantized rotations. Sampled through playback,
+                every component of the quantized rotation stays within
+                two snorm16 steps of the float one, and the quantized
+                clip is smaller
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationClipQuantizedRotationsMatchFloat()
+    {
+        constexpr const UINT NUM_KEYS = 256u;
+        constexpr const UINT NUM_SAMPLES = 20000u;
+        constexpr const FLOAT MAX_ERROR = 2.0f / 32767.0f;
+
+        std::mt19937 generator(13u);
+        std::uniform_real_distribution<FLOAT> unitDistribution(-1.0f, 1.0f);
+
+        aiNodeAnim* pNodeAnim = new aiNodeAnim();
+        pNodeAnim->mNodeName = aiString("Bone");
+        pNodeAnim->mNumPositionKeys = 1u;
+        pNodeAnim->mPositionKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(0.0f, 0.0f, 0.0f)) };
+        pNodeAnim->mNumRotationKeys = NUM_KEYS;
+        pNodeAnim->mRotationKeys = new aiQuatKey[NUM_KEYS];
+        pNodeAnim->mNumScalingKeys = 1u;
+        pNodeAnim->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+        for (UINT uKey = 0u; uKey < NUM_KEYS; ++uKey)
+        {
+            aiQuaternion rotation(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+            pNodeAnim->mRotationKeys[uKey] = aiQuatKey(static_cast<DOUBLE>(uKey), rotation.Normalize());
+        }
+
+        aiAnimation animation;
+        animation.mDuration = static_cast<DOUBLE>(NUM_KEYS - 1u);
+        animation.mTicksPerSecond = 30.0;
+        animation.mNumChannels = 1u;
+        animation.mChannels = new aiNodeAnim*[1]{ pNodeAnim };
+
+        AnimationClip floatClip(&animation, FALSE);
+        AnimationClip quantizedClip(&animation, TRUE);
+
+        AnimationClip::KeyCursor floatCursor = {};
+        AnimationClip::KeyCursor quantizedCursor = {};
+        FLOAT maxError = 0.0f;
+        for (UINT i = 0u; i < NUM_SAMPLES; ++i)
+        {
+            FLOAT animationTimeTicks = floatClip.GetDuration() * static_cast<FLOAT>(i) / static_cast<FLOAT>(NUM_SAMPLES);
+
+            XMFLOAT3 scaling;
+            XMFLOAT3 translation;
+            XMVECTOR floatRotation;
+            XMVECTOR quantizedRotation;
+            floatClip.SampleChannel(0u, animationTimeTicks, floatCursor, scaling, floatRotation, translation);
+            quantizedClip.SampleChannel(0u, animationTimeTicks, quantizedCursor, scaling, quantizedRotation, translation);
+
+            // q and -q are the same rotation
+            if (XMVectorGetX(XMQuaternionDot(floatRotation, quantizedRotation)) < 0.0f)
+            {
+                quantizedRotation = XMVectorNegate(quantizedRotation);
+            }
+
+            XMFLOAT4 difference;
+            XMStoreFloat4(&difference, XMVectorAbs(XMVectorSubtract(floatRotation, quantizedRotation)));
+            for (FLOAT error : { difference.x, difference.y, difference.z, difference.w })
+            {
+                maxError = error > maxError ? error : maxError;
+            }
+        }
+
+        printf("  %u samples: max error %g (%.2f snorm16 steps), %zu bytes quantized, %zu float\n", NUM_SAMPLES, maxError, maxError * 32767.0f, quantizedClip.GetSizeInBytes(), floatClip.GetSizeInBytes());
+
+        TEST_CHECK(maxError <= MAX_ERROR);
+        TEST_CHECK(quantizedClip.GetSizeInBytes() < floatClip.GetSizeInBytes());
+
+        return TRUE;
+    }
+}
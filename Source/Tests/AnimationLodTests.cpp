@@ -0,0 +1,432 @@
+#include "Tests.h"
+
+#include <algorithm>
+#include <barrier>
+#include <execution>
+#include <thread>
+
+#include "assimp/anim.h"
+
+#include "Model/AnimationClip.h"
+#include "Model/AnimationLod.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        constexpr const UINT NUM_NODES = 32u;
+        constexpr const UINT MAX_CROWD_SIZE = 1024u;
+        constexpr const UINT NUM_WARM_UP_FRAMES = 30u;
+        constexpr const UINT NUM_FRAMES = 120u;
+        constexpr const FLOAT DELTA_TIME = 1.0f / 60.0f;
+
+        constexpr const AnimationLodDesc LOD_DESC =
+        {
+            .nearDistance = 20.0f,
+            .farDistance = 200.0f,
+            .uMaxUpdateInterval = 8u,
+            .uBoneBudget = 4096u
+        };
+
+        // Every model posed every frame
+        constexpr const AnimationLodDesc FULL_RATE_DESC =
+        {
+            .nearDistance = 20.0f,
+            .farDistance = 200.0f,
+            .uMaxUpdateInterval = 1u,
+            .uBoneBudget = UINT_MAX
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    CrowdModel
+
+          Summary:  Model with a chain of NUM_NODES bones, built in
+                    memory instead of loaded from a file. Its only clip
+                    moves and turns every bone
+
+          Methods:  Initialize
+                      Builds the asset and allocates the playback state
+                    CrowdModel
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class CrowdModel final : public Model
+        {
+        public:
+            CrowdModel() : Model(L"CrowdModel") {}
+
+            HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override
+            {
+                constexpr const UINT NUM_KEYS = 16u;
+                constexpr const FLOAT CLIP_DURATION = 30.0f;
+
+                aiAnimation animation;
+                animation.mDuration = CLIP_DURATION;
+                animation.mTicksPerSecond = 30.0;
+                animation.mNumChannels = NUM_NODES;
+                animation.mChannels = new aiNodeAnim*[NUM_NODES];
+
+                m_asset = std::make_shared<SkinnedMeshAsset>();
+                for (UINT i = 0u; i < NUM_NODES; ++i)
+                {
+                    std::string nodeName = "Bone" + std::to_string(i);
+                    m_asset->aBoneOffsets.push_back(XMMatrixIdentity());
+                    m_asset->boneNameToIndexMap[nodeName] = i;
+                    m_asset->aSkeletonNodes.push_back(SkeletonNode{ .Transformation = XMMatrixIdentity(), .uParentIndex = i == 0u ? INVALID_INDEX : i - 1u, .uBoneIndex = i });
+                    m_asset->aChannels.push_back(i);
+
+                    aiNodeAnim* pNodeAnim = new aiNodeAnim();
+                    pNodeAnim->mNodeName = aiString(nodeName);
+                    pNodeAnim->mNumPositionKeys = NUM_KEYS;
+                    pNodeAnim->mPositionKeys = new aiVectorKey[NUM_KEYS];
+                    pNodeAnim->mNumRotationKeys = NUM_KEYS;
+                    pNodeAnim->mRotationKeys = new aiQuatKey[NUM_KEYS];
+                    pNodeAnim->mNumScalingKeys = 1u;
+                    pNodeAnim->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+                    for (UINT uKey = 0u; uKey < NUM_KEYS; ++uKey)
+                    {
+                        FLOAT keyTime = CLIP_DURATION * static_cast<FLOAT>(uKey) / static_cast<FLOAT>(NUM_KEYS - 1u);
+                        FLOAT angle = 0.1f * static_cast<FLOAT>(uKey + i);
+                        pNodeAnim->mPositionKeys[uKey] = aiVectorKey(keyTime, aiVector3D(0.0f, 1.0f, 0.1f * static_cast<FLOAT>(uKey)));
+                        pNodeAnim->mRotationKeys[uKey] = aiQuatKey(keyTime, aiQuaternion(aiVector3D(0.0f, 0.0f, 1.0f), angle));
+                    }
+                    animation.mChannels[i] = pNodeAnim;
+                }
+                m_asset->aAnimationClips.push_back(std::make_unique<AnimationClip>(&animation, FALSE));
+                m_asset->GlobalInverseTransform = XMMatrixIdentity();
+
+                initPlayback();
+
+                return S_OK;
+            }
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   CrowdRun
+
+          Summary:  Measurements of a simulated crowd. A model is overdue
+                    by the frames since its pose over its update
+                    interval. The overload is the bones due per frame
+                    over the budget, at least 1
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct CrowdRun
+        {
+            DOUBLE milliseconds;
+            UINT uMaxBonesPerFrame;
+            UINT uNumBones;
+            FLOAT maxOverdue;
+            FLOAT overload;
+            UINT uNumNeverPosed;
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: runCrowd
+
+          Summary:  Places a crowd around the eye and runs the frames the
+                    way Scene::Update and Scene::UpdateAnimations do.
+                    Only the measured frames after the warm up count
+
+          Args:     std::vector<CrowdModel>& aCrowd
+                      Pool of models, the first uCrowdSize are used
+                    UINT uCrowdSize
+                      Number of models
+                    FLOAT minDistance
+                      Distance of the nearest model from the eye
+                    FLOAT maxDistance
+                      Distance of the farthest model from the eye
+                    const AnimationLodDesc& desc
+                      Animation level of detail settings
+
+          Returns:  CrowdRun
+                      Measurements of the run
+        -----------------------------------------------------------------F-F*/
+        CrowdRun runCrowd(
+            _Inout_ std::vector<CrowdModel>& aCrowd,
+            _In_ UINT uCrowdSize,
+            _In_ FLOAT minDistance,
+            _In_ FLOAT maxDistance,
+            _In_ const AnimationLodDesc& desc
+        )
+        {
+            AnimationLod animationLod(desc);
+            std::vector<Model*> aModels;
+            std::vector<UINT> aUpdateIntervals;
+            FLOAT bonesPerFrame = 0.0f;
+            for (UINT i = 0u; i < uCrowdSize; ++i)
+            {
+                // Spread the models evenly over the distances and around the eye
+                CrowdModel& model = aCrowd[i];
+                FLOAT distance = minDistance + (maxDistance - minDistance) * static_cast<FLOAT>(i) / static_cast<FLOAT>(uCrowdSize);
+                FLOAT angle = static_cast<FLOAT>(i) * 2.39996f;
+                model.Translate(XMVectorSet(distance * cosf(angle), 0.0f, distance * sinf(angle), 0.0f) - model.GetWorldMatrix().r[3]);
+                model.SetAnimationClip(0u);
+                aModels.push_back(&model);
+                aUpdateIntervals.push_back(animationLod.GetUpdateInterval(distance));
+                bonesPerFrame += static_cast<FLOAT>(NUM_NODES) / static_cast<FLOAT>(aUpdateIntervals.back());
+            }
+
+            std::vector<AnimationLodPose> aPoses;
+            std::vector<UINT> aNumPoses(uCrowdSize, 0u);
+            CrowdRun run =
+            {
+                .milliseconds = 0.0,
+                .uMaxBonesPerFrame = 0u,
+                .uNumBones = 0u,
+                .maxOverdue = 0.0f,
+                .overload = bonesPerFrame > static_cast<FLOAT>(desc.uBoneBudget) ? bonesPerFrame / static_cast<FLOAT>(desc.uBoneBudget) : 1.0f,
+                .uNumNeverPosed = 0u
+            };
+
+            LARGE_INTEGER frequency;
+            LARGE_INTEGER startTime;
+            LARGE_INTEGER endTime;
+            QueryPerformanceFrequency(&frequency);
+            for (UINT uFrame = 0u; uFrame < NUM_WARM_UP_FRAMES + NUM_FRAMES; ++uFrame)
+            {
+                BOOL bMeasured = uFrame >= NUM_WARM_UP_FRAMES;
+                if (bMeasured)
+                {
+                    for (UINT i = 0u; i < uCrowdSize; ++i)
+                    {
+                        FLOAT overdue = static_cast<FLOAT>(aModels[i]->GetFramesSincePose()) / static_cast<FLOAT>(aUpdateIntervals[i]);
+                        run.maxOverdue = overdue > run.maxOverdue ? overdue : run.maxOverdue;
+                    }
+                }
+
+                QueryPerformanceCounter(&startTime);
+                for (Model* pModel : aModels)
+                {
+                    pModel->Advance(DELTA_TIME);
+                }
+
+                animationLod.Schedule(XMVectorZero(), aModels, aPoses);
+                for (const AnimationLodPose& pose : aPoses)
+                {
+                    pose.pModel->PoseSkeleton(pose.uUpdateInterval);
+                }
+                QueryPerformanceCounter(&endTime);
+
+                if (bMeasured)
+                {
+                    const AnimationLodStats& stats = animationLod.GetStats();
+                    run.milliseconds += static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+                    run.uMaxBonesPerFrame = stats.uNumBonesPosed > run.uMaxBonesPerFrame ? stats.uNumBonesPosed : run.uMaxBonesPerFrame;
+                    run.uNumBones += stats.uNumBonesPosed;
+                    for (const AnimationLodPose& pose : aPoses)
+                    {
+                        ++aNumPoses[static_cast<size_t>(static_cast<CrowdModel*>(pose.pModel) - aCrowd.data())];
+                    }
+                }
+            }
+
+            for (UINT i = 0u; i < uCrowdSize; ++i)
+            {
+                run.uNumNeverPosed += aNumPoses[i] == 0u ? 1u : 0u;
+            }
+            run.milliseconds /= static_cast<DOUBLE>(NUM_FRAMES);
+
+            return run;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: runWorkers
+
+          Summary:  Plays a crowd from the start of its clip and poses
+                    every model every frame, the models split into one
+                    contiguous range per worker. The workers wait for
+                    each other at the end of every frame, like the
+                    frames of Scene::UpdateAnimations do. No workers
+                    poses the crowd on std::execution::par instead
+
+          Args:     std::vector<CrowdModel>& aCrowd
+                      Models to animate
+                    UINT uNumWorkers
+                      Number of worker threads, 0 for the parallel
+                      execution policy
+
+          Returns:  DOUBLE
+                      Milliseconds per frame
+        -----------------------------------------------------------------F-F*/
+        DOUBLE runWorkers(_Inout_ std::vector<CrowdModel>& aCrowd, _In_ UINT uNumWorkers)
+        {
+            for (CrowdModel& model : aCrowd)
+            {
+                model.SetAnimationClip(0u);
+            }
+
+            LARGE_INTEGER frequency;
+            LARGE_INTEGER startTime;
+            LARGE_INTEGER endTime;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&startTime);
+
+            if (uNumWorkers == 0u)
+            {
+                for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+                {
+                    std::for_each(std::execution::par, aCrowd.begin(), aCrowd.end(),
+                        [](CrowdModel& model)
+                        {
+                            model.Update(DELTA_TIME);
+                        }
+                    );
+                }
+            }
+            else
+            {
+                std::barrier frameEnd(static_cast<std::ptrdiff_t>(uNumWorkers));
+                std::vector<std::thread> aWorkers;
+                for (UINT uWorker = 0u; uWorker < uNumWorkers; ++uWorker)
+                {
+                    size_t uFirst = aCrowd.size() * uWorker / uNumWorkers;
+                    size_t uLast = aCrowd.size() * (uWorker + 1u) / uNumWorkers;
+                    aWorkers.emplace_back(
+                        [&aCrowd, &frameEnd, uFirst, uLast]()
+                        {
+                            for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+                            {
+                                for (size_t i = uFirst; i < uLast; ++i)
+                                {
+                                    aCrowd[i].Update(DELTA_TIME);
+                                }
+                                frameEnd.arrive_and_wait();
+                            }
+                        }
+                    );
+                }
+
+                for (std::thread& worker : aWorkers)
+                {
+                    worker.join();
+                }
+            }
+
+            QueryPerformanceCounter(&endTime);
+
+            return static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart) / static_cast<DOUBLE>(NUM_FRAMES);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestAnimationLodCrowdScaling
+
+      Summary:  Runs crowds of growing size near, spread out and far
+                from the eye. The bones posed per frame stay within the
+                budget whatever the crowd size, far crowds pose a
+                fraction of their bones and no model waits forever.
+                The time per frame is printed next to posing every
+                model every frame
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationLodCrowdScaling()
+    {
+        constexpr const UINT CROWD_SIZES[] = { 64u, 256u, MAX_CROWD_SIZE };
+
+        std::vector<CrowdModel> aCrowd(MAX_CROWD_SIZE);
+        for (CrowdModel& model : aCrowd)
+        {
+            TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+        }
+
+        for (UINT uCrowdSize : CROWD_SIZES)
+        {
+            CrowdRun nearRun = runCrowd(aCrowd, uCrowdSize, 0.0f, LOD_DESC.nearDistance, LOD_DESC);
+            CrowdRun spreadRun = runCrowd(aCrowd, uCrowdSize, 0.0f, 2.0f * LOD_DESC.farDistance, LOD_DESC);
+            CrowdRun farRun = runCrowd(aCrowd, uCrowdSize, LOD_DESC.farDistance, 2.0f * LOD_DESC.farDistance, LOD_DESC);
+            CrowdRun fullRateRun = runCrowd(aCrowd, uCrowdSize, 0.0f, 2.0f * LOD_DESC.farDistance, FULL_RATE_DESC);
+
+            printf("  %4u models: near %.3f ms (%u bones/frame), spread %.3f ms (%u), far %.3f ms (%u), full rate %.3f ms (%u)\n", uCrowdSize,
+                nearRun.milliseconds, nearRun.uNumBones / NUM_FRAMES,
+                spreadRun.milliseconds, spreadRun.uNumBones / NUM_FRAMES,
+                farRun.milliseconds, farRun.uNumBones / NUM_FRAMES,
+                fullRateRun.milliseconds, fullRateRun.uNumBones / NUM_FRAMES);
+
+            UINT uCrowdBones = uCrowdSize * NUM_NODES;
+            TEST_CHECK(fullRateRun.uNumBones == uCrowdBones * NUM_FRAMES);
+            for (const CrowdRun& run : { nearRun, spreadRun, farRun })
+            {
+                TEST_CHECK(run.uMaxBonesPerFrame <= LOD_DESC.uBoneBudget);
+                TEST_CHECK(run.uNumNeverPosed == 0u);
+
+                // Over budget every model waits longer in the same proportion
+                TEST_CHECK(run.maxOverdue <= run.overload + 1.0f);
+            }
+
+            // A near crowd within the budget is posed every frame, a far one at the longest interval
+            if (uCrowdBones <= LOD_DESC.uBoneBudget)
+            {
+                TEST_CHECK(nearRun.uNumBones == uCrowdBones * NUM_FRAMES);
+            }
+            TEST_CHECK(farRun.uNumBones <= (uCrowdBones / LOD_DESC.uMaxUpdateInterval + NUM_NODES) * NUM_FRAMES);
+            TEST_CHECK(spreadRun.uNumBones < fullRateRun.uNumBones);
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestAnimationCrowdThreadScaling
+
+      Summary:  Animates 1000 models with 1 up to as many workers as
+                hardware threads, and on std::execution::par. Every run
+                must end in the same bone palettes as one worker, and
+                the time per frame of each is printed
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationCrowdThreadScaling()
+    {
+        constexpr const UINT NUM_MODELS = 1000u;
+
+        std::vector<CrowdModel> aCrowd(NUM_MODELS);
+        for (CrowdModel& model : aCrowd)
+        {
+            TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+        }
+
+        // Powers of 2 up to the hardware threads, then the parallel execution policy as 0
+        UINT uMaxWorkers = std::thread::hardware_concurrency() > 1u ? std::thread::hardware_concurrency() : 1u;
+        std::vector<UINT> aNumWorkers;
+        for (UINT uNumWorkers = 1u; uNumWorkers < uMaxWorkers; uNumWorkers *= 2u)
+        {
+            aNumWorkers.push_back(uNumWorkers);
+        }
+        aNumWorkers.push_back(uMaxWorkers);
+        aNumWorkers.push_back(0u);
+
+        DOUBLE singleMilliseconds = 0.0;
+        std::vector<XMMATRIX> aExpectedTransforms;
+        for (UINT uNumWorkers : aNumWorkers)
+        {
+            DOUBLE milliseconds = runWorkers(aCrowd, uNumWorkers);
+            if (uNumWorkers == 1u)
+            {
+                singleMilliseconds = milliseconds;
+                for (CrowdModel& model : aCrowd)
+                {
+                    aExpectedTransforms.insert(aExpectedTransforms.end(), model.GetBoneTransforms().begin(), model.GetBoneTransforms().end());
+                }
+            }
+
+            if (uNumWorkers == 0u)
+            {
+                printf("  %u models, std::execution::par: %.3f ms/frame, %.2fx\n", NUM_MODELS, milliseconds, singleMilliseconds / milliseconds);
+            }
+            else
+            {
+                printf("  %u models, %u worker%s: %.3f ms/frame, %.2fx\n", NUM_MODELS, uNumWorkers, uNumWorkers == 1u ? "" : "s", milliseconds, singleMilliseconds / milliseconds);
+            }
+
+            for (UINT i = 0u; i < NUM_MODELS; ++i)
+            {
+                TEST_CHECK(memcmp(aCrowd[i].GetBoneTransforms().data(), &aExpectedTransforms[i * NUM_NODES], NUM_NODES * sizeof(XMMATRIX)) == 0);
+            }
+        }
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,244 @@
+#include "Tests.h"
+
+#include <cmath>
+#include <random>
+
+#include "Scene/ChunkMesher.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   SurfaceStats
+
+          Summary:  Triangles and covered surface of a chunk, the area
+                    is counted in cube faces per direction (+x, -x, +y,
+                    -y, +z, -z)
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct SurfaceStats
+        {
+            UINT64 uNumTriangles;
+            DOUBLE aFaceAreas[6];
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getNaiveSurface
+
+          Summary:  Expands every cube of the chunk into its 12
+                    triangles, and counts the faces that are exposed
+                    by looking at the neighbouring columns
+
+          Args:     const std::vector<HeightMapCell>& aCells
+                      Column records in row-major order
+                    UINT uWidth
+                      Number of columns along the x-axis
+                    UINT uDepth
+                      Number of columns along the z-axis
+                    UINT uBeginX
+                      First column of the chunk along the x-axis
+                    UINT uBeginZ
+                      First column of the chunk along the z-axis
+
+          Returns:  SurfaceStats
+                    Triangles of the naive cubes, exposed faces
+        -----------------------------------------------------------------F-F*/
+        SurfaceStats getNaiveSurface(_In_ const std::vector<HeightMapCell>& aCells, _In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uBeginX, _In_ UINT uBeginZ)
+        {
+            auto getHeight = [&aCells, uWidth, uDepth](INT x, INT z)
+            {
+                if (x < 0 || z < 0 || x >= static_cast<INT>(uWidth) || z >= static_cast<INT>(uDepth))
+                {
+                    return 0;
+                }
+
+                return static_cast<INT>(aCells[static_cast<size_t>(z) * uWidth + static_cast<size_t>(x)].ColumnHeight);
+            };
+
+            SurfaceStats stats = { .uNumTriangles = 0u, .aFaceAreas = { 0.0 } };
+            for (INT z = static_cast<INT>(uBeginZ); z < static_cast<INT>(uBeginZ + ChunkMesher::CHUNK_SIZE) && z < static_cast<INT>(uDepth); ++z)
+            {
+                for (INT x = static_cast<INT>(uBeginX); x < static_cast<INT>(uBeginX + ChunkMesher::CHUNK_SIZE) && x < static_cast<INT>(uWidth); ++x)
+                {
+                    INT height = getHeight(x, z);
+                    stats.uNumTriangles += 12u * static_cast<UINT64>(height);
+                    for (INT y = 0; y < height; ++y)
+                    {
+                        // The ground below the map is solid, so bottom faces are never exposed
+                        stats.aFaceAreas[0] += getHeight(x + 1, z) <= y ? 1.0 : 0.0;
+                        stats.aFaceAreas[1] += getHeight(x - 1, z) <= y ? 1.0 : 0.0;
+                        stats.aFaceAreas[2] += y + 1 == height ? 1.0 : 0.0;
+                        stats.aFaceAreas[4] += getHeight(x, z + 1) <= y ? 1.0 : 0.0;
+                        stats.aFaceAreas[5] += getHeight(x, z - 1) <= y ? 1.0 : 0.0;
+                    }
+                }
+            }
+
+            return stats;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getMeshedSurface
+
+          Summary:  Counts the triangles of the meshes and sums their
+                    area per facing direction. A cube face spans 2 by 2
+                    units
+
+          Args:     const std::vector<TerrainMeshData>& aMeshes
+                      Meshes of the chunk
+
+          Returns:  SurfaceStats
+                    Triangles and covered surface of the meshes
+        -----------------------------------------------------------------F-F*/
+        SurfaceStats getMeshedSurface(_In_ const std::vector<TerrainMeshData>& aMeshes)
+        {
+            SurfaceStats stats = { .uNumTriangles = 0u, .aFaceAreas = { 0.0 } };
+            for (const TerrainMeshData& mesh : aMeshes)
+            {
+                for (size_t i = 0u; i + 2u < mesh.aIndices.size(); i += 3u)
+                {
+                    const XMFLOAT3& a = mesh.aVertices[mesh.aIndices[i]].Position;
+                    const XMFLOAT3& b = mesh.aVertices[mesh.aIndices[i + 1u]].Position;
+                    const XMFLOAT3& c = mesh.aVertices[mesh.aIndices[i + 2u]].Position;
+
+                    DOUBLE aEdge0[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+                    DOUBLE aEdge1[3] = { c.x - a.x, c.y - a.y, c.z - a.z };
+                    DOUBLE aCross[3] =
+                    {
+                        aEdge0[1] * aEdge1[2] - aEdge0[2] * aEdge1[1],
+                        aEdge0[2] * aEdge1[0] - aEdge0[0] * aEdge1[2],
+                        aEdge0[0] * aEdge1[1] - aEdge0[1] * aEdge1[0]
+                    };
+
+                    // Half the cross product is the area, a face is 4 square units
+                    for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+                    {
+                        if (aCross[uAxis] != 0.0)
+                        {
+                            stats.aFaceAreas[uAxis * 2u + (aCross[uAxis] > 0.0 ? 0u : 1u)] += std::abs(aCross[uAxis]) * 0.5 / 4.0;
+                        }
+                    }
+                    ++stats.uNumTriangles;
+                }
+            }
+
+            return stats;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isSameSurface
+
+          Summary:  Compares the covered surface per direction. The
+                    winding may face either way, so opposite directions
+                    are compared as pairs as well
+
+          Args:     const SurfaceStats& meshed
+                      Surface of the meshes
+                    const SurfaceStats& naive
+                      Exposed faces of the naive cubes
+
+          Returns:  BOOL
+                    TRUE if the areas match
+        -----------------------------------------------------------------F-F*/
+        BOOL isSameSurface(_In_ const SurfaceStats& meshed, _In_ const SurfaceStats& naive)
+        {
+            for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+            {
+                if (std::abs(meshed.aFaceAreas[uAxis * 2u] + meshed.aFaceAreas[uAxis * 2u + 1u] - naive.aFaceAreas[uAxis * 2u] - naive.aFaceAreas[uAxis * 2u + 1u]) > 1e-3)
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestChunkMesherFlatChunk
+
+      Summary:  A flat chunk of one block type is one top quad and one
+                quad per side, against 12 triangles per naive cube
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestChunkMesherFlatChunk()
+    {
+        const UINT uSize = ChunkMesher::CHUNK_SIZE;
+        std::vector<HeightMapCell> aCells(static_cast<size_t>(uSize) * uSize, HeightMapCell{ .BlockType = static_cast<CHAR>(eBlockType::SAND), .Reserved = 0u, .ColumnHeight = 1u });
+
+        std::vector<TerrainMeshData> aMeshes;
+        ChunkMesher::MeshChunk(aCells.data(), uSize, uSize, 0u, 0u, aMeshes);
+
+        SurfaceStats meshed = getMeshedSurface(aMeshes);
+        SurfaceStats naive = getNaiveSurface(aCells, uSize, uSize, 0u, 0u);
+
+        TEST_CHECK(meshed.uNumTriangles == 10u);
+        TEST_CHECK(naive.uNumTriangles == 12u * uSize * uSize);
+        TEST_CHECK(isSameSurface(meshed, naive));
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestChunkMesherMatchesNaiveCubes
+
+      Summary:  On a random height map with a few block types, every
+                chunk covers exactly the exposed faces of the naive
+                cube expansion with fewer triangles
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestChunkMesherMatchesNaiveCubes()
+    {
+        const UINT uWidth = 40u;
+        const UINT uDepth = 35u;
+
+        // Smooth terrain with large flat areas, as the generator makes
+        std::mt19937 generator(5u);
+        std::vector<HeightMapCell> aCells(static_cast<size_t>(uWidth) * uDepth);
+        for (UINT z = 0u; z < uDepth; ++z)
+        {
+            for (UINT x = 0u; x < uWidth; ++x)
+            {
+                WORD height = static_cast<WORD>(4u + (x / 6u + z / 5u) % 5u + (generator() % 8u == 0u ? 1u : 0u));
+                CHAR blockType = static_cast<CHAR>(static_cast<UINT>(eBlockType::GRASSLAND) + (height % 3u));
+                aCells[static_cast<size_t>(z) * uWidth + x] = { .BlockType = blockType, .Reserved = 0u, .ColumnHeight = height };
+            }
+        }
+
+        UINT64 uNumMeshedTriangles = 0u;
+        UINT64 uNumNaiveTriangles = 0u;
+        for (UINT uBeginZ = 0u; uBeginZ < uDepth; uBeginZ += ChunkMesher::CHUNK_SIZE)
+        {
+            for (UINT uBeginX = 0u; uBeginX < uWidth; uBeginX += ChunkMesher::CHUNK_SIZE)
+            {
+                std::vector<TerrainMeshData> aMeshes;
+                ChunkMesher::MeshChunk(aCells.data(), uWidth, uDepth, uBeginX, uBeginZ, aMeshes);
+
+                SurfaceStats meshed = getMeshedSurface(aMeshes);
+                SurfaceStats naive = getNaiveSurface(aCells, uWidth, uDepth, uBeginX, uBeginZ);
+                TEST_CHECK(isSameSurface(meshed, naive));
+
+                DOUBLE numExposedFaces = 0.0;
+                for (DOUBLE faceArea : naive.aFaceAreas)
+                {
+                    numExposedFaces += faceArea;
+                }
+                TEST_CHECK(meshed.uNumTriangles < static_cast<UINT64>(numExposedFaces) * 2u);
+
+                uNumMeshedTriangles += meshed.uNumTriangles;
+                uNumNaiveTriangles += naive.uNumTriangles;
+            }
+        }
+
+        printf("  %llu triangles meshed, %llu for the naive cubes\n", uNumMeshedTriangles, uNumNaiveTriangles);
+        TEST_CHECK(uNumMeshedTriangles * 10u < uNumNaiveTriangles);
+
+        return TRUE;
+    }
+}
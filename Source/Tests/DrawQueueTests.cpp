@@ -0,0 +1,167 @@
+#include "Tests.h"
+
+#include <random>
+
+#include "Renderer/DrawQueue.h"
+#include "Renderer/NullRenderCommandList.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        constexpr const UINT NUM_VERTEX_BUFFERS = 8u;
+        constexpr const UINT NUM_SHADERS = 3u;
+        constexpr const UINT NUM_TEXTURES = 5u;
+        constexpr const UINT VERTEX_STRIDE = 32u;
+
+        /*--------------------------------------------------------------------
+          Stand-ins for the state objects. The queue and the null backend
+          only compare and count the pointers, they never dereference them
+        --------------------------------------------------------------------*/
+        BYTE s_aStateObjects[64];
+
+        template <class T>
+        T* getStateObject(_In_ UINT uIndex)
+        {
+            return reinterpret_cast<T*>(&s_aStateObjects[uIndex]);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: addRandomPackets
+
+          Summary:  Adds packets that pick their vertex buffer, shaders
+                    and texture at random from a few of each, in random
+                    depth order. Every 50th packet is in the sky pass
+
+          Args:     DrawQueue& drawQueue
+                      Queue to add to
+                    UINT uNumPackets
+                      Number of packets
+                    std::mt19937& generator
+                      Random number generator
+        -----------------------------------------------------------------F-F*/
+        void addRandomPackets(_Inout_ DrawQueue& drawQueue, _In_ UINT uNumPackets, _Inout_ std::mt19937& generator)
+        {
+            for (UINT i = 0u; i < uNumPackets; ++i)
+            {
+                DrawPacket packet =
+                {
+                    .aVertexBuffers = { getStateObject<ID3D11Buffer>(generator() % NUM_VERTEX_BUFFERS) },
+                    .aStrides = { VERTEX_STRIDE },
+                    .uNumVertexBuffers = 1u,
+                    .pConstantBuffer = getStateObject<ID3D11Buffer>(30u),
+                    .pVertexShader = getStateObject<ID3D11VertexShader>(8u + generator() % NUM_SHADERS),
+                    .pPixelShader = getStateObject<ID3D11PixelShader>(12u + generator() % NUM_SHADERS),
+                    .aShaderResourceViews = { getStateObject<ID3D11ShaderResourceView>(20u + generator() % NUM_TEXTURES) },
+                    .uNumIndices = 36u
+                };
+
+                drawQueue.Add(i % 50u == 0u ? eDrawPass::SKY : eDrawPass::SCENE, packet, static_cast<FLOAT>(generator() % 1000u) / 1000.0f);
+            }
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestDrawQueueSkipsRedundantBindings
+
+      Summary:  Submits 1000 packets over a handful of buffers, shaders
+                and textures for a few frames. Every packet is drawn,
+                the backend receives exactly the bindings the queue
+                counted as changed, and sorting leaves most bindings
+                equal to what the previous packet bound
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestDrawQueueSkipsRedundantBindings()
+    {
+        const UINT uNumPackets = 1000u;
+
+        DrawQueue drawQueue;
+        NullRenderCommandList commandList;
+        std::mt19937 generator(1u);
+        for (UINT uFrame = 0u; uFrame < 3u; ++uFrame)
+        {
+            drawQueue.Clear();
+            addRandomPackets(drawQueue, uNumPackets, generator);
+            drawQueue.Sort();
+
+            commandList.ResetStats();
+            drawQueue.Submit(commandList);
+
+            DrawQueueStats stats = drawQueue.GetStats();
+            TEST_CHECK(stats.uNumPackets == uNumPackets);
+            TEST_CHECK(stats.uNumDraws == uNumPackets);
+            TEST_CHECK(commandList.GetStats().uNumDraws == uNumPackets);
+            TEST_CHECK(commandList.GetStats().uNumStateChanges == stats.uNumStateChanges);
+
+            // Every packet accounts for the same bindings, recorded or skipped
+            UINT uNumBindings = stats.uNumStateChanges + stats.uNumSkippedStateChanges;
+            TEST_CHECK(uNumBindings % uNumPackets == 0u);
+            TEST_CHECK(stats.uNumStateChanges * 10u < uNumBindings);
+
+            if (uFrame == 0u)
+            {
+                printf("  %u packets: %u bindings recorded, %u skipped\n", uNumPackets, stats.uNumStateChanges, stats.uNumSkippedStateChanges);
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestDrawQueueSplitMatchesSubmit
+
+      Summary:  Records 2000 sorted packets in chunks into deferred
+                lists and plays them back. The chunks cover every
+                packet once and draw as much as a single Submit
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestDrawQueueSplitMatchesSubmit()
+    {
+        const UINT uNumPackets = 2000u;
+        const UINT uMaxChunks = 8u;
+
+        DrawQueue drawQueue;
+        std::mt19937 generator(2u);
+        addRandomPackets(drawQueue, uNumPackets, generator);
+        drawQueue.Sort();
+
+        UINT uNumChunks = drawQueue.Split(uMaxChunks);
+        TEST_CHECK(uNumChunks > 1u && uNumChunks <= uMaxChunks);
+        TEST_CHECK(uNumPackets / uNumChunks >= DrawQueue::MIN_PACKETS_PER_CHUNK);
+
+        NullRenderCommandList commandList;
+        std::vector<std::shared_ptr<RenderCommandList>> aDeferredCommandLists(uNumChunks);
+        for (UINT uChunk = 0u; uChunk < uNumChunks; ++uChunk)
+        {
+            TEST_CHECK(SUCCEEDED(commandList.CreateDeferredCommandList(aDeferredCommandLists[uChunk])));
+            drawQueue.SubmitChunk(uChunk, *aDeferredCommandLists[uChunk]);
+            TEST_CHECK(SUCCEEDED(aDeferredCommandLists[uChunk]->Finish()));
+        }
+        for (UINT uChunk = 0u; uChunk < uNumChunks; ++uChunk)
+        {
+            commandList.Execute(*aDeferredCommandLists[uChunk]);
+        }
+
+        DrawQueueStats stats = drawQueue.GetStats();
+        TEST_CHECK(stats.uNumChunks == uNumChunks);
+        TEST_CHECK(stats.uNumPackets == uNumPackets);
+        TEST_CHECK(stats.uNumDraws == uNumPackets);
+        TEST_CHECK(commandList.GetStats().uNumDraws == uNumPackets);
+
+        NullRenderCommandList singleCommandList;
+        drawQueue.Submit(singleCommandList);
+        TEST_CHECK(drawQueue.GetStats().uNumChunks == 1u);
+        TEST_CHECK(singleCommandList.GetStats().uNumDraws == uNumPackets);
+
+        // Each chunk starts by binding everything, so it can only record more than a single list
+        TEST_CHECK(singleCommandList.GetStats().uNumStateChanges <= commandList.GetStats().uNumStateChanges);
+
+        return TRUE;
+    }
+}
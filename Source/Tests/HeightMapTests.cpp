@@ -0,0 +1,309 @@
+#include "Tests.h"
+
+#include <fstream>
+#include <random>
+
+#include "Scene/HeightMap.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        constexpr const UINT MAP_HEIGHT = 64u;
+        constexpr const UINT NUM_COLORS = 10u;
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    TemporaryFile
+
+          Summary:  Path in the temporary directory that is deleted when
+                    it goes out of scope, also when a check fails
+
+          Methods:  GetPath
+                      Returns the path
+                    TemporaryFile
+                      Constructor.
+                    ~TemporaryFile
+                      Destructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class TemporaryFile final
+        {
+        public:
+            TemporaryFile(_In_ PCWSTR pszFileName) : m_filePath(std::filesystem::temp_directory_path() / pszFileName) {}
+            TemporaryFile(const TemporaryFile& other) = delete;
+            TemporaryFile(TemporaryFile&& other) = delete;
+            TemporaryFile& operator=(const TemporaryFile& other) = delete;
+            TemporaryFile& operator=(TemporaryFile&& other) = delete;
+            ~TemporaryFile()
+            {
+                std::error_code error;
+                std::filesystem::remove(m_filePath, error);
+            }
+
+            const std::filesystem::path& GetPath() const { return m_filePath; }
+
+        private:
+            std::filesystem::path m_filePath;
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: writeTextHeightMap
+
+          Summary:  Writes a random height map in the text format that
+                    the Game used to generate. Block types above
+                    TEMPERATE_RAIN_FOREST are left out, the text loader
+                    reads them as whitespace
+
+          Args:     const std::filesystem::path& filePath
+                      Path of the text file
+                    UINT uSize
+                      Number of columns along the x-axis and the z-axis
+                    std::vector<HeightMapCell>& aCells
+                      Receives the written columns
+
+          Returns:  HRESULT
+                      Status code
+        -----------------------------------------------------------------F-F*/
+        HRESULT writeTextHeightMap(_In_ const std::filesystem::path& filePath, _In_ UINT uSize, _Out_ std::vector<HeightMapCell>& aCells)
+        {
+            std::ofstream outputFile(filePath, std::ios::out | std::ios::trunc);
+            if (!outputFile.is_open())
+            {
+                return E_FAIL;
+            }
+
+            outputFile << uSize << ' ' << MAP_HEIGHT << ' ' << uSize << ' ' << NUM_COLORS << '\n';
+            for (UINT uColorIdx = 0u; uColorIdx < NUM_COLORS; ++uColorIdx)
+            {
+                outputFile << static_cast<FLOAT>(uColorIdx) / NUM_COLORS << " 0.5 1\n";
+            }
+
+            std::mt19937 generator(1u);
+            aCells.resize(static_cast<size_t>(uSize) * uSize);
+            for (HeightMapCell& cell : aCells)
+            {
+                cell =
+                {
+                    .BlockType = static_cast<CHAR>(static_cast<UINT>(eBlockType::GRASSLAND) + generator() % NUM_COLORS),
+                    .Reserved = 0u,
+                    .ColumnHeight = static_cast<WORD>(generator() % MAP_HEIGHT)
+                };
+
+                // Half a voxel up, so that the height truncates back to the same column
+                outputFile << cell.BlockType << ' ' << (static_cast<FLOAT>(cell.ColumnHeight) + 0.5f) / static_cast<FLOAT>(MAP_HEIGHT) << '\n';
+            }
+
+            outputFile.close();
+
+            return outputFile.fail() ? E_FAIL : S_OK;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isSameHeightMap
+
+          Summary:  Compares the dimensions and the columns of a loaded
+                    height map with the written ones
+
+          Args:     const HeightMap& heightMap
+                      Loaded height map
+                    UINT uSize
+                      Number of columns along the x-axis and the z-axis
+                    const std::vector<HeightMapCell>& aCells
+                      Written columns
+
+          Returns:  BOOL
+                      TRUE if they match
+        -----------------------------------------------------------------F-F*/
+        BOOL isSameHeightMap(_In_ const HeightMap& heightMap, _In_ UINT uSize, _In_ const std::vector<HeightMapCell>& aCells)
+        {
+            if (heightMap.GetWidth() != uSize || heightMap.GetDepth() != uSize || heightMap.GetHeight() != MAP_HEIGHT || heightMap.GetNumColors() != NUM_COLORS)
+            {
+                return FALSE;
+            }
+
+            for (size_t i = 0u; i < aCells.size(); ++i)
+            {
+                if (heightMap.GetCells()[i].BlockType != aCells[i].BlockType || heightMap.GetCells()[i].ColumnHeight != aCells[i].ColumnHeight)
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getLoadMilliseconds
+
+          Summary:  Returns the fastest of a few loads of a height map
+
+          Args:     HRESULT (HeightMap::*pfnLoad)(const std::filesystem::path&)
+                      Loader to time
+                    const std::filesystem::path& filePath
+                      Path of the height map file
+                    HeightMap& heightMap
+                      Receives the last load
+
+          Returns:  DOUBLE
+                      Milliseconds of the fastest load, negative if a
+                      load failed
+        -----------------------------------------------------------------F-F*/
+        DOUBLE getLoadMilliseconds(_In_ HRESULT (HeightMap::*pfnLoad)(const std::filesystem::path&), _In_ const std::filesystem::path& filePath, _Inout_ HeightMap& heightMap)
+        {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+
+            DOUBLE fastestMilliseconds = 0.0;
+            for (UINT uRunIdx = 0u; uRunIdx < 3u; ++uRunIdx)
+            {
+                LARGE_INTEGER startTime;
+                LARGE_INTEGER endTime;
+                QueryPerformanceCounter(&startTime);
+                if (FAILED((heightMap.*pfnLoad)(filePath)))
+                {
+                    return -1.0;
+                }
+                QueryPerformanceCounter(&endTime);
+
+                DOUBLE milliseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+                if (uRunIdx == 0u || milliseconds < fastestMilliseconds)
+                {
+                    fastestMilliseconds = milliseconds;
+                }
+            }
+
+            return fastestMilliseconds;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestHeightMapBinaryMatchesText
+
+      Summary:  A text height map converted with ConvertTextToBinary
+                loads with LoadBinary into the same columns as with
+                LoadText, and Load picks either format
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestHeightMapBinaryMatchesText()
+    {
+        const UINT uSize = 37u;
+        // Declared before the height map, which keeps the binary file mapped until it is destroyed
+        const TemporaryFile textFile(L"HeightMapTest.txt");
+        const TemporaryFile binaryFile(L"HeightMapTest.hmap");
+        const std::filesystem::path& textFilePath = textFile.GetPath();
+        const std::filesystem::path& binaryFilePath = binaryFile.GetPath();
+
+        std::vector<HeightMapCell> aCells;
+        TEST_CHECK(SUCCEEDED(writeTextHeightMap(textFilePath, uSize, aCells)));
+        TEST_CHECK(SUCCEEDED(HeightMap::ConvertTextToBinary(textFilePath, binaryFilePath)));
+
+        {
+            HeightMap heightMap;
+            TEST_CHECK(SUCCEEDED(heightMap.LoadText(textFilePath)));
+            TEST_CHECK(isSameHeightMap(heightMap, uSize, aCells));
+
+            TEST_CHECK(SUCCEEDED(heightMap.LoadBinary(binaryFilePath)));
+            TEST_CHECK(isSameHeightMap(heightMap, uSize, aCells));
+            TEST_CHECK(heightMap.GetColors()[3].x == 0.3f);
+
+            TEST_CHECK(FAILED(heightMap.LoadBinary(textFilePath)));
+            TEST_CHECK(SUCCEEDED(heightMap.Load(textFilePath)));
+            TEST_CHECK(isSameHeightMap(heightMap, uSize, aCells));
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestHeightMapLoadTime
+
+      Summary:  Compares the load time of a 1024x1024 height map in
+                the text format and in the binary format. Both load the
+                same columns. The times are only printed, the binary
+                file is memory-mapped and read in place and should load
+                far faster than the text is parsed
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestHeightMapLoadTime()
+    {
+        const UINT uSize = 1024u;
+        // Declared before the height map, which keeps the binary file mapped until it is destroyed
+        const TemporaryFile textFile(L"HeightMapLoadTime.txt");
+        const TemporaryFile binaryFile(L"HeightMapLoadTime.hmap");
+        const std::filesystem::path& textFilePath = textFile.GetPath();
+        const std::filesystem::path& binaryFilePath = binaryFile.GetPath();
+
+        std::vector<HeightMapCell> aCells;
+        TEST_CHECK(SUCCEEDED(writeTextHeightMap(textFilePath, uSize, aCells)));
+        TEST_CHECK(SUCCEEDED(HeightMap::ConvertTextToBinary(textFilePath, binaryFilePath)));
+
+        {
+            HeightMap heightMap;
+            DOUBLE textMilliseconds = getLoadMilliseconds(&HeightMap::LoadText, textFilePath, heightMap);
+            TEST_CHECK(textMilliseconds >= 0.0);
+            TEST_CHECK(isSameHeightMap(heightMap, uSize, aCells));
+
+            DOUBLE binaryMilliseconds = getLoadMilliseconds(&HeightMap::LoadBinary, binaryFilePath, heightMap);
+            TEST_CHECK(binaryMilliseconds >= 0.0);
+            TEST_CHECK(isSameHeightMap(heightMap, uSize, aCells));
+
+            printf("  %ux%u: text %.3f ms (%llu bytes), binary %.3f ms (%llu bytes)\n", uSize, uSize,
+                textMilliseconds, static_cast<UINT64>(std::filesystem::file_size(textFilePath)),
+                binaryMilliseconds, static_cast<UINT64>(std::filesystem::file_size(binaryFilePath)));
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestHeightMapRejectsOversizedMaps
+
+      Summary:  Maps with a dimension above HeightMap::MAX_DIMENSION do
+                not fit the INT16 voxel coordinates and are rejected
+                by every way of creating a height map
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestHeightMapRejectsOversizedMaps()
+    {
+        const UINT uOversized = HeightMap::MAX_DIMENSION + 1u;
+        HeightMap heightMap;
+
+        TEST_CHECK(SUCCEEDED(heightMap.Create(HeightMap::MAX_DIMENSION, MAP_HEIGHT, 1u, std::vector<XMFLOAT3>(), std::vector<HeightMapCell>(HeightMap::MAX_DIMENSION))));
+        TEST_CHECK(heightMap.Create(uOversized, MAP_HEIGHT, 1u, std::vector<XMFLOAT3>(), std::vector<HeightMapCell>(uOversized)) == E_INVALIDARG);
+        TEST_CHECK(heightMap.Create(1u, uOversized, 1u, std::vector<XMFLOAT3>(), std::vector<HeightMapCell>(1u)) == E_INVALIDARG);
+
+        const TemporaryFile textFile(L"HeightMapOversized.txt");
+        {
+            std::ofstream outputFile(textFile.GetPath(), std::ios::out | std::ios::trunc);
+            outputFile << 1u << ' ' << MAP_HEIGHT << ' ' << uOversized << " 0\n";
+        }
+        TEST_CHECK(heightMap.LoadText(textFile.GetPath()) == E_INVALIDARG);
+
+        // Only the header, the dimensions are checked before the size of the cells
+        const TemporaryFile binaryFile(L"HeightMapOversized.hmap");
+        {
+            const HeightMapHeader header =
+            {
+                .uMagic = HeightMap::MAGIC,
+                .uVersion = HeightMap::VERSION,
+                .uWidth = uOversized,
+                .uHeight = MAP_HEIGHT,
+                .uDepth = 1u,
+                .uNumColors = 0u
+            };
+            std::ofstream outputFile(binaryFile.GetPath(), std::ios::out | std::ios::trunc | std::ios::binary);
+            outputFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        TEST_CHECK(heightMap.LoadBinary(binaryFile.GetPath()) == E_INVALIDARG);
+        TEST_CHECK(heightMap.GetWidth() == 0u);
+
+        return TRUE;
+    }
+}
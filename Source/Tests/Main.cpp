@@ -0,0 +1,105 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   This application runs the headless tests of the Library
+             project and returns the number of failed tests.
+
+  Origin:    http://msdn.microsoft.com/en-us/library/windows/apps/ff729718.aspx
+
+  Originally created by Microsoft Corporation under MIT License
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#if defined(_WIN32)
+#include "Common.h"
+#endif // _WIN32
+
+#include <cstring>
+
+#include "Tests.h"
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+  Struct:   TestCase
+
+  Summary:  Name and entry point of a test
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct TestCase
+{
+    PCSTR pszName;
+    BOOL (*pfnRun)();
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: main
+
+  Summary:  Entry point to the program. Runs every test, or only the
+            tests whose name contains the first argument
+
+  Args:     INT argc
+              Number of command-line arguments
+            CHAR* argv[]
+              Command-line arguments
+
+  Returns:  INT
+              Number of failed tests
+-----------------------------------------------------------------F-F*/
+INT main(_In_ INT argc, _In_reads_(argc) CHAR* argv[])
+{
+    const TestCase aTestCases[] =
+    {
+#if defined(_WIN32)
+        { "CullHiddenVoxelsFlatGrid", tests::TestCullHiddenVoxelsFlatGrid },
+        { "CullHiddenVoxelsMatchesNeighbours", tests::TestCullHiddenVoxelsMatchesNeighbours },
+        { "ChunkMesherFlatChunk", tests::TestChunkMesherFlatChunk },
+        { "ChunkMesherMatchesNaiveCubes", tests::TestChunkMesherMatchesNaiveCubes },
+        { "TerrainStreamerLoadsWholeMap", tests::TestTerrainStreamerLoadsWholeMap },
+        { "TerrainStreamerScriptedPath", tests::TestTerrainStreamerScriptedPath },
+        { "HeightMapBinaryMatchesText", tests::TestHeightMapBinaryMatchesText },
+        { "HeightMapLoadTime", tests::TestHeightMapLoadTime },
+        { "RendererUploadsFrameConstantsOnce", tests::TestRendererUploadsFrameConstantsOnce },
+#endif // _WIN32
+        { "DrawQueueSkipsRedundantBindings", tests::TestDrawQueueSkipsRedundantBindings },
+        { "DrawQueueSplitMatchesSubmit", tests::TestDrawQueueSplitMatchesSubmit },
+#if defined(_WIN32)
+        { "Perlin2dRowMatchesScalar", tests::TestPerlin2dRowMatchesScalar },
+        { "TerrainGeneratorNoiseCache", tests::TestTerrainGeneratorNoiseCache },
+        { "ModelBlendsWeightedClips", tests::TestModelBlendsWeightedClips },
+        { "ModelCrossfadeRemovesFadedClips", tests::TestModelCrossfadeRemovesFadedClips },
+        { "ModelPosesWithoutAllocating", tests::TestModelPosesWithoutAllocating },
+        { "ModelInterpolatesSkippedFrames", tests::TestModelInterpolatesSkippedFrames },
+        { "AnimationLodCrowdScaling", tests::TestAnimationLodCrowdScaling },
+        { "BiomeTableMatchesClassifyBiome", tests::TestBiomeTableMatchesClassifyBiome },
+        { "HeightMapRejectsOversizedMaps", tests::TestHeightMapRejectsOversizedMaps },
+        { "AnimationClipFindKeyMatchesLinearScan", tests::TestAnimationClipFindKeyMatchesLinearScan },
+        { "AnimationClipFindKeyTime", tests::TestAnimationClipFindKeyTime },
+        { "ModelComposedChainMatchesMatrixProducts", tests::TestModelComposedChainMatchesMatrixProducts },
+        { "ModelFlatSkeletonMatchesTreeWalk", tests::TestModelFlatSkeletonMatchesTreeWalk },
+        { "AnimationClipQuantizedRotationsMatchFloat", tests::TestAnimationClipQuantizedRotationsMatchFloat },
+        { "ModelSharesAssetPerDevice", tests::TestModelSharesAssetPerDevice },
+        { "ModelParallelImportMatchesSerial", tests::TestModelParallelImportMatchesSerial },
+        { "AnimationCrowdThreadScaling", tests::TestAnimationCrowdThreadScaling },
+        { "RendererRecordingThreadScaling", tests::TestRendererRecordingThreadScaling },
+        { "RendererBatchesSharedMeshes", tests::TestRendererBatchesSharedMeshes },
+#endif // _WIN32
+    };
+
+    INT numFailed = 0;
+    for (const TestCase& testCase : aTestCases)
+    {
+        if (argc > 1 && strstr(testCase.pszName, argv[1]) == nullptr)
+        {
+            continue;
+        }
+
+        printf("%s\n", testCase.pszName);
+        if (!testCase.pfnRun())
+        {
+            printf("  FAILED\n");
+            ++numFailed;
+        }
+    }
+
+    printf("%d failed\n", numFailed);
+
+    return numFailed;
+}
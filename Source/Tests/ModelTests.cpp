@@ -0,0 +1,1046 @@
+#include "Tests.h"
+
+#include <atomic>
+#include <cmath>
+#include <new>
+#include <random>
+
+#include "assimp/anim.h"
+#include "assimp/scene.h"
+
+#include "Model/AnimationClip.h"
+#include "Model/Model.h"
+
+namespace
+{
+    std::atomic<size_t> g_uNumAllocations(0u);
+    std::atomic<size_t> g_uNumAllocatedBytes(0u);
+}
+
+/*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+  Function: operator new
+
+  Summary:  Counts every allocation of the test executable
+
+  Args:     size_t uSize
+              Number of bytes
+
+  Returns:  void*
+              Allocated memory
+-----------------------------------------------------------------F-F*/
+void* operator new(size_t uSize)
+{
+    ++g_uNumAllocations;
+    g_uNumAllocatedBytes += uSize;
+
+    void* pMemory = malloc(uSize != 0u ? uSize : 1u);
+    if (!pMemory)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pMemory;
+}
+
+/*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+  Function: operator delete
+
+  Summary:  Frees memory allocated by the counting operator new
+
+  Args:     void* pMemory
+              Memory to free
+-----------------------------------------------------------------F-F*/
+void operator delete(void* pMemory) noexcept
+{
+    free(pMemory);
+}
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        constexpr const UINT NUM_CLIPS = 3u;
+        constexpr const FLOAT CLIP_DURATION = 10.0f;
+        constexpr const FLOAT TOLERANCE = 1e-4f;
+
+        // Translation of the bone at the start and at the end of each clip
+        constexpr const XMFLOAT3 CLIP_POSITIONS[NUM_CLIPS][2] =
+        {
+            { XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(10.0f, 0.0f, 0.0f) },
+            { XMFLOAT3(0.0f, 10.0f, 0.0f), XMFLOAT3(0.0f, 10.0f, 0.0f) },
+            { XMFLOAT3(0.0f, 0.0f, 5.0f), XMFLOAT3(0.0f, 0.0f, 5.0f) },
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    TestModel
+
+          Summary:  Model with a root node and one bone, built in memory
+                    instead of loaded from a file. Every clip moves the
+                    bone between the two CLIP_POSITIONS over
+                    CLIP_DURATION seconds
+
+          Methods:  Initialize
+                      Builds the asset and allocates the playback state
+                    GetBoneTranslation
+                      Returns the translation of the posed bone
+                    TestModel
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class TestModel final : public Model
+        {
+        public:
+            TestModel() : Model(L"TestModel") {}
+
+            HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override
+            {
+                m_asset = std::make_shared<SkinnedMeshAsset>();
+                m_asset->aBoneOffsets.push_back(XMMatrixIdentity());
+                m_asset->boneNameToIndexMap["Bone"] = 0u;
+                m_asset->aSkeletonNodes.push_back(SkeletonNode{ .Transformation = XMMatrixIdentity(), .uParentIndex = INVALID_INDEX, .uBoneIndex = INVALID_INDEX });
+                m_asset->aSkeletonNodes.push_back(SkeletonNode{ .Transformation = XMMatrixIdentity(), .uParentIndex = 0u, .uBoneIndex = 0u });
+                m_asset->GlobalInverseTransform = XMMatrixIdentity();
+
+                for (UINT uClip = 0u; uClip < NUM_CLIPS; ++uClip)
+                {
+                    m_asset->aAnimationClips.push_back(createClip(CLIP_POSITIONS[uClip][0], CLIP_POSITIONS[uClip][1]));
+                }
+
+                // The root is not animated, the bone is the only channel of every clip
+                m_asset->aChannels.assign(NUM_CLIPS, AnimationClip::INVALID_CHANNEL);
+                m_asset->aChannels.resize(2u * NUM_CLIPS, 0u);
+
+                initPlayback();
+
+                return S_OK;
+            }
+
+            XMFLOAT3 GetBoneTranslation()
+            {
+                XMFLOAT3 translation;
+                XMStoreFloat3(&translation, GetBoneTransforms()[0].r[3]);
+
+                return translation;
+            }
+
+        private:
+            static std::unique_ptr<AnimationClip> createClip(_In_ const XMFLOAT3& start, _In_ const XMFLOAT3& end)
+            {
+                aiNodeAnim* pNodeAnim = new aiNodeAnim();
+                pNodeAnim->mNodeName = aiString("Bone");
+                pNodeAnim->mNumPositionKeys = 2u;
+                pNodeAnim->mPositionKeys = new aiVectorKey[2]
+                {
+                    aiVectorKey(0.0, aiVector3D(start.x, start.y, start.z)),
+                    aiVectorKey(CLIP_DURATION, aiVector3D(end.x, end.y, end.z))
+                };
+                pNodeAnim->mNumRotationKeys = 1u;
+                pNodeAnim->mRotationKeys = new aiQuatKey[1]{ aiQuatKey(0.0, aiQuaternion()) };
+                pNodeAnim->mNumScalingKeys = 1u;
+                pNodeAnim->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+
+                aiAnimation animation;
+                animation.mDuration = CLIP_DURATION;
+                animation.mTicksPerSecond = 1.0;
+                animation.mNumChannels = 1u;
+                animation.mChannels = new aiNodeAnim*[1]{ pNodeAnim };
+
+                return std::make_unique<AnimationClip>(&animation, FALSE);
+            }
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    SkeletonModel
+
+          Summary:  Model with a branching skeleton of NUM_SKELETON_NODES
+                    animated bones, built in memory instead of loaded from
+                    a file. It can also pose its skeleton by walking the
+                    node tree with name lookups, the way the model did
+                    before the skeleton was flattened
+
+          Methods:  Initialize
+                      Builds the asset and allocates the playback state
+                    WalkNodeTree
+                      Poses the skeleton by walking the node tree
+                    SkeletonModel
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class SkeletonModel final : public Model
+        {
+        public:
+            static constexpr const UINT NUM_SKELETON_NODES = 64u;
+
+        public:
+            SkeletonModel() : Model(L"SkeletonModel") {}
+
+            HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override
+            {
+                constexpr const UINT NUM_KEYS = 32u;
+                constexpr const FLOAT SKELETON_CLIP_DURATION = 60.0f;
+
+                aiAnimation animation;
+                animation.mDuration = SKELETON_CLIP_DURATION;
+                animation.mTicksPerSecond = 30.0;
+                animation.mNumChannels = NUM_SKELETON_NODES;
+                animation.mChannels = new aiNodeAnim*[NUM_SKELETON_NODES];
+
+                m_asset = std::make_shared<SkinnedMeshAsset>();
+                m_aNodeNames.clear();
+                m_aChildren.assign(NUM_SKELETON_NODES, std::vector<UINT>());
+                for (UINT i = 0u; i < NUM_SKELETON_NODES; ++i)
+                {
+                    // Every node has two children, the names all have the same length so no name prefixes another
+                    char szNodeName[16];
+                    sprintf_s(szNodeName, "Bone%02u", i);
+                    UINT uParentIndex = i == 0u ? INVALID_INDEX : (i - 1u) / 2u;
+                    if (uParentIndex != INVALID_INDEX)
+                    {
+                        m_aChildren[uParentIndex].push_back(i);
+                    }
+
+                    m_aNodeNames.push_back(szNodeName);
+                    m_asset->aBoneOffsets.push_back(XMMatrixTranslation(0.0f, -static_cast<FLOAT>(i), 0.0f));
+                    m_asset->boneNameToIndexMap[szNodeName] = i;
+                    m_asset->aSkeletonNodes.push_back(SkeletonNode{ .Transformation = XMMatrixIdentity(), .uParentIndex = uParentIndex, .uBoneIndex = i });
+                    m_asset->aChannels.push_back(i);
+
+                    aiNodeAnim* pNodeAnim = new aiNodeAnim();
+                    pNodeAnim->mNodeName = aiString(szNodeName);
+                    pNodeAnim->mNumPositionKeys = NUM_KEYS;
+                    pNodeAnim->mPositionKeys = new aiVectorKey[NUM_KEYS];
+                    pNodeAnim->mNumRotationKeys = NUM_KEYS;
+                    pNodeAnim->mRotationKeys = new aiQuatKey[NUM_KEYS];
+                    pNodeAnim->mNumScalingKeys = 1u;
+                    pNodeAnim->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+                    for (UINT uKey = 0u; uKey < NUM_KEYS; ++uKey)
+                    {
+                        FLOAT keyTime = SKELETON_CLIP_DURATION * static_cast<FLOAT>(uKey) / static_cast<FLOAT>(NUM_KEYS - 1u);
+                        FLOAT angle = 0.05f * static_cast<FLOAT>(uKey + i);
+                        pNodeAnim->mPositionKeys[uKey] = aiVectorKey(keyTime, aiVector3D(0.1f * static_cast<FLOAT>(i % 3u), 1.0f, 0.05f * static_cast<FLOAT>(uKey)));
+                        pNodeAnim->mRotationKeys[uKey] = aiQuatKey(keyTime, aiQuaternion(aiVector3D(0.0f, 0.0f, 1.0f), angle));
+                    }
+                    animation.mChannels[i] = pNodeAnim;
+                }
+                m_asset->aAnimationClips.push_back(std::make_unique<AnimationClip>(&animation, FALSE));
+                m_asset->GlobalInverseTransform = XMMatrixTranslation(0.0f, -1.0f, 0.0f);
+
+                initPlayback();
+
+                return S_OK;
+            }
+
+            void WalkNodeTree(_In_ FLOAT time, _Out_ std::vector<XMMATRIX>& aOutTransforms)
+            {
+                const AnimationClip& animationClip = *m_asset->aAnimationClips[0];
+                FLOAT animationTimeTicks = fmod(time * animationClip.GetTicksPerSecond(), animationClip.GetDuration());
+
+                aOutTransforms.resize(NUM_SKELETON_NODES);
+                walkNode(animationTimeTicks, 0u, XMMatrixIdentity(), aOutTransforms);
+            }
+
+        private:
+            void walkNode(_In_ FLOAT animationTimeTicks, _In_ UINT uNode, _In_ const XMMATRIX& parentTransform, _Out_ std::vector<XMMATRIX>& aOutTransforms)
+            {
+                const AnimationClip& animationClip = *m_asset->aAnimationClips[0];
+                const std::string& nodeName = m_aNodeNames[uNode];
+
+                XMMATRIX nodeTransformation = m_asset->aSkeletonNodes[uNode].Transformation;
+                UINT uChannel = animationClip.FindChannel(nodeName.c_str());
+                if (uChannel != AnimationClip::INVALID_CHANNEL)
+                {
+                    XMFLOAT3 scalingFloat3 = XMFLOAT3();
+                    XMVECTOR rotationVector = XMVECTOR();
+                    XMFLOAT3 positionFloat3 = XMFLOAT3();
+                    AnimationClip::KeyCursor cursor = {};
+
+                    animationClip.SampleChannel(uChannel, animationTimeTicks, cursor, scalingFloat3, rotationVector, positionFloat3);
+
+                    XMMATRIX scalingMatrix = XMMatrixScaling(scalingFloat3.x, scalingFloat3.y, scalingFloat3.z);
+                    XMMATRIX rotationMatrix = XMMatrixRotationQuaternion(rotationVector);
+                    XMMATRIX translationMatrix = XMMatrixTranslation(positionFloat3.x, positionFloat3.y, positionFloat3.z);
+                    nodeTransformation = scalingMatrix * rotationMatrix * translationMatrix;
+                }
+                XMMATRIX globalTransformation = nodeTransformation * parentTransform;
+
+                if (m_asset->boneNameToIndexMap.find(nodeName) != m_asset->boneNameToIndexMap.end())
+                {
+                    UINT uBoneIndex = m_asset->boneNameToIndexMap.find(nodeName)->second;
+                    aOutTransforms[uBoneIndex] = m_asset->aBoneOffsets[uBoneIndex] * globalTransformation * m_asset->GlobalInverseTransform;
+                }
+
+                for (UINT uChild : m_aChildren[uNode])
+                {
+                    walkNode(animationTimeTicks, uChild, globalTransformation, aOutTransforms);
+                }
+            }
+
+        private:
+            std::vector<std::string> m_aNodeNames;
+            std::vector<std::vector<UINT>> m_aChildren;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    AssetModel
+
+          Summary:  Model whose asset is built in memory in place of
+                    parsing its file, through the regular Initialize.
+                    Every parse is counted
+
+          Methods:  GetNumParses
+                      Returns the number of assets built
+                    AssetModel
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class AssetModel final : public Model
+        {
+        public:
+            static constexpr const UINT NUM_BONES = 64u;
+            static constexpr const UINT NUM_VERTICES = 10000u;
+
+        public:
+            AssetModel(_In_ const std::filesystem::path& filePath) : Model(filePath) {}
+
+            static UINT GetNumParses()
+            {
+                return sm_uNumParses;
+            }
+
+        protected:
+            HRESULT loadAsset(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override
+            {
+                ++sm_uNumParses;
+
+                m_asset = std::make_shared<SkinnedMeshAsset>();
+                m_asset->aVertices.resize(NUM_VERTICES);
+                m_asset->aIndices.resize(3u * NUM_VERTICES);
+                for (UINT i = 0u; i < NUM_BONES; ++i)
+                {
+                    m_asset->aBoneOffsets.push_back(XMMatrixIdentity());
+                    m_asset->boneNameToIndexMap["Bone" + std::to_string(i)] = i;
+                    m_asset->aSkeletonNodes.push_back(SkeletonNode{ .Transformation = XMMatrixIdentity(), .uParentIndex = i == 0u ? INVALID_INDEX : i - 1u, .uBoneIndex = i });
+                }
+                m_asset->GlobalInverseTransform = XMMatrixIdentity();
+
+                return S_OK;
+            }
+
+        private:
+            static UINT sm_uNumParses;
+        };
+
+        UINT AssetModel::sm_uNumParses = 0u;
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    ImportModel
+
+          Summary:  Model that imports the meshes and bone weights of an
+                    in memory scene, in parallel like initFromScene or
+                    serially one mesh after the other
+
+          Methods:  Import
+                      Imports the meshes and bone weights of a scene
+                    GetVertices
+                      Returns the imported vertices
+                    GetIndices
+                      Returns the imported indices
+                    GetNormalData
+                      Returns the imported tangents and bitangents
+                    GetBoneData
+                      Returns the imported bone weights
+                    ImportModel
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class ImportModel final : public Model
+        {
+        public:
+            ImportModel() : Model(L"ImportModel") {}
+
+            void Import(_In_ const aiScene* pScene, _In_ BOOL bParallel)
+            {
+                m_asset = std::make_shared<SkinnedMeshAsset>();
+                m_aMeshes.resize(pScene->mNumMeshes);
+
+                UINT uNumVertices = 0u;
+                UINT uNumIndices = 0u;
+                countVerticesAndIndices(uNumVertices, uNumIndices, pScene);
+                reserveSpace(uNumVertices, uNumIndices);
+
+                if (bParallel)
+                {
+                    initAllMeshes(pScene);
+                    initAllBones(pScene);
+                    return;
+                }
+
+                for (UINT i = 0u; i < pScene->mNumMeshes; ++i)
+                {
+                    initSingleMesh(i, pScene->mMeshes[i]);
+                }
+
+                for (UINT i = 0u; i < pScene->mNumMeshes; ++i)
+                {
+                    for (UINT j = 0u; j < pScene->mMeshes[i]->mNumBones; ++j)
+                    {
+                        getBoneId(pScene->mMeshes[i]->mBones[j]);
+                    }
+                }
+
+                for (UINT i = 0u; i < pScene->mNumMeshes; ++i)
+                {
+                    initMeshBones(i, pScene->mMeshes[i]);
+                }
+            }
+
+            const std::vector<SimpleVertex>& GetVertices() const
+            {
+                return m_asset->aVertices;
+            }
+
+            const std::vector<WORD>& GetIndices() const
+            {
+                return m_asset->aIndices;
+            }
+
+            const std::vector<NormalData>& GetNormalData() const
+            {
+                return m_aNormalData;
+            }
+
+            const std::vector<VertexBoneData>& GetBoneData() const
+            {
+                return m_aBoneData;
+            }
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: clipPosition
+
+          Summary:  Returns the translation a clip gives the bone
+
+          Args:     UINT uClip
+                      Index of the clip
+                    FLOAT time
+                      Seconds since the clip started
+
+          Returns:  XMVECTOR
+                      Translation of the bone
+        -----------------------------------------------------------------F-F*/
+        XMVECTOR clipPosition(_In_ UINT uClip, _In_ FLOAT time)
+        {
+            return XMVectorLerp(XMLoadFloat3(&CLIP_POSITIONS[uClip][0]), XMLoadFloat3(&CLIP_POSITIONS[uClip][1]), fmod(time, CLIP_DURATION) / CLIP_DURATION);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isNear
+
+          Summary:  Compares a posed translation with the expected one
+
+          Args:     const XMFLOAT3& translation
+                      Posed translation
+                    FXMVECTOR expected
+                      Expected translation
+
+          Returns:  BOOL
+                      TRUE if they are within TOLERANCE
+        -----------------------------------------------------------------F-F*/
+        BOOL isNear(_In_ const XMFLOAT3& translation, _In_ FXMVECTOR expected)
+        {
+            return XMVector3NearEqual(XMLoadFloat3(&translation), expected, XMVectorReplicate(TOLERANCE));
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: createScene
+
+          Summary:  Creates a scene of meshes with random vertices and
+                    triangles. Only some meshes have texture coordinates
+                    or tangents, and the bones of every mesh weigh
+                    disjoint runs of its vertices
+
+          Args:     UINT uNumMeshes
+                      Number of meshes
+                    std::mt19937& generator
+                      Random number generator
+
+          Returns:  std::unique_ptr<aiScene>
+                      Scene that owns its meshes
+        -----------------------------------------------------------------F-F*/
+        std::unique_ptr<aiScene> createScene(_In_ UINT uNumMeshes, _Inout_ std::mt19937& generator)
+        {
+            constexpr const UINT NUM_BONES_PER_MESH = 4u;
+
+            std::uniform_real_distribution<FLOAT> unitDistribution(-1.0f, 1.0f);
+            std::uniform_int_distribution<UINT> vertexCountDistribution(64u, 4096u);
+
+            std::unique_ptr<aiScene> pScene = std::make_unique<aiScene>();
+            pScene->mNumMeshes = uNumMeshes;
+            pScene->mMeshes = new aiMesh*[uNumMeshes];
+            for (UINT uMesh = 0u; uMesh < uNumMeshes; ++uMesh)
+            {
+                aiMesh* pMesh = new aiMesh();
+                pScene->mMeshes[uMesh] = pMesh;
+
+                UINT uNumVertices = vertexCountDistribution(generator);
+                pMesh->mNumVertices = uNumVertices;
+                pMesh->mVertices = new aiVector3D[uNumVertices];
+                pMesh->mNormals = new aiVector3D[uNumVertices];
+                if (uMesh % 2u == 0u)
+                {
+                    pMesh->mTextureCoords[0] = new aiVector3D[uNumVertices];
+                    pMesh->mNumUVComponents[0] = 2u;
+                }
+                if (uMesh % 3u == 0u)
+                {
+                    pMesh->mTangents = new aiVector3D[uNumVertices];
+                    pMesh->mBitangents = new aiVector3D[uNumVertices];
+                }
+
+                for (UINT i = 0u; i < uNumVertices; ++i)
+                {
+                    pMesh->mVertices[i] = aiVector3D(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+                    pMesh->mNormals[i] = aiVector3D(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+                    if (pMesh->mTextureCoords[0])
+                    {
+                        pMesh->mTextureCoords[0][i] = aiVector3D(unitDistribution(generator), unitDistribution(generator), 0.0f);
+                    }
+                    if (pMesh->mTangents)
+                    {
+                        pMesh->mTangents[i] = aiVector3D(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+                        pMesh->mBitangents[i] = aiVector3D(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+                    }
+                }
+
+                pMesh->mNumFaces = uNumVertices;
+                pMesh->mFaces = new aiFace[uNumVertices];
+                for (UINT i = 0u; i < uNumVertices; ++i)
+                {
+                    aiFace& face = pMesh->mFaces[i];
+                    face.mNumIndices = 3u;
+                    face.mIndices = new unsigned int[3]{ generator() % uNumVertices, generator() % uNumVertices, generator() % uNumVertices };
+                }
+
+                // Meshes share some bone names, so ids are assigned across meshes
+                pMesh->mNumBones = NUM_BONES_PER_MESH;
+                pMesh->mBones = new aiBone*[NUM_BONES_PER_MESH];
+                for (UINT uBone = 0u; uBone < NUM_BONES_PER_MESH; ++uBone)
+                {
+                    aiBone* pBone = new aiBone();
+                    pBone->mName = aiString("Bone" + std::to_string(uMesh / 2u + uBone));
+                    pBone->mNumWeights = uNumVertices / NUM_BONES_PER_MESH;
+                    pBone->mWeights = new aiVertexWeight[pBone->mNumWeights];
+                    for (UINT i = 0u; i < pBone->mNumWeights; ++i)
+                    {
+                        pBone->mWeights[i] = aiVertexWeight(uBone * pBone->mNumWeights + i, 0.5f + 0.5f * unitDistribution(generator));
+                    }
+                    pMesh->mBones[uBone] = pBone;
+                }
+            }
+
+            return pScene;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: randomPose
+
+          Summary:  Creates a random local transform, scaled between 0.5
+                    and 2 along each axis
+
+          Args:     std::mt19937& generator
+                      Random number generator
+                    XMVECTOR& outScaling
+                      Receives the scale along each axis
+                    XMVECTOR& outRotation
+                      Receives the rotation quaternion
+                    XMVECTOR& outTranslation
+                      Receives the translation
+        -----------------------------------------------------------------F-F*/
+        void randomPose(_Inout_ std::mt19937& generator, _Out_ XMVECTOR& outScaling, _Out_ XMVECTOR& outRotation, _Out_ XMVECTOR& outTranslation)
+        {
+            std::uniform_real_distribution<FLOAT> scaleDistribution(0.5f, 2.0f);
+            std::uniform_real_distribution<FLOAT> unitDistribution(-1.0f, 1.0f);
+
+            outScaling = XMVectorSet(scaleDistribution(generator), scaleDistribution(generator), scaleDistribution(generator), 0.0f);
+            outRotation = XMQuaternionNormalize(XMVectorSet(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator), unitDistribution(generator)));
+            outTranslation = XMVectorSet(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator), 0.0f);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelBlendsWeightedClips
+
+      Summary:  Plays three clips at relative weights and checks that
+                the bone ends at the normalized weighted sum of their
+                poses
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelBlendsWeightedClips()
+    {
+        TestModel model;
+        TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+
+        TEST_CHECK(SUCCEEDED(model.BlendAnimationClip(0u, 0.7f, 0.0f)));
+        TEST_CHECK(SUCCEEDED(model.BlendAnimationClip(1u, 0.3f, 0.0f)));
+        model.Advance(2.0f);
+        model.PoseSkeleton();
+
+        // Clip 1 started 2 seconds after clip 0, both advanced by 2
+        XMVECTOR expected = 0.7f * clipPosition(0u, 2.0f) + 0.3f * clipPosition(1u, 2.0f);
+        TEST_CHECK(isNear(model.GetBoneTranslation(), expected));
+
+        // Weights are relative, 2:1:1 blends like 0.5, 0.25 and 0.25
+        TEST_CHECK(SUCCEEDED(model.BlendAnimationClip(0u, 2.0f, 0.0f)));
+        TEST_CHECK(SUCCEEDED(model.BlendAnimationClip(1u, 1.0f, 0.0f)));
+        TEST_CHECK(SUCCEEDED(model.BlendAnimationClip(2u, 1.0f, 0.0f)));
+        model.Advance(3.0f);
+        model.PoseSkeleton();
+
+        expected = 0.5f * clipPosition(0u, 5.0f) + 0.25f * clipPosition(1u, 5.0f) + 0.25f * clipPosition(2u, 3.0f);
+        TEST_CHECK(isNear(model.GetBoneTranslation(), expected));
+
+        // A single clip poses exactly as that clip
+        TEST_CHECK(SUCCEEDED(model.SetAnimationClip(2u)));
+        model.Advance(1.0f);
+        model.PoseSkeleton();
+        TEST_CHECK(isNear(model.GetBoneTranslation(), clipPosition(2u, 1.0f)));
+        TEST_CHECK(model.GetAnimationClipWeight(0u) == 0.0f);
+
+        TEST_CHECK(model.BlendAnimationClip(NUM_CLIPS, 1.0f, 0.0f) == E_INVALIDARG);
+        TEST_CHECK(model.BlendAnimationClip(0u, -1.0f, 0.0f) == E_INVALIDARG);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelCrossfadeRemovesFadedClips
+
+      Summary:  Starts a crossfade in the middle of another one and
+                checks that the weights always sum to 1 and that the
+                clips that faded out stop playing
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelCrossfadeRemovesFadedClips()
+    {
+        TestModel model;
+        TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+
+        TEST_CHECK(SUCCEEDED(model.CrossfadeToAnimationClip(1u, 1.0f)));
+        model.Advance(0.25f);
+        TEST_CHECK(fabs(model.GetAnimationClipWeight(0u) - 0.75f) < TOLERANCE);
+        TEST_CHECK(fabs(model.GetAnimationClipWeight(1u) - 0.25f) < TOLERANCE);
+
+        // Both clips fade out from where the first crossfade left them
+        TEST_CHECK(SUCCEEDED(model.CrossfadeToAnimationClip(2u, 1.0f)));
+        model.Advance(0.5f);
+        FLOAT aWeights[NUM_CLIPS];
+        FLOAT totalWeight = 0.0f;
+        for (UINT uClip = 0u; uClip < NUM_CLIPS; ++uClip)
+        {
+            aWeights[uClip] = model.GetAnimationClipWeight(uClip);
+            totalWeight += aWeights[uClip];
+        }
+        TEST_CHECK(fabs(aWeights[0] - 0.375f) < TOLERANCE);
+        TEST_CHECK(fabs(aWeights[1] - 0.125f) < TOLERANCE);
+        TEST_CHECK(fabs(aWeights[2] - 0.5f) < TOLERANCE);
+        TEST_CHECK(fabs(totalWeight - 1.0f) < TOLERANCE);
+
+        model.PoseSkeleton();
+        XMVECTOR expected = aWeights[0] * clipPosition(0u, 0.75f) + aWeights[1] * clipPosition(1u, 0.75f) + aWeights[2] * clipPosition(2u, 0.5f);
+        TEST_CHECK(isNear(model.GetBoneTranslation(), expected));
+
+        model.Advance(0.5f);
+        TEST_CHECK(model.GetAnimationClipWeight(0u) == 0.0f);
+        TEST_CHECK(model.GetAnimationClipWeight(1u) == 0.0f);
+        TEST_CHECK(model.GetAnimationClipWeight(2u) == 1.0f);
+
+        model.PoseSkeleton();
+        TEST_CHECK(isNear(model.GetBoneTranslation(), clipPosition(2u, 1.0f)));
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelInterpolatesSkippedFrames
+
+      Summary:  Poses a model every few frames the way the animation
+                level of detail does and checks that the frames in
+                between keep moving along the clip instead of holding
+                the last pose. The clip moves the bone at a constant
+                speed, so the interpolated palette matches it exactly
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelInterpolatesSkippedFrames()
+    {
+        constexpr const UINT NUM_FRAMES = 300u;
+        constexpr const UINT UPDATE_INTERVAL = 4u;
+        constexpr const FLOAT DELTA_TIME = 1.0f / 60.0f;
+
+        TestModel model;
+        TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+
+        UINT uNumPoses = 0u;
+        FLOAT time = 0.0f;
+        XMFLOAT3 lastTranslation = XMFLOAT3(-1.0f, 0.0f, 0.0f);
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            model.Advance(DELTA_TIME);
+            time += DELTA_TIME;
+            if (model.GetFramesSincePose() >= UPDATE_INTERVAL)
+            {
+                model.PoseSkeleton(UPDATE_INTERVAL);
+                ++uNumPoses;
+            }
+
+            XMFLOAT3 translation = model.GetBoneTranslation();
+            TEST_CHECK(isNear(translation, clipPosition(0u, time)));
+            TEST_CHECK(translation.x > lastTranslation.x);
+            lastTranslation = translation;
+        }
+
+        // The first pose is taken at the current time, the model is due again the frame after
+        printf("  %u frames: %u poses\n", NUM_FRAMES, uNumPoses);
+        TEST_CHECK(uNumPoses <= 2u + NUM_FRAMES / UPDATE_INTERVAL);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelPosesWithoutAllocating
+
+      Summary:  Plays, blends and crossfades clips for many frames and
+                checks that none of them allocates once the first pose
+                sized the scratch transforms
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelPosesWithoutAllocating()
+    {
+        constexpr const UINT NUM_FRAMES = 1000u;
+        constexpr const FLOAT DELTA_TIME = 1.0f / 60.0f;
+
+        TestModel model;
+        TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+        model.PoseSkeleton();
+
+        size_t uNumAllocations = g_uNumAllocations;
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            switch (uFrame % 120u)
+            {
+            case 0u:
+                TEST_CHECK(SUCCEEDED(model.CrossfadeToAnimationClip((uFrame / 120u) % NUM_CLIPS, 0.5f)));
+                break;
+            case 60u:
+                TEST_CHECK(SUCCEEDED(model.BlendAnimationClip((uFrame / 120u + 1u) % NUM_CLIPS, 0.5f, 0.25f)));
+                break;
+            case 90u:
+                TEST_CHECK(SUCCEEDED(model.BlendAnimationClip((uFrame / 120u + 2u) % NUM_CLIPS, 0.25f, 0.0f)));
+                break;
+            default:
+                break;
+            }
+
+            model.Advance(DELTA_TIME);
+            model.PoseSkeleton();
+        }
+        uNumAllocations = g_uNumAllocations - uNumAllocations;
+
+        printf("  %u frames: %zu allocations\n", NUM_FRAMES, uNumAllocations);
+        TEST_CHECK(uNumAllocations == 0u);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelComposedChainMatchesMatrixProducts
+
+      Summary:  Poses a random 32 node skeleton 10000 times, once with
+                ComposeTransformation and the global inverse folded
+                into the root, once with scaling * rotation *
+                translation products and the global inverse applied to
+                every bone. The palettes must match and the time per
+                bone of both is printed
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelComposedChainMatchesMatrixProducts()
+    {
+        constexpr const UINT NUM_NODES = 32u;
+        constexpr const UINT NUM_POSES = 10000u;
+        constexpr const UINT NUM_BONES = NUM_NODES * NUM_POSES;
+        constexpr const FLOAT MAX_ERROR = 1e-4f;
+
+        std::mt19937 generator(18u);
+
+        UINT aParentIndices[NUM_NODES];
+        std::vector<XMMATRIX> aBoneOffsets(NUM_NODES);
+        for (UINT i = 0u; i < NUM_NODES; ++i)
+        {
+            aParentIndices[i] = i == 0u ? 0xFFFFFFFF : static_cast<UINT>(generator() % i);
+
+            XMVECTOR scaling;
+            XMVECTOR rotation;
+            XMVECTOR translation;
+            randomPose(generator, scaling, rotation, translation);
+            aBoneOffsets[i] = XMMatrixInverse(nullptr, Model::ComposeTransformation(scaling, rotation, translation));
+        }
+
+        XMVECTOR rootScaling;
+        XMVECTOR rootRotation;
+        XMVECTOR rootTranslation;
+        randomPose(generator, rootScaling, rootRotation, rootTranslation);
+        XMMATRIX globalInverseTransform = XMMatrixInverse(nullptr, Model::ComposeTransformation(rootScaling, rootRotation, rootTranslation));
+
+        std::vector<XMVECTOR> aScalings(NUM_BONES);
+        std::vector<XMVECTOR> aRotations(NUM_BONES);
+        std::vector<XMVECTOR> aTranslations(NUM_BONES);
+        for (UINT i = 0u; i < NUM_BONES; ++i)
+        {
+            randomPose(generator, aScalings[i], aRotations[i], aTranslations[i]);
+        }
+
+        std::vector<XMMATRIX> aGlobalTransforms(NUM_NODES);
+        std::vector<XMMATRIX> aProductTransforms(NUM_BONES);
+        std::vector<XMMATRIX> aComposedTransforms(NUM_BONES);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        QueryPerformanceCounter(&startTime);
+        for (UINT uPose = 0u; uPose < NUM_POSES; ++uPose)
+        {
+            for (UINT i = 0u; i < NUM_NODES; ++i)
+            {
+                UINT uBone = uPose * NUM_NODES + i;
+                XMMATRIX nodeTransformation = XMMatrixScalingFromVector(aScalings[uBone]) * XMMatrixRotationQuaternion(aRotations[uBone]) * XMMatrixTranslationFromVector(aTranslations[uBone]);
+                aGlobalTransforms[i] = i == 0u ? nodeTransformation : nodeTransformation * aGlobalTransforms[aParentIndices[i]];
+                aProductTransforms[uBone] = aBoneOffsets[i] * aGlobalTransforms[i] * globalInverseTransform;
+            }
+        }
+        QueryPerformanceCounter(&endTime);
+        DOUBLE productNanoseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1e9 / static_cast<DOUBLE>(frequency.QuadPart) / NUM_BONES;
+
+        QueryPerformanceCounter(&startTime);
+        for (UINT uPose = 0u; uPose < NUM_POSES; ++uPose)
+        {
+            for (UINT i = 0u; i < NUM_NODES; ++i)
+            {
+                UINT uBone = uPose * NUM_NODES + i;
+                XMMATRIX nodeTransformation = Model::ComposeTransformation(aScalings[uBone], aRotations[uBone], aTranslations[uBone]);
+                aGlobalTransforms[i] = nodeTransformation * (i == 0u ? globalInverseTransform : aGlobalTransforms[aParentIndices[i]]);
+                aComposedTransforms[uBone] = aBoneOffsets[i] * aGlobalTransforms[i];
+            }
+        }
+        QueryPerformanceCounter(&endTime);
+        DOUBLE composedNanoseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1e9 / static_cast<DOUBLE>(frequency.QuadPart) / NUM_BONES;
+
+        // Error relative to the magnitude of each element, products grow along the chain
+        FLOAT maxError = 0.0f;
+        for (UINT i = 0u; i < NUM_BONES; ++i)
+        {
+            XMFLOAT4X4 product;
+            XMFLOAT4X4 composed;
+            XMStoreFloat4x4(&product, aProductTransforms[i]);
+            XMStoreFloat4x4(&composed, aComposedTransforms[i]);
+            for (UINT uRow = 0u; uRow < 4u; ++uRow)
+            {
+                for (UINT uColumn = 0u; uColumn < 4u; ++uColumn)
+                {
+                    FLOAT magnitude = fabsf(product.m[uRow][uColumn]);
+                    FLOAT error = fabsf(composed.m[uRow][uColumn] - product.m[uRow][uColumn]) / (magnitude > 1.0f ? magnitude : 1.0f);
+                    maxError = error > maxError ? error : maxError;
+                }
+            }
+        }
+
+        printf("  %u bones: products %.1f ns/bone, composed %.1f ns/bone, max error %g\n", NUM_BONES, productNanoseconds, composedNanoseconds, maxError);
+        TEST_CHECK(maxError < MAX_ERROR);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelFlatSkeletonMatchesTreeWalk
+
+      Summary:  Plays a 64 bone skeleton for many frames, posing it
+                through the flattened skeleton and by walking the node
+                tree with name lookups. The palettes must match and the
+                time per frame of both is printed
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelFlatSkeletonMatchesTreeWalk()
+    {
+        constexpr const UINT NUM_FRAMES = 2000u;
+        constexpr const FLOAT DELTA_TIME = 1.0f / 60.0f;
+        constexpr const FLOAT MAX_ERROR = 1e-4f;
+
+        SkeletonModel model;
+        TEST_CHECK(SUCCEEDED(model.Initialize(nullptr, nullptr)));
+        TEST_CHECK(SUCCEEDED(model.SetAnimationClip(0u)));
+
+        // Same frames both ways first, comparing every palette
+        std::vector<XMMATRIX> aTreeTransforms;
+        FLOAT time = 0.0f;
+        FLOAT maxError = 0.0f;
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            model.Advance(DELTA_TIME);
+            time += DELTA_TIME;
+            model.PoseSkeleton();
+            model.WalkNodeTree(time, aTreeTransforms);
+
+            const std::vector<XMMATRIX>& aFlatTransforms = model.GetBoneTransforms();
+            for (UINT uBone = 0u; uBone < SkeletonModel::NUM_SKELETON_NODES; ++uBone)
+            {
+                for (UINT uRow = 0u; uRow < 4u; ++uRow)
+                {
+                    XMVECTOR difference = XMVectorAbs(XMVectorSubtract(aFlatTransforms[uBone].r[uRow], aTreeTransforms[uBone].r[uRow]));
+                    FLOAT error = XMVectorGetX(XMVector4Dot(difference, XMVectorReplicate(1.0f)));
+                    maxError = error > maxError ? error : maxError;
+                }
+            }
+        }
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        QueryPerformanceCounter(&startTime);
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            model.Advance(DELTA_TIME);
+            model.PoseSkeleton();
+        }
+        QueryPerformanceCounter(&endTime);
+        DOUBLE flatMicroseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1e6 / static_cast<DOUBLE>(frequency.QuadPart) / NUM_FRAMES;
+
+        QueryPerformanceCounter(&startTime);
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            time += DELTA_TIME;
+            model.WalkNodeTree(time, aTreeTransforms);
+        }
+        QueryPerformanceCounter(&endTime);
+        DOUBLE treeMicroseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1e6 / static_cast<DOUBLE>(frequency.QuadPart) / NUM_FRAMES;
+
+        printf("  %u bones: flattened %.2f us/frame, tree walk %.2f us/frame, max error %g\n", SkeletonModel::NUM_SKELETON_NODES, flatMicroseconds, treeMicroseconds, maxError);
+        TEST_CHECK(maxError < MAX_ERROR);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelSharesAssetPerDevice
+
+      Summary:  Initializes many models of one file on a WARP device.
+                The file is parsed once and every further model only
+                adds its own playback state and bone palette. Another
+                device parses the file again, and the assets are dropped
+                once their models are destroyed
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelSharesAssetPerDevice()
+    {
+        constexpr const UINT NUM_MODELS = 100u;
+        constexpr const size_t PALETTE_SIZE = AssetModel::NUM_BONES * sizeof(XMMATRIX);
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        ComPtr<ID3D11Device> otherDevice;
+        ComPtr<ID3D11DeviceContext> otherImmediateContext;
+        TEST_CHECK(SUCCEEDED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0u, nullptr, 0u, D3D11_SDK_VERSION, device.GetAddressOf(), nullptr, immediateContext.GetAddressOf())));
+        TEST_CHECK(SUCCEEDED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0u, nullptr, 0u, D3D11_SDK_VERSION, otherDevice.GetAddressOf(), nullptr, otherImmediateContext.GetAddressOf())));
+
+        UINT uNumParses = AssetModel::GetNumParses();
+        size_t uNumAssets = Model::GetNumSharedAssets();
+        {
+            std::vector<std::unique_ptr<AssetModel>> aModels;
+            aModels.reserve(NUM_MODELS);
+            aModels.push_back(std::make_unique<AssetModel>(L"Content/AssetModel.fbx"));
+            TEST_CHECK(SUCCEEDED(aModels.back()->Initialize(device.Get(), immediateContext.Get())));
+
+            // Every further model shares the asset, also through another spelling of the path
+            size_t uNumAllocatedBytes = g_uNumAllocatedBytes;
+            for (UINT i = 1u; i < NUM_MODELS; ++i)
+            {
+                aModels.push_back(std::make_unique<AssetModel>(i & 1u ? L"Content/AssetModel.fbx" : L"Content/../Content/AssetModel.fbx"));
+                TEST_CHECK(SUCCEEDED(aModels.back()->Initialize(device.Get(), immediateContext.Get())));
+            }
+            size_t uBytesPerModel = (g_uNumAllocatedBytes - uNumAllocatedBytes) / (NUM_MODELS - 1u);
+
+            printf("  %u models: %u parse, %zu bytes per model with a %zu byte palette\n", NUM_MODELS, AssetModel::GetNumParses() - uNumParses, uBytesPerModel, PALETTE_SIZE);
+
+            TEST_CHECK(AssetModel::GetNumParses() == uNumParses + 1u);
+            TEST_CHECK(Model::GetNumSharedAssets() == uNumAssets + 1u);
+
+            // The current, previous and posed palettes, the key cursors and the model itself
+            TEST_CHECK(uBytesPerModel <= sizeof(AssetModel) + 4u * PALETTE_SIZE);
+
+            AssetModel otherModel(L"Content/AssetModel.fbx");
+            TEST_CHECK(SUCCEEDED(otherModel.Initialize(otherDevice.Get(), otherImmediateContext.Get())));
+            TEST_CHECK(AssetModel::GetNumParses() == uNumParses + 2u);
+            TEST_CHECK(Model::GetNumSharedAssets() == uNumAssets + 2u);
+        }
+
+        // Both assets expired with their models and are dropped by the next model
+        AssetModel model(L"Content/OtherModel.fbx");
+        TEST_CHECK(SUCCEEDED(model.Initialize(device.Get(), immediateContext.Get())));
+        TEST_CHECK(AssetModel::GetNumParses() == uNumParses + 3u);
+        TEST_CHECK(Model::GetNumSharedAssets() == uNumAssets + 1u);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestModelParallelImportMatchesSerial
+
+      Summary:  Imports a scene of 32 meshes in parallel and serially.
+                The vertices, indices, tangents and bone weights must
+                be byte for byte the same
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelParallelImportMatchesSerial()
+    {
+        constexpr const UINT NUM_MESHES = 32u;
+
+        std::mt19937 generator(20u);
+        std::unique_ptr<aiScene> pScene = createScene(NUM_MESHES, generator);
+
+        ImportModel serialModel;
+        ImportModel parallelModel;
+        serialModel.Import(pScene.get(), FALSE);
+        parallelModel.Import(pScene.get(), TRUE);
+
+        const std::vector<SimpleVertex>& aVertices = serialModel.GetVertices();
+        const std::vector<WORD>& aIndices = serialModel.GetIndices();
+        const std::vector<NormalData>& aNormalData = serialModel.GetNormalData();
+        printf("  %u meshes: %zu vertices, %zu indices\n", NUM_MESHES, aVertices.size(), aIndices.size());
+
+        TEST_CHECK(parallelModel.GetVertices().size() == aVertices.size());
+        TEST_CHECK(parallelModel.GetIndices().size() == aIndices.size());
+        TEST_CHECK(parallelModel.GetNormalData().size() == aNormalData.size());
+        TEST_CHECK(parallelModel.GetBoneData().size() == serialModel.GetBoneData().size());
+        TEST_CHECK(memcmp(parallelModel.GetVertices().data(), aVertices.data(), aVertices.size() * sizeof(SimpleVertex)) == 0);
+        TEST_CHECK(memcmp(parallelModel.GetIndices().data(), aIndices.data(), aIndices.size() * sizeof(WORD)) == 0);
+        TEST_CHECK(memcmp(parallelModel.GetNormalData().data(), aNormalData.data(), aNormalData.size() * sizeof(NormalData)) == 0);
+        TEST_CHECK(memcmp(parallelModel.GetBoneData().data(), serialModel.GetBoneData().data(), serialModel.GetBoneData().size() * sizeof(serialModel.GetBoneData()[0])) == 0);
+
+        return TRUE;
+    }
+}
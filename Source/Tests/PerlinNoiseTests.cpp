@@ -0,0 +1,64 @@
+#include "Tests.h"
+
+#include <cmath>
+
+#include "Scene/PerlinNoise.h"
+
+namespace tests
+{
+    using namespace library;
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestPerlin2dRowMatchesScalar
+
+      Summary:  Compares GetPerlin2dRow with GetPerlin2d sample by
+                sample over several seeds, frequencies, depths and row
+                lengths, including rows that do not fill the last batch
+                of four. Every sample stays within BATCH_TOLERANCE
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestPerlin2dRowMatchesScalar()
+    {
+        const UINT aSeeds[] = { PerlinNoise::DEFAULT_SEED, 1u, 12345u };
+        const FLOAT aFrequencies[] = { 0.1f, 0.2f, 0.4f, 0.8f };
+        const UINT aRowLengths[] = { 1u, 3u, 64u, 150u };
+
+        UINT uNumSamples = 0u;
+        FLOAT maxDifference = 0.0f;
+        std::vector<FLOAT> aRow;
+        for (UINT uSeed : aSeeds)
+        {
+            PerlinNoise noise(uSeed);
+            for (FLOAT frequency : aFrequencies)
+            {
+                for (UINT uDepth = 1u; uDepth <= 4u; ++uDepth)
+                {
+                    for (UINT uNumRowSamples : aRowLengths)
+                    {
+                        aRow.resize(uNumRowSamples);
+                        for (UINT z = 0u; z < 8u; ++z)
+                        {
+                            const FLOAT x = 0.5f;
+                            const FLOAT y = frequency * static_cast<FLOAT>(z) + 0.25f;
+                            noise.GetPerlin2dRow(x, frequency, y, 0.1f, uDepth, uNumRowSamples, aRow.data());
+
+                            for (UINT i = 0u; i < uNumRowSamples; ++i)
+                            {
+                                FLOAT difference = std::fabs(aRow[i] - noise.GetPerlin2d(x + frequency * static_cast<FLOAT>(i), y, 0.1f, uDepth));
+                                TEST_CHECK(difference <= PerlinNoise::BATCH_TOLERANCE);
+                                maxDifference = difference > maxDifference ? difference : maxDifference;
+                                ++uNumSamples;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        printf("  %u samples, largest difference %g\n", uNumSamples, maxDifference);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,366 @@
+#include "Tests.h"
+
+#include <thread>
+#include <vector>
+
+#include "Light/PointLight.h"
+#include "Renderer/NullRenderCommandList.h"
+#include "Renderer/Renderer.h"
+#include "Scene/Scene.h"
+#include "Shader/PixelShader.h"
+#include "Shader/VertexShader.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    TestTriangle
+
+          Summary:  Renderable with a single triangle that is never
+                    initialized, its buffers stay null for the null
+                    backend
+
+          Methods:  Initialize
+                      Does nothing
+                    Update
+                      Does nothing
+                    GetNumVertices
+                      Returns the number of vertices
+                    GetNumIndices
+                      Returns the number of indices
+                    TestTriangle
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class TestTriangle final : public Renderable
+        {
+        public:
+            TestTriangle() : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f)) {}
+
+            HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override { return S_OK; }
+            void Update(_In_ FLOAT deltaTime) override {}
+            UINT GetNumVertices() const override { return 3u; }
+            UINT GetNumIndices() const override { return 3u; }
+
+        protected:
+            const SimpleVertex* getVertices() const override { return VERTICES; }
+            const WORD* getIndices() const override { return INDICES; }
+
+        private:
+            static constexpr const SimpleVertex VERTICES[] =
+            {
+                { .Position = XMFLOAT3(0.0f, 1.0f, 0.0f), .TexCoord = XMFLOAT2(0.5f, 0.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+                { .Position = XMFLOAT3(1.0f, -1.0f, 0.0f), .TexCoord = XMFLOAT2(1.0f, 1.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+                { .Position = XMFLOAT3(-1.0f, -1.0f, 0.0f), .TexCoord = XMFLOAT2(0.0f, 1.0f), .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f) },
+            };
+            static constexpr const WORD INDICES[] = { 0, 1, 2 };
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    InlineVertexShader
+
+          Summary:  Vertex shader with a batch variant compiled from
+                    source in memory, so a test does not depend on the
+                    shader files
+
+          Methods:  Initialize
+                      Compiles and creates both variants
+                    InlineVertexShader
+                      Constructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class InlineVertexShader final : public VertexShader
+        {
+        public:
+            InlineVertexShader() : VertexShader(L"", "VSMain", "VSMainBatch", "vs_5_0") {}
+
+            HRESULT Initialize(_In_ ID3D11Device* pDevice) override
+            {
+                ComPtr<ID3DBlob> pVSBlob = nullptr;
+                HRESULT hr = D3DCompile(SOURCE, sizeof(SOURCE) - 1u, nullptr, nullptr, nullptr, m_pszEntryPoint, m_pszShaderModel, 0u, 0u, pVSBlob.GetAddressOf(), nullptr);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+
+                ComPtr<ID3DBlob> pBatchVSBlob = nullptr;
+                hr = D3DCompile(SOURCE, sizeof(SOURCE) - 1u, nullptr, nullptr, nullptr, m_pszBatchEntryPoint, m_pszShaderModel, 0u, 0u, pBatchVSBlob.GetAddressOf(), nullptr);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+
+                hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), nullptr, m_vertexShader.GetAddressOf());
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+
+                return pDevice->CreateVertexShader(pBatchVSBlob->GetBufferPointer(), pBatchVSBlob->GetBufferSize(), nullptr, m_batchVertexShader.GetAddressOf());
+            }
+
+        private:
+            static constexpr const CHAR SOURCE[] =
+                "float4 VSMain(float4 position : POSITION) : SV_POSITION { return position; }\n"
+                "float4 VSMainBatch(float4 position : POSITION, float4x4 world : INSTANCE_WORLD) : SV_POSITION { return mul(position, world); }\n";
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: createScene
+
+          Summary:  Creates a scene of lit triangles laid out on a grid,
+                    all sharing one pair of shaders
+
+          Args:     UINT uNumRenderables
+                      Number of triangles in the scene
+                    std::shared_ptr<Scene>& outScene
+                      Created scene
+
+          Returns:  HRESULT
+                      Status code
+        -----------------------------------------------------------------F-F*/
+        HRESULT createScene(_In_ UINT uNumRenderables, _Out_ std::shared_ptr<Scene>& outScene)
+        {
+            outScene = std::make_shared<Scene>(std::unique_ptr<HeightMap>());
+            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+            {
+                HRESULT hr = outScene->AddPointLight(i, std::make_shared<PointLight>(XMFLOAT4(0.0f, 10.0f, static_cast<FLOAT>(i), 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), 100.0f));
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            std::shared_ptr<VertexShader> vertexShader = std::make_shared<VertexShader>(L"Shaders/Shaders.fxh", "VSPhong", "vs_5_0");
+            std::shared_ptr<PixelShader> pixelShader = std::make_shared<PixelShader>(L"Shaders/Shaders.fxh", "PSPhong", "ps_5_0");
+            for (UINT i = 0u; i < uNumRenderables; ++i)
+            {
+                std::shared_ptr<TestTriangle> triangle = std::make_shared<TestTriangle>();
+                triangle->SetVertexShader(vertexShader);
+                triangle->SetPixelShader(pixelShader);
+                triangle->Translate(XMVectorSet(static_cast<FLOAT>(i % 20u) * 3.0f, 0.0f, static_cast<FLOAT>(i / 20u) * 3.0f, 0.0f));
+
+                WCHAR szName[32];
+                swprintf_s(szName, L"Triangle%u", i);
+                HRESULT hr = outScene->AddRenderable(szName, triangle);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            return S_OK;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: renderFrame
+
+          Summary:  Updates and records one frame into the null backend
+
+          Args:     Renderer& renderer
+                      Renderer recording into the backend
+                    NullRenderCommandList& commandList
+                      Backend of the renderer
+                    const DirectionsInput& directions
+                      Keyboard input of the frame
+
+          Returns:  RenderCommandStats
+                      Commands recorded for the frame
+        -----------------------------------------------------------------F-F*/
+        RenderCommandStats renderFrame(_Inout_ Renderer& renderer, _Inout_ NullRenderCommandList& commandList, _In_ const DirectionsInput& directions)
+        {
+            constexpr const FLOAT DELTA_TIME = 1.0f / 60.0f;
+
+            commandList.ResetStats();
+            renderer.HandleInput(directions, MouseRelativeMovement{ .X = 0, .Y = 0 }, DELTA_TIME);
+            renderer.Update(DELTA_TIME);
+            renderer.Render();
+
+            return commandList.GetStats();
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestRendererUploadsFrameConstantsOnce
+
+      Summary:  Records frames of a scene of renderables into the null
+                backend. Each object uploads only its own constants, the
+                camera and the lights are uploaded once in a frame they
+                changed in and the projection only after a resize
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestRendererUploadsFrameConstantsOnce()
+    {
+        const UINT uNumRenderables = 200u;
+
+        std::shared_ptr<Scene> scene;
+        TEST_CHECK(SUCCEEDED(createScene(uNumRenderables, scene)));
+
+        Renderer renderer;
+        std::shared_ptr<NullRenderCommandList> commandList = std::make_shared<NullRenderCommandList>();
+        renderer.SetCommandList(commandList);
+        TEST_CHECK(SUCCEEDED(renderer.AddScene(L"Test", scene)));
+        TEST_CHECK(SUCCEEDED(renderer.SetMainScene(L"Test")));
+
+        // First frame: every object, then the camera, the lights and the projection
+        const DirectionsInput still = {};
+        RenderCommandStats stats = renderFrame(renderer, *commandList, still);
+        TEST_CHECK(stats.uNumUploads == uNumRenderables + 3u);
+        TEST_CHECK(stats.uNumDraws == uNumRenderables);
+        TEST_CHECK(stats.uNumPresents == 1u);
+        printf("  %u renderables: %u uploads, %u state changes, %u draws in the first frame\n", uNumRenderables, stats.uNumUploads, stats.uNumStateChanges, stats.uNumDraws);
+
+        // Nothing moved, only the objects upload
+        stats = renderFrame(renderer, *commandList, still);
+        TEST_CHECK(stats.uNumUploads == uNumRenderables);
+        TEST_CHECK(stats.uNumDraws == uNumRenderables);
+
+        // A moving camera uploads once per frame, not once per object
+        const DirectionsInput forward = { .bFront = TRUE };
+        for (UINT uFrame = 0u; uFrame < 10u; ++uFrame)
+        {
+            stats = renderFrame(renderer, *commandList, forward);
+            TEST_CHECK(stats.uNumUploads == uNumRenderables + 1u);
+            TEST_CHECK(stats.uNumDraws == uNumRenderables);
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestRendererRecordingThreadScaling
+
+      Summary:  Records frames of a few thousand renderables into the
+                null backend over 1 to N recording threads. Prints the
+                time per frame of each thread count and checks that the
+                chunked frames upload and draw the same as a frame
+                recorded on one thread
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestRendererRecordingThreadScaling()
+    {
+        constexpr const UINT NUM_RENDERABLES = 4096u;
+        constexpr const UINT NUM_FRAMES = 20u;
+        constexpr const UINT MIN_MAX_THREADS = 8u;
+
+        std::shared_ptr<Scene> scene;
+        TEST_CHECK(SUCCEEDED(createScene(NUM_RENDERABLES, scene)));
+
+        Renderer renderer;
+        std::shared_ptr<NullRenderCommandList> commandList = std::make_shared<NullRenderCommandList>();
+        renderer.SetCommandList(commandList);
+        TEST_CHECK(SUCCEEDED(renderer.AddScene(L"Test", scene)));
+        TEST_CHECK(SUCCEEDED(renderer.SetMainScene(L"Test")));
+
+        // Chunks are recorded up to MIN_MAX_THREADS wide even on fewer cores
+        UINT uMaxThreads = std::thread::hardware_concurrency();
+        uMaxThreads = uMaxThreads > MIN_MAX_THREADS ? uMaxThreads : MIN_MAX_THREADS;
+        std::vector<UINT> aThreadCounts;
+        for (UINT uNumThreads = 1u; uNumThreads < uMaxThreads; uNumThreads *= 2u)
+        {
+            aThreadCounts.push_back(uNumThreads);
+        }
+        aThreadCounts.push_back(uMaxThreads);
+
+        // Single threaded reference, after the frame that uploads the camera, lights and projection
+        const DirectionsInput still = {};
+        renderer.SetMaxRecordingThreads(1u);
+        renderFrame(renderer, *commandList, still);
+        const RenderCommandStats reference = renderFrame(renderer, *commandList, still);
+        TEST_CHECK(renderer.GetDrawQueueStats().uNumChunks == 1u);
+        TEST_CHECK(reference.uNumDraws == NUM_RENDERABLES);
+
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        for (UINT uNumThreads : aThreadCounts)
+        {
+            renderer.SetMaxRecordingThreads(uNumThreads);
+
+            LARGE_INTEGER startTime;
+            LARGE_INTEGER endTime;
+            DOUBLE milliseconds = 0.0;
+            for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+            {
+                QueryPerformanceCounter(&startTime);
+                RenderCommandStats stats = renderFrame(renderer, *commandList, still);
+                QueryPerformanceCounter(&endTime);
+                milliseconds += static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+
+                TEST_CHECK(stats.uNumDraws == reference.uNumDraws);
+                TEST_CHECK(stats.uNumUploads == reference.uNumUploads);
+                TEST_CHECK(stats.uNumInstances == reference.uNumInstances);
+                TEST_CHECK(stats.uNumIndices == reference.uNumIndices);
+                TEST_CHECK(stats.uNumPresents == 1u);
+            }
+
+            DrawQueueStats drawQueueStats = renderer.GetDrawQueueStats();
+            TEST_CHECK(drawQueueStats.uNumChunks <= uNumThreads);
+            TEST_CHECK(drawQueueStats.uNumDraws == NUM_RENDERABLES);
+            printf("  %u renderables, %u thread%s: %u chunks, %.3f ms per frame\n", NUM_RENDERABLES, uNumThreads, uNumThreads == 1u ? "" : "s", drawQueueStats.uNumChunks, milliseconds / static_cast<DOUBLE>(NUM_FRAMES));
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestRendererBatchesSharedMeshes
+
+      Summary:  Records ten thousand renderables of one mesh, split
+                over a few vertex shaders with a batch variant, into the
+                null backend. Each shader becomes one instanced draw of
+                its renderables instead of a draw per renderable
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestRendererBatchesSharedMeshes()
+    {
+        constexpr const UINT NUM_RENDERABLES = 10000u;
+        constexpr const UINT NUM_GROUPS = 4u;
+
+        ComPtr<ID3D11Device> device;
+        TEST_CHECK(SUCCEEDED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0u, nullptr, 0u, D3D11_SDK_VERSION, device.GetAddressOf(), nullptr, nullptr)));
+
+        std::vector<std::shared_ptr<VertexShader>> aVertexShaders;
+        for (UINT i = 0u; i < NUM_GROUPS; ++i)
+        {
+            aVertexShaders.push_back(std::make_shared<InlineVertexShader>());
+            TEST_CHECK(SUCCEEDED(aVertexShaders.back()->Initialize(device.Get())));
+            TEST_CHECK(aVertexShaders.back()->GetBatchVertexShader() != nullptr);
+        }
+
+        // The triangles are never initialized, so they all share the same null buffers
+        std::shared_ptr<Scene> scene;
+        TEST_CHECK(SUCCEEDED(createScene(NUM_RENDERABLES, scene)));
+        UINT uRenderable = 0u;
+        for (auto& renderable : scene->GetRenderables())
+        {
+            renderable.second->SetVertexShader(aVertexShaders[uRenderable % NUM_GROUPS]);
+            ++uRenderable;
+        }
+
+        Renderer renderer;
+        std::shared_ptr<NullRenderCommandList> commandList = std::make_shared<NullRenderCommandList>();
+        renderer.SetCommandList(commandList);
+        TEST_CHECK(SUCCEEDED(renderer.AddScene(L"Test", scene)));
+        TEST_CHECK(SUCCEEDED(renderer.SetMainScene(L"Test")));
+
+        // After the first frame, a group uploads its constants and the instance buffer is uploaded once
+        const DirectionsInput still = {};
+        renderFrame(renderer, *commandList, still);
+        RenderCommandStats stats = renderFrame(renderer, *commandList, still);
+        TEST_CHECK(stats.uNumDraws == NUM_GROUPS);
+        TEST_CHECK(stats.uNumInstances == NUM_RENDERABLES);
+        TEST_CHECK(stats.uNumIndices == NUM_RENDERABLES * 3u);
+        TEST_CHECK(stats.uNumUploads == NUM_GROUPS + 1u);
+        TEST_CHECK(renderer.GetDrawQueueStats().uNumPackets == NUM_GROUPS);
+        printf("  %u renderables of %u shaders: %u draws, %u uploads\n", NUM_RENDERABLES, NUM_GROUPS, stats.uNumDraws, stats.uNumUploads);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,259 @@
+#include "Tests.h"
+
+#include <cmath>
+
+#include "Scene/BiomeTable.h"
+#include "Scene/HeightMap.h"
+#include "Scene/NoiseCache.h"
+#include "Scene/TerrainGenerator.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: generateTimed
+
+          Summary:  Generates a height map and measures how long it took
+
+          Args:     const TerrainGeneratorDesc& desc
+                      Dimensions and seeds of the terrain
+                    NoiseCache* pNoiseCache
+                      Cache of the noise tiles, may be null
+                    HeightMap& heightMap
+                      Receives the terrain
+                    DOUBLE& milliseconds
+                      Receives the time of the generation
+
+          Returns:  HRESULT
+                      Status code
+        -----------------------------------------------------------------F-F*/
+        HRESULT generateTimed(_In_ const TerrainGeneratorDesc& desc, _In_opt_ NoiseCache* pNoiseCache, _Out_ HeightMap& heightMap, _Out_ DOUBLE& milliseconds)
+        {
+            LARGE_INTEGER frequency;
+            LARGE_INTEGER startTime;
+            LARGE_INTEGER endTime;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&startTime);
+
+            HRESULT hr = TerrainGenerator::Generate(desc, heightMap, TerrainGenerator::DEFAULT_BIOME_THRESHOLDS, pNoiseCache);
+
+            QueryPerformanceCounter(&endTime);
+            milliseconds = static_cast<DOUBLE>(endTime.QuadPart - startTime.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+
+            return hr;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isSameTerrain
+
+          Summary:  Compares the columns of two height maps
+
+          Args:     const HeightMap& heightMap
+                      First height map
+                    const HeightMap& otherHeightMap
+                      Second height map
+
+          Returns:  BOOL
+                      TRUE if every column has the same block type and
+                      height
+        -----------------------------------------------------------------F-F*/
+        BOOL isSameTerrain(_In_ const HeightMap& heightMap, _In_ const HeightMap& otherHeightMap)
+        {
+            if (heightMap.GetWidth() != otherHeightMap.GetWidth() || heightMap.GetDepth() != otherHeightMap.GetDepth())
+            {
+                return FALSE;
+            }
+
+            for (size_t i = 0u; i < static_cast<size_t>(heightMap.GetWidth()) * heightMap.GetDepth(); ++i)
+            {
+                if (heightMap.GetCells()[i].BlockType != otherHeightMap.GetCells()[i].BlockType
+                    || heightMap.GetCells()[i].ColumnHeight != otherHeightMap.GetCells()[i].ColumnHeight)
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: addSweepValues
+
+          Summary:  Adds a threshold, the floats right next to it and
+                    values a little further on both sides
+
+          Args:     FLOAT threshold
+                      Threshold to sweep around
+                    std::vector<FLOAT>& aValues
+                      Receives the values
+        -----------------------------------------------------------------F-F*/
+        void addSweepValues(_In_ FLOAT threshold, _Inout_ std::vector<FLOAT>& aValues)
+        {
+            aValues.push_back(threshold);
+            aValues.push_back(nextafterf(threshold, -INFINITY));
+            aValues.push_back(nextafterf(threshold, INFINITY));
+            aValues.push_back(threshold - 1e-3f);
+            aValues.push_back(threshold + 1e-3f);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isSameAsClassifyBiome
+
+          Summary:  Classifies every pair of swept heights and moistures
+                    through a BiomeTable and compares each cell with
+                    TerrainGenerator::ClassifyBiome
+
+          Args:     const BiomeThresholds& thresholds
+                      Thresholds of the biomes
+
+          Returns:  BOOL
+                      TRUE if every cell matches
+        -----------------------------------------------------------------F-F*/
+        BOOL isSameAsClassifyBiome(_In_ const BiomeThresholds& thresholds)
+        {
+            std::vector<FLOAT> aSweptHeights = { -0.5f, 0.0f, 1.0f, 1.5f };
+            for (FLOAT height : { thresholds.OceanHeight, thresholds.SandHeight, thresholds.MountainHeight, thresholds.HighlandHeight, thresholds.MidlandHeight })
+            {
+                addSweepValues(height, aSweptHeights);
+            }
+
+            std::vector<FLOAT> aSweptMoistures = { -0.5f, 0.0f, 1.0f, 1.5f };
+            for (const FLOAT* pMoistures : { thresholds.MountainMoisture, thresholds.MidlandMoisture, thresholds.LowlandMoisture })
+            {
+                for (UINT i = 0u; i < 3u; ++i)
+                {
+                    addSweepValues(pMoistures[i], aSweptMoistures);
+                }
+            }
+            for (FLOAT moisture : thresholds.HighlandMoisture)
+            {
+                addSweepValues(moisture, aSweptMoistures);
+            }
+
+            // A regular grid between the thresholds as well
+            for (UINT i = 0u; i <= 100u; ++i)
+            {
+                aSweptHeights.push_back(static_cast<FLOAT>(i) / 100.0f);
+                aSweptMoistures.push_back(static_cast<FLOAT>(i) / 100.0f);
+            }
+
+            std::vector<FLOAT> aHeights;
+            std::vector<FLOAT> aMoistures;
+            for (FLOAT height : aSweptHeights)
+            {
+                for (FLOAT moisture : aSweptMoistures)
+                {
+                    aHeights.push_back(height);
+                    aMoistures.push_back(moisture);
+                }
+            }
+
+            std::vector<CHAR> aBlockTypes(aHeights.size());
+            BiomeTable biomeTable(thresholds);
+            biomeTable.ClassifyCells(aHeights.data(), aMoistures.data(), aHeights.size(), aBlockTypes.data());
+
+            for (size_t i = 0u; i < aHeights.size(); ++i)
+            {
+                if (aBlockTypes[i] != static_cast<CHAR>(TerrainGenerator::ClassifyBiome(aHeights[i], aMoistures[i], thresholds)))
+                {
+                    printf("  height %.9g, moisture %.9g: %d instead of %d\n", aHeights[i], aMoistures[i],
+                        aBlockTypes[i], static_cast<INT>(TerrainGenerator::ClassifyBiome(aHeights[i], aMoistures[i], thresholds)));
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestBiomeTableMatchesClassifyBiome
+
+      Summary:  Sweeps heights and moistures over, next to and around
+                every threshold and checks that the BiomeTable gives
+                the same block type as the if/else chain, with the
+                default thresholds and with uneven ones
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestBiomeTableMatchesClassifyBiome()
+    {
+        TEST_CHECK(isSameAsClassifyBiome(TerrainGenerator::DEFAULT_BIOME_THRESHOLDS));
+
+        const BiomeThresholds unevenThresholds =
+        {
+            .OceanHeight = 0.05f,
+            .SandHeight = 0.07f,
+            .MountainHeight = 0.9f,
+            .HighlandHeight = 0.45f,
+            .MidlandHeight = 0.2f,
+            .MountainMoisture = { 0.05f, 0.35f, 0.95f },
+            .HighlandMoisture = { 0.1f, 0.9f },
+            .MidlandMoisture = { 0.21f, 0.22f, 0.7f },
+            .LowlandMoisture = { 0.4f, 0.41f, 0.99f }
+        };
+        TEST_CHECK(isSameAsClassifyBiome(unevenThresholds));
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestTerrainGeneratorNoiseCache
+
+      Summary:  Generates a 150x137 terrain without a cache, then cold
+                and warm through a NoiseCache. All three are the same
+                terrain, the warm run computes no tiles and a new
+                moisture seed only adds the moisture tiles. The times
+                are printed, not compared
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestTerrainGeneratorNoiseCache()
+    {
+        TerrainGeneratorDesc desc =
+        {
+            .uWidth = 150u,
+            .uHeight = 64u,
+            .uDepth = 137u,
+            .uHeightSeed = PerlinNoise::DEFAULT_SEED,
+            .uMoistureSeed = PerlinNoise::DEFAULT_SEED
+        };
+        const size_t uNumTiles = static_cast<size_t>((desc.uWidth + NoiseCache::TILE_SIZE - 1u) / NoiseCache::TILE_SIZE)
+            * ((desc.uDepth + NoiseCache::TILE_SIZE - 1u) / NoiseCache::TILE_SIZE);
+
+        DOUBLE uncachedMilliseconds = 0.0;
+        HeightMap uncachedHeightMap;
+        TEST_CHECK(SUCCEEDED(generateTimed(desc, nullptr, uncachedHeightMap, uncachedMilliseconds)));
+
+        NoiseCache noiseCache;
+        DOUBLE coldMilliseconds = 0.0;
+        HeightMap coldHeightMap;
+        TEST_CHECK(SUCCEEDED(generateTimed(desc, &noiseCache, coldHeightMap, coldMilliseconds)));
+        TEST_CHECK(isSameTerrain(coldHeightMap, uncachedHeightMap));
+
+        // Equal seeds share the octave tiles of the height and the moisture
+        TEST_CHECK(noiseCache.GetNumTiles() == TerrainGenerator::NUM_OCTAVES * uNumTiles);
+
+        UINT64 uNumMisses = noiseCache.GetNumMisses();
+        DOUBLE warmMilliseconds = 0.0;
+        HeightMap warmHeightMap;
+        TEST_CHECK(SUCCEEDED(generateTimed(desc, &noiseCache, warmHeightMap, warmMilliseconds)));
+        TEST_CHECK(isSameTerrain(warmHeightMap, uncachedHeightMap));
+        TEST_CHECK(noiseCache.GetNumMisses() == uNumMisses);
+
+        printf("  %ux%u: %.3f ms without a cache, %.3f ms cold, %.3f ms warm\n", desc.uWidth, desc.uDepth, uncachedMilliseconds, coldMilliseconds, warmMilliseconds);
+
+        desc.uMoistureSeed = 1u;
+        HeightMap moistureHeightMap;
+        TEST_CHECK(SUCCEEDED(TerrainGenerator::Generate(desc, moistureHeightMap, TerrainGenerator::DEFAULT_BIOME_THRESHOLDS, &noiseCache)));
+        TEST_CHECK(noiseCache.GetNumTiles() == 2u * TerrainGenerator::NUM_OCTAVES * uNumTiles);
+        TEST_CHECK(noiseCache.GetNumMisses() == uNumMisses + TerrainGenerator::NUM_OCTAVES * uNumTiles);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,194 @@
+#include "Tests.h"
+
+#include <cmath>
+#include <random>
+
+#include "Scene/TerrainStreamer.h"
+#include "Scene/VoxelCulling.h"
+
+namespace tests
+{
+    using namespace library;
+
+    namespace
+    {
+        constexpr const UINT MAP_SIZE = 128u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: createHeightMap
+
+          Summary:  Fills a square height map with random columns of
+                    every block type
+
+          Args:     HeightMap& heightMap
+                      Height map to fill
+
+          Returns:  HRESULT
+                      Status code
+        -----------------------------------------------------------------F-F*/
+        HRESULT createHeightMap(_Out_ HeightMap& heightMap)
+        {
+            const UINT uNumBlockTypes = static_cast<UINT>(eBlockType::COUNT) - static_cast<UINT>(eBlockType::GRASSLAND);
+
+            std::mt19937 generator(6u);
+            std::vector<HeightMapCell> aCells(static_cast<size_t>(MAP_SIZE) * MAP_SIZE);
+            for (HeightMapCell& cell : aCells)
+            {
+                cell =
+                {
+                    .BlockType = static_cast<CHAR>(static_cast<UINT>(eBlockType::GRASSLAND) + generator() % uNumBlockTypes),
+                    .Reserved = 0u,
+                    .ColumnHeight = static_cast<WORD>(1u + generator() % 16u)
+                };
+            }
+
+            return heightMap.Create(MAP_SIZE, 32u, MAP_SIZE, std::vector<XMFLOAT3>(uNumBlockTypes), std::move(aCells));
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: updateAndWait
+
+          Summary:  Requests the chunks around the eye, waits for the
+                    loader thread and merges its loads
+
+          Args:     TerrainStreamer& streamer
+                      Streamer to update
+                    const XMFLOAT3& gridEye
+                      Eye position in height map grid coordinates
+        -----------------------------------------------------------------F-F*/
+        void updateAndWait(_Inout_ TerrainStreamer& streamer, _In_ const XMFLOAT3& gridEye)
+        {
+            streamer.Update(gridEye);
+            streamer.WaitForIdle();
+            streamer.Update(gridEye);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getNumResidentInstances
+
+          Summary:  Returns the number of instances of every block type
+
+          Args:     const TerrainStreamer& streamer
+                      Streamer to count
+
+          Returns:  UINT64
+                      Number of resident instances
+        -----------------------------------------------------------------F-F*/
+        UINT64 getNumResidentInstances(_In_ const TerrainStreamer& streamer)
+        {
+            UINT64 uNumInstances = 0u;
+            for (UINT uBlockTypeIdx = 0u; uBlockTypeIdx < streamer.GetNumBlockTypes(); ++uBlockTypeIdx)
+            {
+                uNumInstances += streamer.GetInstanceData(uBlockTypeIdx).size();
+            }
+
+            return uNumInstances;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestTerrainStreamerLoadsWholeMap
+
+      Summary:  With a load radius covering the map and no budget
+                pressure, every chunk is loaded once, nothing is
+                evicted and the instances match culling the whole map
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestTerrainStreamerLoadsWholeMap()
+    {
+        HeightMap heightMap;
+        TEST_CHECK(SUCCEEDED(createHeightMap(heightMap)));
+
+        const TerrainStreamingDesc desc =
+        {
+            .uChunkSize = 16u,
+            .uLoadRadius = 16u,
+            .uMemoryBudget = 64ull * 1024ull * 1024ull
+        };
+        TerrainStreamer streamer(heightMap, desc);
+        updateAndWait(streamer, XMFLOAT3(0.0f, 0.0f, 0.0f));
+
+        std::vector<WORD> aFirstVisibleHeights(static_cast<size_t>(MAP_SIZE) * MAP_SIZE);
+        VoxelCullingStats cullingStats = CullHiddenVoxels(heightMap.GetCells(), MAP_SIZE, MAP_SIZE, aFirstVisibleHeights.data());
+
+        const TerrainStreamingStats& stats = streamer.GetStats();
+        TEST_CHECK(stats.uNumLoads == 64u);
+        TEST_CHECK(stats.uNumEvictions == 0u);
+        TEST_CHECK(stats.uNumResidentChunks == 64u);
+        TEST_CHECK(stats.uResidentBytes == cullingStats.uNumCubesOut * sizeof(PackedInstanceData));
+        TEST_CHECK(getNumResidentInstances(streamer) == cullingStats.uNumCubesOut);
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestTerrainStreamerScriptedPath
+
+      Summary:  Flies the eye along a scripted loop under a small
+                budget. Checks the peak memory against the budget, the
+                load and eviction counts against the resident chunks,
+                and that uploading only the dirty ranges each frame
+                keeps a copy of the instance arrays in sync
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestTerrainStreamerScriptedPath()
+    {
+        HeightMap heightMap;
+        TEST_CHECK(SUCCEEDED(createHeightMap(heightMap)));
+
+        const TerrainStreamingDesc desc =
+        {
+            .uChunkSize = 16u,
+            .uLoadRadius = 2u,
+            .uMemoryBudget = 96ull * 1024ull
+        };
+        TerrainStreamer streamer(heightMap, desc);
+
+        std::vector<std::vector<PackedInstanceData>> aaUploaded(streamer.GetNumBlockTypes());
+        UINT64 uNumUploadedInstances = 0u;
+        for (UINT uFrame = 0u; uFrame < 200u; ++uFrame)
+        {
+            FLOAT angle = static_cast<FLOAT>(uFrame) * 0.0314159f;
+            XMFLOAT3 gridEye(64.0f + 48.0f * cosf(angle), 0.0f, 64.0f + 48.0f * sinf(angle));
+            updateAndWait(streamer, gridEye);
+
+            const TerrainStreamingStats& stats = streamer.GetStats();
+            TEST_CHECK(stats.uResidentBytes <= desc.uMemoryBudget);
+            TEST_CHECK(stats.uPeakResidentBytes <= desc.uMemoryBudget);
+            TEST_CHECK(stats.uNumLoads - stats.uNumEvictions == stats.uNumResidentChunks);
+            TEST_CHECK(stats.uResidentBytes == getNumResidentInstances(streamer) * sizeof(PackedInstanceData));
+
+            for (UINT uBlockTypeIdx = 0u; uBlockTypeIdx < streamer.GetNumBlockTypes(); ++uBlockTypeIdx)
+            {
+                const std::vector<PackedInstanceData>& aInstanceData = streamer.GetInstanceData(uBlockTypeIdx);
+                std::vector<PackedInstanceData>& aUploaded = aaUploaded[uBlockTypeIdx];
+                aUploaded.resize(aInstanceData.size());
+                for (const InstanceRange& dirtyRange : streamer.GetDirtyRanges(uBlockTypeIdx))
+                {
+                    TEST_CHECK(dirtyRange.uOffset + dirtyRange.uCount <= aInstanceData.size());
+                    std::copy(aInstanceData.begin() + dirtyRange.uOffset, aInstanceData.begin() + dirtyRange.uOffset + dirtyRange.uCount, aUploaded.begin() + dirtyRange.uOffset);
+                    uNumUploadedInstances += dirtyRange.uCount;
+                }
+
+                TEST_CHECK(memcmp(aUploaded.data(), aInstanceData.data(), aInstanceData.size() * sizeof(PackedInstanceData)) == 0);
+                for (const PackedInstanceData& instance : aInstanceData)
+                {
+                    TEST_CHECK(instance.BlockType == static_cast<INT16>(static_cast<UINT>(eBlockType::GRASSLAND) + uBlockTypeIdx));
+                }
+            }
+            streamer.ClearDirtyRanges();
+        }
+
+        const TerrainStreamingStats& stats = streamer.GetStats();
+        printf("  %llu loads, %llu evictions, %llu discarded, peak %llu of %llu bytes, %llu instances uploaded\n",
+            stats.uNumLoads, stats.uNumEvictions, stats.uNumDiscardedLoads, stats.uPeakResidentBytes, desc.uMemoryBudget, uNumUploadedInstances);
+        TEST_CHECK(stats.uNumEvictions > 0u);
+        TEST_CHECK(stats.uNumLoads > stats.uNumResidentChunks);
+
+        return TRUE;
+    }
+}
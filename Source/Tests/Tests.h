@@ -0,0 +1,93 @@
+﻿/*+===================================================================
+  File:      TESTS.H
+
+  Summary:   Tests header file contains the check macro and the
+             declarations of the headless tests of the Library
+             project used for the lab samples of Game Graphics
+             Programming course.
+
+  Functions: TestCullHiddenVoxelsFlatGrid
+             TestCullHiddenVoxelsMatchesNeighbours
+             TestChunkMesherFlatChunk
+             TestChunkMesherMatchesNaiveCubes
+             TestTerrainStreamerLoadsWholeMap
+             TestTerrainStreamerScriptedPath
+             TestHeightMapBinaryMatchesText
+             TestHeightMapLoadTime
+             TestRendererUploadsFrameConstantsOnce
+             TestDrawQueueSkipsRedundantBindings
+             TestDrawQueueSplitMatchesSubmit
+             TestPerlin2dRowMatchesScalar
+             TestTerrainGeneratorNoiseCache
+             TestModelBlendsWeightedClips
+             TestModelCrossfadeRemovesFadedClips
+             TestModelPosesWithoutAllocating
+             TestModelInterpolatesSkippedFrames
+             TestAnimationLodCrowdScaling
+             TestBiomeTableMatchesClassifyBiome
+             TestHeightMapRejectsOversizedMaps
+             TestAnimationClipFindKeyMatchesLinearScan
+             TestAnimationClipFindKeyTime
+             TestModelComposedChainMatchesMatrixProducts
+             TestModelFlatSkeletonMatchesTreeWalk
+             TestAnimationClipQuantizedRotationsMatchFloat
+             TestModelSharesAssetPerDevice
+             TestModelParallelImportMatchesSerial
+             TestAnimationCrowdThreadScaling
+             TestRendererRecordingThreadScaling
+             TestRendererBatchesSharedMeshes
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Renderer/RenderHandles.h"
+
+#include <cstdio>
+
+/*--------------------------------------------------------------------
+  Prints the failed condition and fails the calling test
+--------------------------------------------------------------------*/
+#define TEST_CHECK(condition)                                                   \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            printf("  %s(%d): check failed: %s\n", __FILE__, __LINE__, #condition); \
+            return FALSE;                                                       \
+        }                                                                       \
+    } while (0)
+
+namespace tests
+{
+    BOOL TestCullHiddenVoxelsFlatGrid();
+    BOOL TestCullHiddenVoxelsMatchesNeighbours();
+    BOOL TestChunkMesherFlatChunk();
+    BOOL TestChunkMesherMatchesNaiveCubes();
+    BOOL TestTerrainStreamerLoadsWholeMap();
+    BOOL TestTerrainStreamerScriptedPath();
+    BOOL TestHeightMapBinaryMatchesText();
+    BOOL TestHeightMapLoadTime();
+    BOOL TestRendererUploadsFrameConstantsOnce();
+    BOOL TestDrawQueueSkipsRedundantBindings();
+    BOOL TestDrawQueueSplitMatchesSubmit();
+    BOOL TestPerlin2dRowMatchesScalar();
+    BOOL TestTerrainGeneratorNoiseCache();
+    BOOL TestModelBlendsWeightedClips();
+    BOOL TestModelCrossfadeRemovesFadedClips();
+    BOOL TestModelPosesWithoutAllocating();
+    BOOL TestModelInterpolatesSkippedFrames();
+    BOOL TestAnimationLodCrowdScaling();
+    BOOL TestBiomeTableMatchesClassifyBiome();
+    BOOL TestHeightMapRejectsOversizedMaps();
+    BOOL TestAnimationClipFindKeyMatchesLinearScan();
+    BOOL TestAnimationClipFindKeyTime();
+    BOOL TestModelComposedChainMatchesMatrixProducts();
+    BOOL TestModelFlatSkeletonMatchesTreeWalk();
+    BOOL TestAnimationClipQuantizedRotationsMatchFloat();
+    BOOL TestModelSharesAssetPerDevice();
+    BOOL TestModelParallelImportMatchesSerial();
+    BOOL TestAnimationCrowdThreadScaling();
+    BOOL TestRendererRecordingThreadScaling();
+    BOOL TestRendererBatchesSharedMeshes();
+}
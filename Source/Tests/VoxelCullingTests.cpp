@@ -0,0 +1,104 @@
+#include "Tests.h"
+
+#include <random>
+
+#include "Scene/VoxelCulling.h"
+
+namespace tests
+{
+    using namespace library;
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestCullHiddenVoxelsFlatGrid
+
+      Summary:  A flat 3x3 grid of height 4 keeps the border columns
+                whole and only the top cube of the middle column
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestCullHiddenVoxelsFlatGrid()
+    {
+        std::vector<HeightMapCell> aCells(9u, HeightMapCell{ .BlockType = static_cast<CHAR>(eBlockType::GRASSLAND), .Reserved = 0u, .ColumnHeight = 4u });
+        std::vector<WORD> aFirstVisibleHeights(aCells.size());
+
+        VoxelCullingStats stats = CullHiddenVoxels(aCells.data(), 3u, 3u, aFirstVisibleHeights.data());
+
+        TEST_CHECK(stats.uNumCubesIn == 36u);
+        TEST_CHECK(stats.uNumCubesOut == 33u);
+        TEST_CHECK(aFirstVisibleHeights[4] == 3u);
+        for (UINT i = 0u; i < 9u; ++i)
+        {
+            TEST_CHECK(i == 4u || aFirstVisibleHeights[i] == 0u);
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: TestCullHiddenVoxelsMatchesNeighbours
+
+      Summary:  On a random grid, keeps exactly the cubes with an
+                exposed face, found by looking at the six neighbours
+                of every cube
+
+      Returns:  BOOL
+                  TRUE if the test passed
+    -----------------------------------------------------------------F-F*/
+    BOOL TestCullHiddenVoxelsMatchesNeighbours()
+    {
+        const UINT uWidth = 37u;
+        const UINT uDepth = 23u;
+
+        std::mt19937 generator(4u);
+        std::vector<HeightMapCell> aCells(static_cast<size_t>(uWidth) * uDepth);
+        for (HeightMapCell& cell : aCells)
+        {
+            cell = { .BlockType = static_cast<CHAR>(eBlockType::GRASSLAND), .Reserved = 0u, .ColumnHeight = static_cast<WORD>(generator() % 12u) };
+        }
+
+        std::vector<WORD> aFirstVisibleHeights(aCells.size());
+        VoxelCullingStats stats = CullHiddenVoxels(aCells.data(), uWidth, uDepth, aFirstVisibleHeights.data());
+
+        auto getHeight = [&aCells, uWidth, uDepth](INT x, INT z)
+        {
+            if (x < 0 || z < 0 || x >= static_cast<INT>(uWidth) || z >= static_cast<INT>(uDepth))
+            {
+                return 0;
+            }
+
+            return static_cast<INT>(aCells[static_cast<size_t>(z) * uWidth + static_cast<size_t>(x)].ColumnHeight);
+        };
+
+        UINT64 uNumCubesIn = 0u;
+        UINT64 uNumCubesOut = 0u;
+        for (INT z = 0; z < static_cast<INT>(uDepth); ++z)
+        {
+            for (INT x = 0; x < static_cast<INT>(uWidth); ++x)
+            {
+                INT height = getHeight(x, z);
+                for (INT y = 0; y < height; ++y)
+                {
+                    // The ground below the map is solid
+                    BOOL bIsExposed = y + 1 >= height ||
+                        getHeight(x - 1, z) <= y || getHeight(x + 1, z) <= y ||
+                        getHeight(x, z - 1) <= y || getHeight(x, z + 1) <= y;
+
+                    TEST_CHECK(bIsExposed == (y >= aFirstVisibleHeights[static_cast<size_t>(z) * uWidth + static_cast<size_t>(x)]));
+
+                    ++uNumCubesIn;
+                    if (bIsExposed)
+                    {
+                        ++uNumCubesOut;
+                    }
+                }
+            }
+        }
+
+        TEST_CHECK(stats.uNumCubesIn == uNumCubesIn);
+        TEST_CHECK(stats.uNumCubesOut == uNumCubesOut);
+        TEST_CHECK(stats.uNumCubesOut < stats.uNumCubesIn);
+
+        return TRUE;
+    }
+}